@@ -1,6 +1,7 @@
 #include <endpoint/client.h>
 #include <socket/af_inet.h>
 #include <epoll/epoll.h>
+#include <framing/framer.h>
 
 #include "async_stdin.h"
 
@@ -16,6 +17,9 @@ using namespace protei::endpoint;
 
 static sig_atomic_t volatile main_loop = 1;
 
+/// tcp requests and responses are varint length prefixed, responses are multiline
+static std::optional<framing::framer_t<framing::length_prefix_codec>> tcp_framer;
+
 void sig(int) noexcept
 {
     if (!main_loop)
@@ -37,6 +41,15 @@ bool init(Client& cl, int port, std::optional<int> local_port) noexcept
             , [](){ }
             , [&cl]()
             {
+                if (tcp_framer)
+                {
+                    tcp_framer->read(*cl, [](std::string_view resp)
+                    {
+                        std::cout << "response: " << resp << std::endl;
+                    });
+                    return;
+                }
+
                 std::string resp;
                 do
                 {
@@ -70,6 +83,7 @@ int main(int argc, char* argv[])
     if (proto == "tcp")
     {
         client_tcp.emplace(epoll_t{5, 10u}, ipv4{});
+        tcp_framer.emplace(framing::length_prefix_codec{framing::length_prefix_codec::prefix_t::VARINT, 4096}, 8192);
         if (init(client_tcp, remote_port, std::nullopt))
         {
             client = &*client_tcp;
@@ -97,9 +111,12 @@ int main(int argc, char* argv[])
     while (main_loop)
     {
         client->proceed(std::chrono::milliseconds{10});
-        if (auto input = ai.read_line())
+        // empty line would be sent as empty tcp request
+        if (auto input = ai.read_line(); input && !input->empty())
         {
-            auto sent = client->send(input->data(), input->size());
+            auto sent = tcp_framer
+                    ? tcp_framer->write(*client, *input)
+                    : client->send(input->data(), input->size());
             if (!sent && !client->finished_send() && !client->finished_recv())
             {
                 std::cerr << "error sending request {" << *input << "}" << std::endl;
@@ -1,6 +1,9 @@
 #include <endpoint/server.h>
+#include <endpoint/prometheus_exporter.h>
 #include <socket/af_inet.h>
 #include <epoll/epoll.h>
+#include <framing/framer.h>
+#include <trace/trace.h>
 
 #include "service.h"
 #include "base_socket.h"
@@ -18,6 +21,7 @@ using namespace protei::utils;
 using namespace protei::endpoint;
 
 static sig_atomic_t volatile main_loop = 1;
+static sig_atomic_t volatile dump_trace = 0;
 
 void sig(int) noexcept
 {
@@ -29,7 +33,19 @@ void sig(int) noexcept
     main_loop = 0;
 }
 
-std::vector<std::pair<base_socket, std::string>> active_sockets;
+/// tcp requests and responses are varint length prefixed, responses are multiline
+using framer = framing::framer_t<framing::length_prefix_codec>;
+static constexpr std::size_t MAX_REQUEST_SIZE = 4096;
+
+/// buffers are borrowed from server's pool only while request is being received
+struct connection_state
+{
+    buffer::pooled_buffer request;
+    std::size_t request_size = 0;
+    std::optional<framer> tcp_framer;
+};
+
+std::vector<std::pair<base_socket, connection_state>> active_sockets;
 
 
 bool init(server_t<udp, epoll_t>& serv, int local_port) noexcept
@@ -42,7 +58,7 @@ bool init(server_t<udp, epoll_t>& serv, int local_port) noexcept
                 active_sockets.emplace_back(
                         std::piecewise_construct
                         , std::forward_as_tuple(std::move(sock), -1)
-                        , std::forward_as_tuple(""));
+                        , std::forward_as_tuple());
             }
             , []() { active_sockets.clear(); });
 }
@@ -54,13 +70,17 @@ bool init(server_t<tcp, epoll_t>& serv, int local_port) noexcept
             "127.0.0.1"
             , local_port
             , 10
-            , [](accepted_sock<tcp>&& sock)
+            , [&serv](accepted_sock<tcp>&& sock)
             {
                 int fd = sock.native_handle();
-                active_sockets.emplace_back(
+                auto& conn = active_sockets.emplace_back(
                         std::piecewise_construct
                         , std::forward_as_tuple(std::move(sock), fd)
-                        , std::forward_as_tuple(""));
+                        , std::forward_as_tuple());
+                conn.second.tcp_framer.emplace(
+                        framing::length_prefix_codec{framing::length_prefix_codec::prefix_t::VARINT, MAX_REQUEST_SIZE}
+                        , serv.buffers
+                        , 2 * MAX_REQUEST_SIZE);
             }
             , [](int fd)
             {
@@ -85,23 +105,23 @@ int main(int argc, char* argv[])
 
     service_t service;
     proceed_i* server = nullptr;
-    unsigned buff_size;
+    buffer::buffer_pool* buffers = nullptr;
     if (proto == "tcp")
     {
-        buff_size = 20;
         server_tcp.emplace(epoll_t{5, 10u}, ipv4{});
         if (init(*server_tcp, local_port))
         {
             server = &*server_tcp;
+            buffers = &server_tcp->buffers;
         }
     }
     else if (proto == "udp")
     {
-        buff_size = 256;
         server_udp.emplace(epoll_t{5, 10u}, ipv4{});
         if (init(*server_udp, local_port))
         {
             server = &*server_udp;
+            buffers = &server_udp->buffers;
         }
     }
 
@@ -111,34 +131,77 @@ int main(int argc, char* argv[])
         std::terminate();
     }
 
+    // optional Prometheus scrape endpoint, served by the same thread between server's proceeds
+    prometheus_exporter exporter;
+    bool export_metrics = argc > 3;
+    if (export_metrics)
+    {
+        if (server_tcp)
+        {
+            exporter.add(proto, *server_tcp);
+        }
+        else
+        {
+            exporter.add(proto, *server_udp);
+        }
+        if (!exporter.start("127.0.0.1", std::stoi(argv[3])))
+        {
+            std::cerr << "error initializing metrics exporter";
+            std::terminate();
+        }
+    }
+
     signal(SIGTERM, sig);
     signal(SIGINT, sig);
+    // socket operations trace is dumped on SIGUSR1 and on crash
+    signal(SIGUSR1, [](int) { dump_trace = 1; });
+    trace::install_crash_handler("server.crash.trace");
 
-    std::string tmp_buff;
-    tmp_buff.resize(buff_size);
+    // reused by all connections, the loop serves them one by one
+    std::string response;
     while (main_loop)
     {
+        if (dump_trace)
+        {
+            dump_trace = 0;
+            trace::dump("server.trace");
+        }
         if (!server->proceed(std::chrono::milliseconds{10})) std::this_thread::yield();
+        if (export_metrics) exporter.proceed(std::chrono::milliseconds{0});
         for (auto it = active_sockets.begin(); it != active_sockets.end(); )
         {
+            auto& [sock, conn] = *it;
+            if (conn.tcp_framer)
+            {
+                // frames are answered as they are parsed, framer's write doesn't touch its read ring
+                bool sent = true;
+                auto framed = conn.tcp_framer->read(*sock.socket, [&](std::string_view request)
+                {
+                    sent = sent && conn.tcp_framer->write(*sock.socket, service.create_response(request, response));
+                });
+                it = framed && sent ? std::next(it) : active_sockets.erase(it);
+                continue;
+            }
+
             std::optional<std::pair<in_address_port_t, std::size_t>> rec;
             do
             {
-                rec = it->first.socket->recv(tmp_buff.data(), tmp_buff.size());
-                if (rec) it->second += tmp_buff.substr(0, rec->second);
-            } while (rec);
-            if (it->first.socket->finished_recv() && !it->second.empty())
-            {
-                auto resp = service.create_response(it->second);
-                auto sent = it->first.socket->send(resp.data(), resp.size());
-                if (!sent || proto != "tcp")
-                {
-                    it = active_sockets.erase(it);
-                }
-                else
+                if (!conn.request)
                 {
-                    it->second.clear();
+                    conn.request = buffers->acquire(MAX_REQUEST_SIZE);
                 }
+                rec = sock.socket->recv(conn.request.data() + conn.request_size, MAX_REQUEST_SIZE - conn.request_size);
+                if (rec) conn.request_size += rec->second;
+            } while (rec && conn.request_size < MAX_REQUEST_SIZE);
+            if (!conn.request_size)
+            {
+                conn.request.release();
+            }
+            if ((sock.socket->finished_recv() || conn.request_size == MAX_REQUEST_SIZE) && conn.request_size)
+            {
+                service.create_response({conn.request.data(), conn.request_size}, response);
+                sock.socket->send(response.data(), response.size());
+                it = active_sockets.erase(it);
             }
             else
             {
@@ -147,6 +210,8 @@ int main(int argc, char* argv[])
         }
     }
 
+    // connections borrow buffers from server's pool and reference its sockets, so they go before server
+    active_sockets.clear();
     return 0;
 }
 
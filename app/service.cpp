@@ -1,52 +1,58 @@
 #include "service.h"
 
 #include <algorithm>
-#include <sstream>
-#include <iterator>
+#include <charconv>
+#include <cctype>
 
-bool service_t::is_number(std::string const& s)
+bool service_t::is_number(std::string_view s)
 {
     return !s.empty() && std::find_if(s.begin(), s.end(), [](unsigned char c) { return !std::isdigit(c); }) == s.end();
 }
 
 
-std::vector<unsigned> service_t::parse_ints(const std::string& request)
+void service_t::parse_ints(std::string_view request)
 {
-    std::stringstream ss(request);
-    std::vector<std::string> int_strs;
-    std::copy_if(std::istream_iterator<std::string>(ss)
-            , std::istream_iterator<std::string>()
-            , std::back_inserter(int_strs)
-            , is_number);
-    std::vector<unsigned> ints;
-    std::transform(
-            int_strs.begin()
-            , int_strs.end()
-            , std::back_inserter(ints)
-            , [](std::string const& str) { return std::stoi(str); });
-    return ints;
+    auto is_space = [](unsigned char c) { return std::isspace(c); };
+    m_ints.clear();
+    for (auto it = request.begin(); it != request.end(); )
+    {
+        auto begin = std::find_if_not(it, request.end(), is_space);
+        it = std::find_if(begin, request.end(), is_space);
+        auto token = request.substr(begin - request.begin(), it - begin);
+        unsigned value = 0;
+        if (is_number(token) && std::from_chars(token.data(), token.data() + token.size(), value).ec == std::errc{})
+        {
+            m_ints.push_back(value);
+        }
+    }
 }
 
 
 std::string service_t::create_response(std::string const& req)
 {
-    auto ints = parse_ints(req);
-    if (ints.empty())
+    std::string resp;
+    create_response(req, resp);
+    return resp;
+}
+
+
+std::string_view service_t::create_response(std::string_view req, std::string& resp)
+{
+    parse_ints(req);
+    if (m_ints.empty())
     {
-        return req;
+        return resp.assign(req);
     }
-    else
+
+    std::sort(m_ints.begin(), m_ints.end());
+    char number[16];
+    unsigned sum = 0;
+    resp.clear();
+    for (unsigned n: m_ints)
     {
-        std::sort(ints.begin(), ints.end());
-        std::stringstream ss;
-        unsigned sum = 0;
-        std::copy_if(
-                ints.begin(), ints.end(), std::ostream_iterator<unsigned>(ss, " "), [&](unsigned n)
-                {
-                    sum += n;
-                    return true;
-                });
-        //sum = std::accumulate(ints.begin(), ints.end(), 0u, std::plus<>{});
-        return ss.str() + "\n" + std::to_string(sum);
+        sum += n;
+        resp.append(number, std::to_chars(number, number + sizeof(number), n).ptr).push_back(' ');
     }
+    resp.push_back('\n');
+    return resp.append(number, std::to_chars(number, number + sizeof(number), sum).ptr);
 }
@@ -2,6 +2,7 @@
 #define PROTEI_TEST_TASK_SERVICE_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 class service_t
@@ -9,10 +10,20 @@ class service_t
 public:
     std::string create_response(std::string const& req);
 
+    /**
+     * @brief Create response without allocating once buffers have grown to the largest request
+     * @param req - request
+     * @param resp - response buffer, overwritten, reused between calls
+     * @return view of resp
+     */
+    std::string_view create_response(std::string_view req, std::string& resp);
+
 private:
-    static std::vector<unsigned> parse_ints(std::string const& request);
-    static bool is_number(std::string const& s);
+    void parse_ints(std::string_view request);
+    static bool is_number(std::string_view s);
 
+    /// parsed request integers, reused between calls
+    std::vector<unsigned> m_ints;
 };
 
 
@@ -0,0 +1,71 @@
+#include <trace/trace.h>
+
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <unordered_map>
+
+using namespace protei;
+
+/**
+ * Decodes trace dump written by trace::dump: one line per record ordered by time, with gap since previous record of
+ * the same thread. Large gap shows where thread stalled between socket operations.
+ *
+ * usage: trace_decode <dump_file> [min_gap_us] [fd]
+ *   min_gap_us - print only records preceded by at least that gap in their thread
+ *   fd - print only records of that descriptor
+ */
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <dump_file> [min_gap_us] [fd]" << std::endl;
+        return 1;
+    }
+    double min_gap_us = argc > 2 ? std::stod(argv[2]) : 0.;
+    std::optional<int> fd;
+    if (argc > 3)
+    {
+        fd = std::stoi(argv[3]);
+    }
+
+    auto file = trace::load(argv[1]);
+    if (!file)
+    {
+        std::cerr << argv[1] << " isn't trace dump" << std::endl;
+        return 1;
+    }
+    std::cout << "# " << file->records.size() << " records" << std::endl;
+
+    std::unordered_map<std::uint32_t, std::uint64_t> last_by_tid;
+    for (auto const& rec: file->records)
+    {
+        auto [last, first] = last_by_tid.try_emplace(rec.tid, rec.timestamp_ns);
+        double gap_us = static_cast<double>(rec.timestamp_ns - last->second) / 1e3;
+        last->second = rec.timestamp_ns;
+        if ((!first && gap_us < min_gap_us) || (fd && rec.fd != *fd))
+        {
+            continue;
+        }
+
+        auto wall_ns = static_cast<std::int64_t>(rec.timestamp_ns) + file->header.realtime_offset_ns;
+        std::time_t wall_s = wall_ns / 1000000000;
+        std::tm tm{};
+        ::gmtime_r(&wall_s, &tm);
+        std::cout << std::put_time(&tm, "%FT%T") << '.' << std::setw(9) << std::setfill('0') << wall_ns % 1000000000
+                  << std::setfill(' ') << "Z +" << std::fixed << std::setprecision(3) << std::setw(12) << gap_us
+                  << "us tid=" << rec.tid << " fd=" << rec.fd << ' ' << trace::to_string(rec.op)
+                  << " size=" << rec.size << " result=";
+        if (rec.result < 0)
+        {
+            std::cout << std::strerror(static_cast<int>(-rec.result));
+        }
+        else
+        {
+            std::cout << rec.result;
+        }
+        std::cout << '\n';
+    }
+    return 0;
+}
@@ -0,0 +1,300 @@
+#include <endpoint/server.h>
+#include <endpoint/client.h>
+#include <epoll/epoll.h>
+#include <socket/af_inet.h>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <thread>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::endpoint;
+
+static constexpr char const* ADDRESS = "127.0.0.1";
+/// connection is given up if greeting doesn't arrive: client side is established once SYN-ACK arrives, but server
+/// drops final ACK on accept queue overflow, so connection may never be accepted
+static constexpr std::chrono::seconds GREETING_TIMEOUT{3};
+
+using clock_type = std::chrono::steady_clock;
+
+/**
+ * @brief Server statistics shared with parent process
+ */
+struct server_stats
+{
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> accepted{0};
+    std::atomic<std::uint64_t> erased{0};
+    /// time accept queue length was at backlog
+    std::atomic<std::uint64_t> backlog_full_ns{0};
+    std::atomic<std::uint32_t> max_queue{0};
+};
+
+
+/**
+ * @brief Read TcpExt counter of /proc/net/netstat. Counter is host wide
+ * @return counter, 0 if not available
+ */
+static std::uint64_t tcp_ext(std::string const& counter_name)
+{
+    std::ifstream netstat{"/proc/net/netstat"};
+    std::string header;
+    std::string values;
+    while (std::getline(netstat, header))
+    {
+        if (header.rfind("TcpExt:", 0) == 0 && std::getline(netstat, values))
+        {
+            std::istringstream names{header};
+            std::istringstream counters{values};
+            std::string name;
+            std::string counter;
+            while (names >> name && counters >> counter)
+            {
+                if (name == counter_name)
+                {
+                    return std::stoull(counter);
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * @brief Accepts connections, greets each with one byte and drops it on peer close through erase_active_socket.
+ * Samples accept queue of listening socket: for listener TCP_INFO reports queue length in tcpi_unacked and backlog in
+ * tcpi_sacked
+ */
+static int run_server(int listening_fd, std::size_t max_conns, server_stats& stats)
+{
+    server_t<tcp, epoll_t> server{epoll_t{5, 64u}, ipv4{}};
+    std::map<int, accepted_sock<tcp>> conns;
+    if (!server.start(
+            ::dup(listening_fd)
+            , max_conns
+            , [&conns, &stats](accepted_sock<tcp>&& sock)
+            {
+                char greeting = 'c';
+                sock.send(&greeting, 1);
+                auto fd = sock.native_handle();
+                conns.emplace(fd, std::move(sock));
+                stats.accepted.fetch_add(1, std::memory_order_relaxed);
+            }
+            , [&conns, &stats](int fd)
+            {
+                if (conns.erase(fd))
+                {
+                    stats.erased.fetch_add(1, std::memory_order_relaxed);
+                }
+            }))
+    {
+        std::cerr << "server start failed" << std::endl;
+        return 1;
+    }
+
+    auto sampled = clock_type::now();
+    bool full = false;
+    while (!stats.stop.load(std::memory_order_relaxed))
+    {
+        if (!server.proceed(std::chrono::milliseconds{0}))
+        {
+            std::this_thread::yield();
+        }
+
+        tcp_info info{};
+        socklen_t len = sizeof(info);
+        auto now = clock_type::now();
+        if (full)
+        {
+            stats.backlog_full_ns += static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(now - sampled).count());
+        }
+        sampled = now;
+        if (::getsockopt(listening_fd, IPPROTO_TCP, TCP_INFO, &info, &len) == 0)
+        {
+            full = info.tcpi_unacked >= info.tcpi_sacked;
+            if (info.tcpi_unacked > stats.max_queue.load(std::memory_order_relaxed))
+            {
+                stats.max_queue = info.tcpi_unacked;
+            }
+        }
+    }
+    server.stop();
+    return 0;
+}
+
+
+/**
+ * @brief Short-lived connection: connected, waits for greeting, closed
+ */
+struct churn_client
+{
+    std::unique_ptr<client_t<tcp, epoll_t>> client;
+    clock_type::time_point started;
+    bool connecting = false;
+};
+
+
+/**
+ * @brief Connection churn of server_t<tcp, epoll_t>: clients open connections, wait for server's greeting sent on
+ * accept and close them, keeping `concurrency` connections in flight. Accept latency is time from connect to
+ * greeting, so it includes accept queue wait. Exercises listening_socket_t::accept, erase_active_socket and
+ * epoll_t::add_socket/del_socket on both sides. Time with accept queue at backlog is sampled by server, listen
+ * overflows are TcpExt ListenOverflows of /proc/net/netstat.
+ * Usage: bench_churn [connections] [concurrency] [backlog] [port]
+ */
+int main(int argc, char* argv[])
+{
+    std::size_t connections = argc > 1 ? std::stoul(argv[1]) : 20000;
+    std::size_t concurrency = argc > 2 ? std::stoul(argv[2]) : 32;
+    int backlog = argc > 3 ? std::stoi(argv[3]) : 16;
+    auto port = static_cast<std::uint_fast16_t>(argc > 4 ? std::stoul(argv[4]) : 7902);
+    if (connections == 0 || concurrency == 0 || backlog <= 0)
+    {
+        std::cerr << "connections, concurrency and backlog must be positive" << std::endl;
+        return 1;
+    }
+
+    auto listener = utils::mbind(
+            socket_t<tcp>::create(ipv4{})
+            , [port](socket_t<tcp>&& sock)
+            {
+                sock.set_reuse_address(true);
+                return sock.bind(in_address_port_t{in_address_t{ADDRESS}, port});
+            }
+            , [backlog](binded_socket_t<tcp>&& sock) { return sock.listen(backlog); });
+    auto* stats_memory = ::mmap(nullptr, sizeof(server_stats), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (!listener || stats_memory == MAP_FAILED)
+    {
+        std::cerr << "listen or shared memory allocation failed" << std::endl;
+        return 1;
+    }
+    auto* stats = new (stats_memory) server_stats{};
+
+    pid_t pid = ::fork();
+    if (pid == -1)
+    {
+        std::cerr << "fork failed" << std::endl;
+        return 1;
+    }
+    else if (pid == 0)
+    {
+        return run_server(listener->native_handle(), concurrency * 2, *stats);
+    }
+    listener.reset();
+
+    std::vector<churn_client> clients(concurrency);
+    for (auto& conn: clients)
+    {
+        conn.client = std::make_unique<client_t<tcp, epoll_t>>(epoll_t{5, 10u}, ipv4{});
+    }
+
+    std::vector<double> latencies;
+    latencies.reserve(connections);
+    std::size_t opened = 0;
+    std::size_t failed = 0;
+    std::size_t timed_out = 0;
+    auto overflows_before = tcp_ext("ListenOverflows");
+    auto start = clock_type::now();
+    while (latencies.size() + failed + timed_out < connections)
+    {
+        bool progress = false;
+        for (auto& conn: clients)
+        {
+            if (!conn.connecting && opened < connections)
+            {
+                conn.started = clock_type::now();
+                if (conn.client->start() && conn.client->connect(ADDRESS, port, [](){}, [](){}, [](){}))
+                {
+                    conn.connecting = true;
+                }
+                else
+                {
+                    conn.client->stop();
+                    ++failed;
+                }
+                ++opened;
+                progress = true;
+            }
+            else if (conn.connecting)
+            {
+                char greeting;
+                auto rec = conn.client->recv(&greeting, 1);
+                if (rec && rec->second == 1)
+                {
+                    latencies.push_back(
+                            std::chrono::duration<double, std::micro>(clock_type::now() - conn.started).count());
+                }
+                else if (rec || !conn.client->finished_recv())
+                {
+                    // refused or reset
+                    ++failed;
+                }
+                else if (clock_type::now() - conn.started > GREETING_TIMEOUT)
+                {
+                    ++timed_out;
+                }
+                else
+                {
+                    continue;
+                }
+                conn.client->stop();
+                conn.connecting = false;
+                progress = true;
+            }
+        }
+        if (!progress)
+        {
+            std::this_thread::yield();
+        }
+    }
+    std::chrono::duration<double> elapsed = clock_type::now() - start;
+    auto overflows = tcp_ext("ListenOverflows") - overflows_before;
+
+    // let server see last closes
+    auto deadline = clock_type::now() + std::chrono::seconds{1};
+    while (stats->erased < stats->accepted && clock_type::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    stats->stop = true;
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+
+    if (latencies.empty())
+    {
+        std::cerr << "no connection succeeded" << std::endl;
+        return 1;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) { return latencies[static_cast<std::size_t>(p * (latencies.size() - 1))]; };
+    std::cout << std::fixed << std::setprecision(1)
+              << "connections: " << connections << ", concurrency: " << concurrency << ", backlog: " << backlog << '\n'
+              << "conn/s: " << static_cast<double>(latencies.size()) / elapsed.count()
+              << ", succeeded: " << latencies.size() << ", failed: " << failed << ", timed out: " << timed_out << '\n'
+              << "accept latency, us: min " << latencies.front() << ", p50 " << percentile(0.5)
+              << ", p99 " << percentile(0.99) << ", p999 " << percentile(0.999) << ", max " << latencies.back() << '\n'
+              << "server: accepted " << stats->accepted << ", erased " << stats->erased
+              << ", max accept queue " << stats->max_queue
+              << ", backlog full " << static_cast<double>(stats->backlog_full_ns) / 1e6 << " ms of "
+              << elapsed.count() * 1e3 << " ms, listen overflows " << overflows << std::endl;
+    stats->~server_stats();
+    ::munmap(stats_memory, sizeof(server_stats));
+    return 0;
+}
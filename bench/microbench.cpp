@@ -0,0 +1,245 @@
+#include <endpoint/event_observer.h>
+#include <endpoint/server.h>
+#include <epoll/epoll.h>
+#include <socket/af_inet.h>
+#include <socket/in_address.h>
+#include <socket/socket.h>
+#include <utils/address_from_string.h>
+#include <utils/mbind.h>
+
+#include <benchmark/benchmark.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace protei;
+
+namespace
+{
+
+/**
+ * @brief Poll returning prepared events without syscalls, so only dispatch is measured
+ */
+struct fake_poll
+{
+    std::vector<poll_event::event> events;
+
+    std::vector<poll_event::event> proceed(std::chrono::milliseconds) noexcept
+    {
+        return events;
+    }
+
+    bool add_socket(int, sock::sock_op, bool = false) noexcept
+    {
+        return true;
+    }
+
+    bool mod_socket(int, sock::sock_op) noexcept
+    {
+        return true;
+    }
+
+    bool del_socket(int) noexcept
+    {
+        return true;
+    }
+};
+
+
+/**
+ * @brief Reports per-item time of benchmark processing items per iteration
+ */
+void per_item(benchmark::State& state, std::int64_t items, char const* name)
+{
+    state.SetItemsProcessed(state.iterations() * items);
+    state.counters[name] = benchmark::Counter(
+            static_cast<double>(items)
+            , benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+}
+
+
+/**
+ * @brief event_observer_t::proceed dispatch of range(0) events through poll_traits, half read and half write ready
+ */
+static void event_observer_proceed(benchmark::State& state)
+{
+    fake_poll poll;
+    for (std::int64_t i = 0; i < state.range(0); ++i)
+    {
+        poll.events.push_back(poll_event::event{
+                static_cast<int>(i)
+                , i % 2 ? poll_event::event_type::READ_READY : poll_event::event_type::WRITE_READY});
+    }
+
+    std::size_t handled = 0;
+    endpoint::event_observer_t<fake_poll> observer{std::move(poll), nullptr};
+    observer.add(poll_event::event_type::READ_READY, [&handled](int) { ++handled; });
+    observer.add(poll_event::event_type::WRITE_READY, [&handled](int) { ++handled; });
+    for (auto _: state)
+    {
+        benchmark::DoNotOptimize(observer.proceed(std::chrono::milliseconds{0}));
+    }
+    benchmark::DoNotOptimize(handled);
+    per_item(state, state.range(0), "ns/event");
+}
+BENCHMARK(event_observer_proceed)->Arg(1)->Arg(16)->Arg(256);
+
+
+/**
+ * @brief epoll_t::proceed of ready socket pair: epoll_wait and conversion of epoll flags to event types, both ends
+ * report read and write readiness
+ */
+static void epoll_proceed(benchmark::State& state)
+{
+    int fds[2];
+    auto poll = epoll::epoll_t::create(5, 10u);
+    if (!poll || ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) != 0)
+    {
+        state.SkipWithError("epoll or socket pair isn't available");
+        return;
+    }
+    char byte = 0;
+    for (int fd: fds)
+    {
+        ::send(fd, &byte, 1, 0);
+        poll->add_socket(fd, sock::sock_op::READ_WRITE);
+    }
+
+    std::vector<poll_event::event> events;
+    std::size_t handled = 0;
+    for (auto _: state)
+    {
+        events.clear();
+        handled += poll->proceed(std::chrono::milliseconds{0}, events);
+    }
+    benchmark::DoNotOptimize(handled);
+    per_item(state, std::size(fds), "ns/event");
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+BENCHMARK(epoll_proceed);
+
+
+/**
+ * @brief in_address_t::create of IPv4 or IPv6 string
+ */
+static void in_address_create(benchmark::State& state)
+{
+    std::string const address = state.range(0) ? "2001:db8::8a2e:370:7334" : "192.168.100.200";
+    for (auto _: state)
+    {
+        benchmark::DoNotOptimize(sock::in_address_t::create(address));
+    }
+    per_item(state, 1, "ns/op");
+}
+BENCHMARK(in_address_create)->ArgName("ipv6")->Arg(0)->Arg(1);
+
+
+/**
+ * @brief utils::from_string_and_port of IPv4 or IPv6 string
+ */
+static void from_string_and_port(benchmark::State& state)
+{
+    std::string const address = state.range(0) ? "2001:db8::8a2e:370:7334" : "192.168.100.200";
+    for (auto _: state)
+    {
+        benchmark::DoNotOptimize(utils::from_string_and_port(address, 5060));
+    }
+    per_item(state, 1, "ns/op");
+}
+BENCHMARK(from_string_and_port)->ArgName("ipv6")->Arg(0)->Arg(1);
+
+
+/**
+ * @brief socket_t<udp>::receive of loopback datagram: recvfrom and conversion of sender's native IPv4 or IPv6 address,
+ * as done per datagram
+ */
+static void udp_receive(benchmark::State& state)
+{
+    bool v6 = state.range(0);
+    auto serv_addr = utils::from_string_and_port(v6 ? "::1" : "127.0.0.1", 8097);
+    auto create = [v6]()
+    {
+        return v6 ? sock::socket_t<sock::udp>::create(sock::ipv6{}) : sock::socket_t<sock::udp>::create(sock::ipv4{});
+    };
+    auto serv = serv_addr ? utils::mbind(create(), [&](auto&& sock) { return sock.bind(*serv_addr); }) : std::nullopt;
+    auto client = serv ? utils::mbind(create(), [&](auto&& sock) { return sock.connect(*serv_addr); }) : std::nullopt;
+    if (!client)
+    {
+        state.SkipWithError("loopback isn't available");
+        return;
+    }
+
+    char datagram[64] = {};
+    for (auto _: state)
+    {
+        if (!client->send(datagram, sizeof(datagram), 0))
+        {
+            state.SkipWithError("send failed");
+            break;
+        }
+        benchmark::DoNotOptimize(serv->receive(datagram, sizeof(datagram), 0));
+    }
+    per_item(state, 1, "ns/op");
+}
+BENCHMARK(udp_receive)->ArgName("ipv6")->Arg(0)->Arg(1);
+
+
+/**
+ * @brief mbind chain of server_t::start shape: create, bind and listen stages over std::optional, without syscalls,
+ * against hand written checks
+ */
+static void mbind_chain(benchmark::State& state)
+{
+    auto create = [](int v) -> std::optional<int> { return v + 1; };
+    auto bind = [](int v) -> std::optional<long> { return v + 7; };
+    auto listen = [](long v) -> std::optional<long> { return v > 0 ? std::optional{v} : std::nullopt; };
+    int seed = 1;
+    for (auto _: state)
+    {
+        benchmark::DoNotOptimize(seed);
+        if (state.range(0))
+        {
+            benchmark::DoNotOptimize(utils::mbind(create(seed), bind, listen));
+        }
+        else
+        {
+            std::optional<long> ret;
+            if (auto c = create(seed))
+            {
+                if (auto b = bind(*c))
+                {
+                    ret = listen(*b);
+                }
+            }
+            benchmark::DoNotOptimize(ret);
+        }
+    }
+    per_item(state, 1, "ns/op");
+}
+BENCHMARK(mbind_chain)->ArgName("mbind")->Arg(0)->Arg(1);
+
+
+/**
+ * @brief server_t::start and stop over fake poll: mbind chains of start plus socket, bind and listen syscalls
+ */
+static void server_start_stop(benchmark::State& state)
+{
+    endpoint::server_t<sock::tcp, fake_poll> server{fake_poll{}, sock::ipv4{}};
+    for (auto _: state)
+    {
+        if (!server.start("127.0.0.1", 0, 16, [](endpoint::accepted_sock<sock::tcp>&&) {}, [](int) {}))
+        {
+            state.SkipWithError("server start failed");
+            break;
+        }
+        server.stop();
+    }
+    per_item(state, 1, "ns/op");
+}
+BENCHMARK(server_start_stop);
+
+
+BENCHMARK_MAIN();
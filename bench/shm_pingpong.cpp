@@ -0,0 +1,152 @@
+#include <endpoint/shm_server.h>
+#include <endpoint/shm_client.h>
+#include <epoll/epoll.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <thread>
+
+using namespace protei;
+using namespace protei::epoll;
+using namespace protei::endpoint;
+
+static constexpr char const* ADDRESS = "@protei.bench.shm_pingpong";
+
+/**
+ * @brief Echoes messages of the first connection until it's closed
+ */
+static int run_server(bool spin, std::size_t message_size)
+{
+    shm_server_t<epoll_t> server{epoll_t{5, 10u}};
+    std::optional<shm_accepted_sock> conn;
+    bool closed = false;
+    if (!server.start(
+            ADDRESS
+            , 1
+            , [&conn](shm_accepted_sock&& sock) { conn.emplace(std::move(sock)); }
+            , [&closed](int) { closed = true; }))
+    {
+        std::cerr << "server start failed" << std::endl;
+        return 1;
+    }
+
+    std::string buff(message_size, '\0');
+    while (!closed)
+    {
+        if (!spin || !conn)
+        {
+            server.proceed(std::chrono::milliseconds{100});
+        }
+        else
+        {
+            server.proceed(std::chrono::milliseconds{0});
+        }
+
+        while (conn)
+        {
+            auto rec = conn->recv(buff.data(), buff.size());
+            if (!rec)
+            {
+                break;
+            }
+            conn->send(buff.data(), rec->second);
+        }
+    }
+    return 0;
+}
+
+
+static int run_client(bool spin, std::size_t message_size, std::size_t iterations)
+{
+    shm_client_t<epoll_t> client{epoll_t{5, 10u}};
+    bool connected = false;
+    for (int tries = 0; tries < 100 && !connected; ++tries)
+    {
+        client.stop();
+        connected = client.start() && client.connect(ADDRESS, [](){}, [](){}, [](){});
+        if (!connected)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+    }
+    while (connected && !client.connected())
+    {
+        client.proceed(std::chrono::milliseconds{100});
+    }
+    if (!connected)
+    {
+        std::cerr << "client connect failed" << std::endl;
+        return 1;
+    }
+
+    std::string msg(message_size, 'p');
+    std::string buff(message_size, '\0');
+    std::vector<std::chrono::nanoseconds> rtt;
+    rtt.reserve(iterations);
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        client.send(msg.data(), msg.size());
+        std::optional<std::pair<sock::unix_address_t, std::size_t>> rec;
+        while (!(rec = client.recv(buff.data(), buff.size())))
+        {
+            if (!spin)
+            {
+                client.proceed(std::chrono::milliseconds{100});
+            }
+        }
+        rtt.push_back(std::chrono::steady_clock::now() - start);
+    }
+    client.stop();
+
+    std::sort(rtt.begin(), rtt.end());
+    auto total = std::accumulate(rtt.begin(), rtt.end(), std::chrono::nanoseconds{0});
+    auto percentile = [&rtt](double p) { return rtt[static_cast<std::size_t>(p * (rtt.size() - 1))].count(); };
+    std::cout << "mode: " << (spin ? "spin" : "poll")
+              << ", message: " << message_size << " bytes"
+              << ", iterations: " << iterations << '\n'
+              << "round trip, ns: min " << rtt.front().count()
+              << ", avg " << total.count() / static_cast<long>(rtt.size())
+              << ", p50 " << percentile(0.5)
+              << ", p99 " << percentile(0.99)
+              << ", max " << rtt.back().count() << std::endl;
+    return 0;
+}
+
+
+/**
+ * @brief Shared memory ping-pong between two processes.
+ * Usage: bench_shm_pingpong [iterations] [message_size] [spin|poll]
+ * spin mode busy-polls rings and needs two free cores, poll mode sleeps in epoll between messages.
+ */
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::stoul(argv[1]) : 100000;
+    std::size_t message_size = argc > 2 ? std::stoul(argv[2]) : 64;
+    bool spin = argc > 3 ? std::string{argv[3]} == "spin" : std::thread::hardware_concurrency() > 1;
+    if (iterations == 0 || message_size == 0)
+    {
+        std::cerr << "iterations and message size must be positive" << std::endl;
+        return 1;
+    }
+
+    pid_t pid = ::fork();
+    if (pid == -1)
+    {
+        std::cerr << "fork failed" << std::endl;
+        return 1;
+    }
+    else if (pid == 0)
+    {
+        return run_server(spin, message_size);
+    }
+
+    int ret = run_client(spin, message_size, iterations);
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    return ret;
+}
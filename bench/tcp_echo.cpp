@@ -0,0 +1,367 @@
+#include <endpoint/server.h>
+#include <endpoint/client.h>
+#include <epoll/epoll.h>
+#include <socket/af_inet.h>
+#ifdef PROTEI_BENCH_SYSCALLS
+#include <instrument/syscall_counter.h>
+#endif
+
+#include <sys/wait.h>
+#include <csignal>
+#include <unistd.h>
+
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <thread>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::endpoint;
+
+static constexpr char const* ADDRESS = "127.0.0.1";
+static constexpr std::size_t MESSAGE_SIZES[] = {64, 1024, 16384};
+static constexpr std::size_t DEPTHS[] = {1, 8, 32};
+
+using clock_type = std::chrono::steady_clock;
+
+/// syscalls are counted by instrumented bench_tcp_echo_syscalls build only, counters skew timings
+#ifdef PROTEI_BENCH_SYSCALLS
+static constexpr bool COUNT_SYSCALLS = true;
+#else
+static constexpr bool COUNT_SYSCALLS = false;
+#endif
+
+/**
+ * @brief Echoes received bytes of all connections until killed
+ */
+static int run_server(int listening_fd)
+{
+    struct connection
+    {
+        accepted_sock<tcp> sock;
+        std::string pending;
+    };
+
+    server_t<tcp, epoll_t> server{epoll_t{5, 64u}, ipv4{}};
+    std::map<int, connection> conns;
+    if (!server.start(
+            listening_fd
+            , 128
+            , [&conns](accepted_sock<tcp>&& sock)
+            {
+                auto fd = sock.native_handle();
+                conns.emplace(fd, connection{std::move(sock), {}});
+            }
+            , [&conns](int fd) { conns.erase(fd); }))
+    {
+        std::cerr << "server start failed" << std::endl;
+        return 1;
+    }
+
+    std::string buff(64 * 1024, '\0');
+    while (true)
+    {
+        bool progress = server.proceed(std::chrono::milliseconds{0});
+        for (auto& [fd, conn]: conns)
+        {
+            while (auto rec = conn.sock.recv(buff.data(), buff.size()))
+            {
+                if (rec->second == 0)
+                {
+                    break;
+                }
+                conn.pending.append(buff.data(), rec->second);
+                progress = true;
+            }
+            if (!conn.pending.empty())
+            {
+                if (auto sent = conn.sock.send(conn.pending.data(), conn.pending.size()))
+                {
+                    conn.pending.erase(0, *sent);
+                    progress = true;
+                }
+            }
+        }
+        if (!progress)
+        {
+            // single core machines share it with clients
+            server.proceed(std::chrono::milliseconds{1});
+        }
+    }
+}
+
+
+/**
+ * @brief Client connection keeping up to depth messages in flight
+ */
+struct echo_client
+{
+    std::unique_ptr<client_t<tcp, epoll_t>> client;
+    std::deque<clock_type::time_point> in_flight;
+    std::size_t sent = 0;
+    std::size_t sent_offset = 0;
+    std::size_t received_bytes = 0;
+    std::size_t completed = 0;
+};
+
+
+/**
+ * @brief Measurements of one swept case
+ */
+struct result_t
+{
+    std::size_t connections;
+    std::size_t message_size;
+    std::size_t depth;
+    double msgs_per_sec;
+    double mb_per_sec;
+    double p50_us;
+    double p99_us;
+    double p999_us;
+    /// client side syscalls per message, 0 unless COUNT_SYSCALLS
+    double syscalls_per_msg = 0;
+    double would_block_per_msg = 0;
+};
+
+
+/**
+ * @brief Connects clients and runs messages round trips per connection
+ * @return measurements, std::nullopt if connection fails or server closes it
+ */
+static std::optional<result_t> run_case(
+        std::uint_fast16_t port
+        , std::size_t connections
+        , std::size_t messages
+        , std::size_t message_size
+        , std::size_t depth)
+{
+    std::vector<echo_client> clients(connections);
+    for (auto& conn: clients)
+    {
+        conn.client = std::make_unique<client_t<tcp, epoll_t>>(epoll_t{5, 10u}, ipv4{});
+        if (!conn.client->start() || !conn.client->connect(ADDRESS, port, [](){}, [](){}, [](){}))
+        {
+            return std::nullopt;
+        }
+    }
+
+    std::string msg(message_size, 'e');
+    std::string buff(64 * 1024, '\0');
+    std::vector<double> latencies;
+    latencies.reserve(connections * messages);
+    std::size_t done = 0;
+#ifdef PROTEI_BENCH_SYSCALLS
+    instrument::syscall_scope syscalls;
+#endif
+    auto start = clock_type::now();
+    while (done < connections)
+    {
+        bool progress = false;
+        for (auto& conn: clients)
+        {
+            if (conn.completed == messages)
+            {
+                continue;
+            }
+
+            while (conn.sent < messages && conn.in_flight.size() < depth)
+            {
+                if (conn.sent_offset == 0)
+                {
+                    conn.in_flight.push_back(clock_type::now());
+                }
+                auto sent = conn.client->send(msg.data() + conn.sent_offset, msg.size() - conn.sent_offset);
+                if (!sent)
+                {
+                    if (conn.sent_offset == 0)
+                    {
+                        conn.in_flight.pop_back();
+                    }
+                    break;
+                }
+                progress = true;
+                conn.sent_offset += *sent;
+                if (conn.sent_offset < msg.size())
+                {
+                    break;
+                }
+                conn.sent_offset = 0;
+                ++conn.sent;
+            }
+
+            while (auto rec = conn.client->recv(buff.data(), buff.size()))
+            {
+                if (rec->second == 0)
+                {
+                    return std::nullopt;
+                }
+                progress = true;
+                conn.received_bytes += rec->second;
+                auto now = clock_type::now();
+                while (conn.received_bytes >= (conn.completed + 1) * message_size)
+                {
+                    latencies.push_back(
+                            std::chrono::duration<double, std::micro>(now - conn.in_flight.front()).count());
+                    conn.in_flight.pop_front();
+                    ++conn.completed;
+                }
+            }
+            if (conn.completed == messages)
+            {
+                ++done;
+            }
+        }
+        if (!progress)
+        {
+            std::this_thread::yield();
+        }
+    }
+    std::chrono::duration<double> elapsed = clock_type::now() - start;
+#ifdef PROTEI_BENCH_SYSCALLS
+    auto syscall_stats = syscalls.stats();
+#endif
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p)
+    {
+        return latencies[static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1))];
+    };
+    auto total = static_cast<double>(latencies.size());
+    result_t ret{
+            connections
+            , message_size
+            , depth
+            , total / elapsed.count()
+            , total * static_cast<double>(message_size) / elapsed.count() / 1e6
+            , percentile(0.5)
+            , percentile(0.99)
+            , percentile(0.999)};
+#ifdef PROTEI_BENCH_SYSCALLS
+    ret.syscalls_per_msg = static_cast<double>(syscall_stats.total()) / total;
+    ret.would_block_per_msg = static_cast<double>(syscall_stats.total_blocked()) / total;
+#endif
+    return ret;
+}
+
+
+/**
+ * @brief Writes results as JSON array of objects
+ */
+static void print_json(std::ostream& out, std::vector<result_t> const& results)
+{
+    out << "[\n";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        auto const& r = results[i];
+        out << "  {\"connections\": " << r.connections
+            << ", \"message_size\": " << r.message_size
+            << ", \"depth\": " << r.depth
+            << ", \"msgs_per_sec\": " << r.msgs_per_sec
+            << ", \"mb_per_sec\": " << r.mb_per_sec
+            << ", \"p50_us\": " << r.p50_us
+            << ", \"p99_us\": " << r.p99_us
+            << ", \"p999_us\": " << r.p999_us;
+        if (COUNT_SYSCALLS)
+        {
+            out << ", \"syscalls_per_msg\": " << r.syscalls_per_msg
+                << ", \"would_block_per_msg\": " << r.would_block_per_msg;
+        }
+        out << '}' << (i + 1 < results.size() ? "," : "") << '\n';
+    }
+    out << "]\n";
+}
+
+
+/**
+ * @brief Loopback echo throughput and latency of server_t<tcp, epoll_t> and client_t<tcp, epoll_t>. Server runs in
+ * child process, clients keep pipelining depth messages in flight. Message size and depth are swept. Instrumented
+ * bench_tcp_echo_syscalls build also counts client side syscalls per message and EAGAIN failed ones among them, its
+ * timings are skewed by counters.
+ * Usage: bench_tcp_echo [connections] [messages_per_connection] [json_path] [port]
+ */
+int main(int argc, char* argv[])
+{
+    std::size_t connections = argc > 1 ? std::stoul(argv[1]) : 8;
+    std::size_t messages = argc > 2 ? std::stoul(argv[2]) : 20000;
+    std::string json_path = argc > 3 ? argv[3] : "bench_tcp_echo.json";
+    auto port = static_cast<std::uint_fast16_t>(argc > 4 ? std::stoul(argv[4]) : 7900);
+    if (connections == 0 || messages == 0)
+    {
+        std::cerr << "connections and messages must be positive" << std::endl;
+        return 1;
+    }
+
+    auto listener = utils::mbind(
+            socket_t<tcp>::create(ipv4{})
+            , [port](socket_t<tcp>&& sock)
+            {
+                sock.set_reuse_address(true);
+                return sock.bind(in_address_port_t{in_address_t{ADDRESS}, port});
+            }
+            , [](binded_socket_t<tcp>&& sock) { return sock.listen(128); });
+    if (!listener)
+    {
+        std::cerr << "listen failed" << std::endl;
+        return 1;
+    }
+
+    pid_t pid = ::fork();
+    if (pid == -1)
+    {
+        std::cerr << "fork failed" << std::endl;
+        return 1;
+    }
+    else if (pid == 0)
+    {
+        return run_server(::dup(listener->native_handle()));
+    }
+    listener.reset();
+
+    std::vector<result_t> results;
+    std::cout << std::setw(6) << "conns" << std::setw(8) << "size" << std::setw(7) << "depth"
+              << std::setw(12) << "msgs/s" << std::setw(10) << "MB/s"
+              << std::setw(10) << "p50 us" << std::setw(10) << "p99 us" << std::setw(10) << "p999 us";
+    if (COUNT_SYSCALLS)
+    {
+        std::cout << std::setw(10) << "sys/msg" << std::setw(10) << "eagain";
+    }
+    std::cout << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    for (auto size: MESSAGE_SIZES)
+    {
+        for (auto depth: DEPTHS)
+        {
+            auto result = run_case(port, connections, messages, size, depth);
+            if (!result)
+            {
+                std::cerr << "case size " << size << " depth " << depth << " failed" << std::endl;
+                continue;
+            }
+            results.push_back(*result);
+            std::cout << std::setw(6) << result->connections << std::setw(8) << result->message_size
+                      << std::setw(7) << result->depth << std::setw(12) << result->msgs_per_sec
+                      << std::setw(10) << result->mb_per_sec << std::setw(10) << result->p50_us
+                      << std::setw(10) << result->p99_us << std::setw(10) << result->p999_us;
+            if (COUNT_SYSCALLS)
+            {
+                std::cout << std::setw(10) << result->syscalls_per_msg << std::setw(10) << result->would_block_per_msg;
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    ::kill(pid, SIGTERM);
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+
+    std::ofstream json{json_path};
+    print_json(json, results);
+    std::cout << "json: " << json_path << std::endl;
+    return results.empty() ? 1 : 0;
+}
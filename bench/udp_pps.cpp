@@ -0,0 +1,346 @@
+#include <endpoint/server.h>
+#include <epoll/epoll.h>
+#include <socket/af_inet.h>
+#ifdef PROTEI_BENCH_SYSCALLS
+#include <instrument/syscall_counter.h>
+#endif
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::endpoint;
+
+static constexpr char const* ADDRESS = "127.0.0.1";
+static constexpr unsigned BATCH = 64;
+static constexpr std::size_t MAX_DATAGRAM = 65507;
+
+using clock_type = std::chrono::steady_clock;
+
+/// syscalls are counted by instrumented bench_udp_pps_syscalls build only, counters skew timings
+#ifdef PROTEI_BENCH_SYSCALLS
+static constexpr bool COUNT_SYSCALLS = true;
+#else
+static constexpr bool COUNT_SYSCALLS = false;
+#endif
+
+/**
+ * @brief Receive path of server under test
+ */
+enum class recv_mode_t
+{
+    /// accepted_sock_ref::recv per datagram
+    SINGLE,
+    /// recvmmsg on server's socket, reference of batch path
+    BATCH
+};
+
+
+/**
+ * @brief Measurements of one run
+ */
+struct result_t
+{
+    std::uint64_t sent = 0;
+    std::uint64_t received = 0;
+    std::uint64_t rcvbuf_errors = 0;
+    std::uint64_t rxq_ovfl = 0;
+    double seconds = 0;
+    double cpu_seconds = 0;
+    /// receiving thread's syscalls and EAGAIN failed ones among them, 0 unless COUNT_SYSCALLS
+    std::uint64_t syscalls = 0;
+    std::uint64_t would_block = 0;
+};
+
+
+/**
+ * @brief Read Udp RcvbufErrors counter of /proc/net/snmp. Counter is host wide, concurrent UDP traffic is counted
+ * @return counter, 0 if not available
+ */
+static std::uint64_t rcvbuf_errors()
+{
+    std::ifstream snmp{"/proc/net/snmp"};
+    std::string header;
+    std::string values;
+    while (std::getline(snmp, header))
+    {
+        if (header.rfind("Udp:", 0) == 0 && std::getline(snmp, values))
+        {
+            std::istringstream names{header};
+            std::istringstream counters{values};
+            std::string name;
+            std::string counter;
+            while (names >> name && counters >> counter)
+            {
+                if (name == "RcvbufErrors")
+                {
+                    return std::stoull(counter);
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * @return CPU time consumed by calling thread, seconds
+ */
+static double thread_cpu()
+{
+    rusage usage{};
+    ::getrusage(RUSAGE_THREAD, &usage);
+    auto seconds = [](timeval const& tv)
+    {
+        return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+    };
+    return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+}
+
+
+/**
+ * @brief Sends datagrams to server until stopped
+ * @return sent datagrams count
+ */
+static std::uint64_t blast(std::uint_fast16_t port, std::size_t size, std::atomic<bool> const& running)
+{
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<std::uint16_t>(port));
+    ::inet_pton(AF_INET, ADDRESS, &addr.sin_addr);
+    if (fd == -1 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+    {
+        return 0;
+    }
+
+    std::string datagram(size, 'p');
+    std::uint64_t sent = 0;
+    while (running.load(std::memory_order_relaxed))
+    {
+        if (::send(fd, datagram.data(), datagram.size(), 0) == static_cast<ssize_t>(size))
+        {
+            ++sent;
+        }
+    }
+    ::close(fd);
+    return sent;
+}
+
+
+/**
+ * @brief Receives batch with recvmmsg, counting kernel drops reported by SO_RXQ_OVFL
+ * @return received datagrams count
+ */
+static std::size_t recv_batch(int fd, std::vector<std::string>& buffers, std::uint64_t& rxq_ovfl)
+{
+    mmsghdr msgs[BATCH]{};
+    iovec iov[BATCH];
+    alignas(cmsghdr) char control[BATCH][CMSG_SPACE(sizeof(std::uint32_t))];
+    for (unsigned i = 0; i < BATCH; ++i)
+    {
+        iov[i] = iovec{buffers[i].data(), buffers[i].size()};
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_control = control[i];
+        msgs[i].msg_hdr.msg_controllen = sizeof(control[i]);
+    }
+
+    int ret = ::recvmmsg(fd, msgs, BATCH, MSG_DONTWAIT, nullptr);
+    if (ret <= 0)
+    {
+        return 0;
+    }
+    for (int i = 0; i < ret; ++i)
+    {
+        for (auto* cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg; cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg))
+        {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL)
+            {
+                // counter of drops since socket creation
+                std::uint32_t drops;
+                std::memcpy(&drops, CMSG_DATA(cmsg), sizeof(drops));
+                rxq_ovfl = drops;
+            }
+        }
+    }
+    return static_cast<std::size_t>(ret);
+}
+
+
+/**
+ * @brief Runs server_t<udp, epoll_t> against senders for duration, then drains socket
+ * @return measurements, std::nullopt if server fails to start
+ */
+static std::optional<result_t> run(
+        recv_mode_t mode
+        , std::uint_fast16_t port
+        , unsigned senders
+        , std::size_t size
+        , std::chrono::milliseconds duration)
+{
+    server_t<udp, epoll_t> server{epoll_t{5, 10u}, ipv4{}};
+    std::optional<accepted_sock_ref<udp>> sock;
+    if (!server.start(
+            ADDRESS
+            , port
+            , [&sock](accepted_sock_ref<udp>&& ref)
+            {
+                if (!sock)
+                {
+                    sock.emplace(std::move(ref));
+                }
+            }
+            , [&sock]() { sock.reset(); }))
+    {
+        return std::nullopt;
+    }
+
+    result_t result;
+    std::vector<std::string> buffers(mode == recv_mode_t::BATCH ? BATCH : 1, std::string(MAX_DATAGRAM, '\0'));
+    auto receive = [&]() -> std::size_t
+    {
+        if (!sock)
+        {
+            return 0;
+        }
+        if (mode == recv_mode_t::BATCH)
+        {
+            return recv_batch(sock->native_handle(), buffers, result.rxq_ovfl);
+        }
+        std::size_t received = 0;
+        while (received < BATCH && sock->recv(buffers[0].data(), buffers[0].size()))
+        {
+            ++received;
+        }
+        return received;
+    };
+
+    std::atomic<bool> running{true};
+    std::vector<std::uint64_t> sent(senders, 0);
+    std::vector<std::thread> threads;
+    auto errors_before = rcvbuf_errors();
+    auto cpu_before = thread_cpu();
+#ifdef PROTEI_BENCH_SYSCALLS
+    instrument::syscall_scope syscalls;
+#endif
+    auto start = clock_type::now();
+    for (unsigned i = 0; i < senders; ++i)
+    {
+        threads.emplace_back([&, i]() { sent[i] = blast(port, size, running); });
+    }
+
+    // server socket handle is available after first readable event
+    server.proceed(std::chrono::milliseconds{100});
+    if (sock)
+    {
+        int on = 1;
+        ::setsockopt(sock->native_handle(), SOL_SOCKET, SO_RXQ_OVFL, &on, sizeof(on));
+    }
+    while (clock_type::now() - start < duration)
+    {
+        auto received = receive();
+        result.received += received;
+        if (received == 0)
+        {
+            server.proceed(std::chrono::milliseconds{1});
+        }
+    }
+    running = false;
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+    result.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+
+    // datagrams queued in socket buffer aren't drops
+    for (std::size_t received; (received = receive()) != 0; )
+    {
+        result.received += received;
+    }
+    result.cpu_seconds = thread_cpu() - cpu_before;
+#ifdef PROTEI_BENCH_SYSCALLS
+    auto syscall_stats = syscalls.stats();
+    result.syscalls = syscall_stats.total();
+    result.would_block = syscall_stats.total_blocked();
+#endif
+    result.rcvbuf_errors = rcvbuf_errors() - errors_before;
+    for (auto count: sent)
+    {
+        result.sent += count;
+    }
+    server.stop();
+    return result;
+}
+
+
+/**
+ * @brief Packet rate of server_t<udp, epoll_t> under K blasting sender threads. Compares current per-datagram
+ * recv path with recvmmsg batch receive on the same socket. Drops are counted by SO_RXQ_OVFL (batch mode) and by
+ * Udp RcvbufErrors of /proc/net/snmp, CPU per packet is receiving thread's one divided by received datagrams.
+ * Instrumented bench_udp_pps_syscalls build also counts receiving thread's syscalls per packet, its rates are skewed
+ * by counters.
+ * Usage: bench_udp_pps [senders] [datagram_size] [duration_ms] [port]
+ */
+int main(int argc, char* argv[])
+{
+    unsigned senders = argc > 1 ? static_cast<unsigned>(std::stoul(argv[1])) : 2;
+    std::size_t size = argc > 2 ? std::stoul(argv[2]) : 64;
+    std::chrono::milliseconds duration{argc > 3 ? std::stoul(argv[3]) : 2000};
+    auto port = static_cast<std::uint_fast16_t>(argc > 4 ? std::stoul(argv[4]) : 7901);
+    if (senders == 0 || size == 0 || size > MAX_DATAGRAM)
+    {
+        std::cerr << "senders must be positive, datagram size in [1, " << MAX_DATAGRAM << ']' << std::endl;
+        return 1;
+    }
+
+    std::cout << "senders: " << senders << ", datagram: " << size << " bytes, duration: " << duration.count() << " ms\n"
+              << std::setw(8) << "path" << std::setw(12) << "sent pps" << std::setw(12) << "recv pps"
+              << std::setw(9) << "drop %" << std::setw(10) << "rcvbuf" << std::setw(10) << "rxq_ovfl"
+              << std::setw(12) << "cpu ns/pkt";
+    if (COUNT_SYSCALLS)
+    {
+        std::cout << std::setw(10) << "sys/pkt" << std::setw(10) << "eagain";
+    }
+    std::cout << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    for (auto mode: {recv_mode_t::SINGLE, recv_mode_t::BATCH})
+    {
+        auto result = run(mode, port, senders, size, duration);
+        if (!result || result->received == 0)
+        {
+            std::cerr << "run failed" << std::endl;
+            return 1;
+        }
+        auto lost = result->sent > result->received ? result->sent - result->received : 0;
+        auto received = static_cast<double>(result->received);
+        std::cout << std::setw(8) << (mode == recv_mode_t::SINGLE ? "single" : "batch")
+                  << std::setw(12) << static_cast<double>(result->sent) / result->seconds
+                  << std::setw(12) << received / result->seconds
+                  << std::setw(9) << 100.0 * static_cast<double>(lost) / static_cast<double>(result->sent)
+                  << std::setw(10) << result->rcvbuf_errors
+                  << std::setw(10) << result->rxq_ovfl
+                  << std::setw(12) << result->cpu_seconds * 1e9 / received;
+        if (COUNT_SYSCALLS)
+        {
+            std::cout << std::setw(10) << static_cast<double>(result->syscalls) / received
+                      << std::setw(10) << static_cast<double>(result->would_block) / received;
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
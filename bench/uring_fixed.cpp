@@ -0,0 +1,242 @@
+#include <uring/fixed_io.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+
+using namespace protei;
+
+/**
+ * @brief Measures send + recv pair through connected sockets in one thread, so only per-operation cost is measured
+ * @return nanoseconds per pair, -1 on failure
+ */
+static long measure(std::size_t iterations, std::function<bool()> const& pair)
+{
+    // warm up page tables and caches
+    for (std::size_t i = 0; i < iterations / 10; ++i)
+    {
+        if (!pair())
+        {
+            return -1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        if (!pair())
+        {
+            return -1;
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / iterations);
+}
+
+
+/**
+ * @brief Connected pair of blocking sockets: unix socket pair or loopback tcp connection
+ * @return true for success
+ */
+static bool connected_pair(bool tcp, int (&fds)[2])
+{
+    if (!tcp)
+    {
+        return ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0;
+    }
+
+    int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    bool ok = listener != -1
+              && ::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0
+              && ::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len) == 0
+              && ::listen(listener, 1) == 0
+              && (fds[0] = ::socket(AF_INET, SOCK_STREAM, 0)) != -1
+              && ::connect(fds[0], reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0
+              && (fds[1] = ::accept(listener, nullptr, nullptr)) != -1;
+    if (listener != -1)
+    {
+        ::close(listener);
+    }
+    return ok;
+}
+
+
+/**
+ * @brief Receive exactly n bytes, stream may deliver them by parts
+ */
+static bool recv_all(int fd, char* in, std::size_t n)
+{
+    for (std::size_t received = 0; received < n; )
+    {
+        auto ret = ::recv(fd, in + received, n - received, 0);
+        if (ret <= 0)
+        {
+            return false;
+        }
+        received += static_cast<std::size_t>(ret);
+    }
+    return true;
+}
+
+
+/**
+ * @brief Send and recv through io_uring without registration. Receive is queued before send, as fixed io keeps it
+ * queued, so both paths wait for the same completions
+ */
+static bool uring_pair(uring::uring_t& ring, int sender, int receiver, char* out, char* in, std::size_t size)
+{
+    if (!ring.recv(receiver, in, size, 1) || !ring.send(sender, out, size, 0))
+    {
+        return false;
+    }
+    bool sent = false;
+    std::size_t received = 0;
+    while (!sent || received < size)
+    {
+        auto done = ring.wait();
+        if (!done || done->result <= 0)
+        {
+            return false;
+        }
+        else if (done->user_data == 0)
+        {
+            sent = true;
+            continue;
+        }
+        received += static_cast<std::size_t>(done->result);
+        if (received < size && !ring.recv(receiver, in + received, size - received, 1))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/**
+ * @brief Send and recv through fixed io slots: send is queued, completions of send and of always queued receive are
+ * reaped together
+ */
+static bool fixed_pair(
+        uring::fixed_io& io
+        , uring::fixed_slot& sender
+        , uring::fixed_slot& receiver
+        , char const* out
+        , char* in
+        , std::size_t size)
+{
+    if (sender.send(out, size) != size)
+    {
+        return false;
+    }
+    // zero copy send buffer is reused after notification, so it is awaited too
+    std::size_t received = 0;
+    while (received < size || sender.unsent())
+    {
+        if (!io.reap(std::chrono::milliseconds{100}))
+        {
+            return false;
+        }
+        while (auto got = receiver.recv(in + received, size - received))
+        {
+            if (!*got)
+            {
+                return false;
+            }
+            received += *got;
+        }
+    }
+    return true;
+}
+
+
+/**
+ * @brief Per-operation cost of io_uring send/recv with registered files and fixed buffers against non-registered
+ * io_uring operations and plain syscalls. Fixed buffers are sent with zero copy SEND_ZC through tcp and with
+ * WRITE_FIXED through unix socket, which has no zero copy support.
+ * Usage: bench_uring_fixed [iterations] [message_size]
+ */
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::stoul(argv[1]) : 200000;
+    std::size_t message_size = argc > 2 ? std::stoul(argv[2]) : 64;
+    if (iterations == 0 || message_size == 0)
+    {
+        std::cerr << "iterations and message size must be positive" << std::endl;
+        return 1;
+    }
+
+    std::cout << "message: " << message_size << " bytes, iterations: " << iterations << '\n';
+    std::string out(message_size, 'u');
+    std::string in(message_size, '\0');
+    for (bool tcp: {false, true})
+    {
+        int fds[2];
+        if (!connected_pair(tcp, fds))
+        {
+            std::cerr << "socket pair failed" << std::endl;
+            return 1;
+        }
+
+        auto syscalls = measure(iterations, [&]()
+        {
+            return ::send(fds[0], out.data(), out.size(), 0) == static_cast<ssize_t>(message_size)
+                   && recv_all(fds[1], in.data(), in.size());
+        });
+
+        auto ring = uring::uring_t::create(8);
+        if (!ring)
+        {
+            std::cerr << "io_uring isn't supported" << std::endl;
+            return 1;
+        }
+        auto plain = measure(iterations, [&]()
+        {
+            return uring_pair(*ring, fds[0], fds[1], out.data(), in.data(), message_size);
+        });
+
+        auto registered = [&](bool fixed_buffers) -> long
+        {
+            auto io = uring::fixed_io::create(2, message_size, fixed_buffers);
+            auto sender = io ? io->attach(fds[0]) : std::nullopt;
+            auto receiver = io ? io->attach(fds[1]) : std::nullopt;
+            if (!sender || !receiver)
+            {
+                return -1;
+            }
+            return measure(iterations, [&]()
+            {
+                return fixed_pair(*io, *sender, *receiver, out.data(), in.data(), message_size);
+            });
+        };
+        auto fixed_files = registered(false);
+        auto fixed_buffers = registered(true);
+
+        ::close(fds[0]);
+        ::close(fds[1]);
+        if (syscalls < 0 || plain < 0 || fixed_files < 0 || fixed_buffers < 0)
+        {
+            std::cerr << "transfer failed" << std::endl;
+            return 1;
+        }
+
+        std::cout << (tcp ? "tcp" : "unix") << " send+recv, ns: syscalls " << syscalls
+                  << ", io_uring " << plain
+                  << ", fixed files " << fixed_files
+                  << ", fixed files and buffers " << fixed_buffers << '\n'
+                  << "saving per pair against non-registered io_uring, ns: fixed files " << plain - fixed_files
+                  << ", fixed files and buffers " << plain - fixed_buffers << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+#ifndef PROTEI_TEST_TASK_BLOCK_POOL_H
+#define PROTEI_TEST_TASK_BLOCK_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace protei::buffer
+{
+
+class block_pool;
+
+/**
+ * @brief Refcounted fixed size block. Data follows header in the same slab
+ */
+struct block
+{
+    std::atomic<std::uint32_t> refs;
+    block_pool* pool;
+    block* next_free;
+
+    /**
+     * @return block data
+     */
+    char* data() noexcept
+    {
+        return reinterpret_cast<char*>(this + 1);
+    }
+};
+
+
+/**
+ * @brief Slab allocator of refcounted blocks. Blocks are allocated by slabs and never returned to system until pool
+ * destruction, released blocks are reused. Thread safe.
+ */
+class block_pool
+{
+public:
+    /**
+     * @brief Ctor
+     * @param block_size - data size of block
+     * @param blocks_per_slab - blocks count allocated at once
+     */
+    explicit block_pool(std::size_t block_size = 4096, std::size_t blocks_per_slab = 64);
+
+    block_pool(block_pool const&) = delete;
+    block_pool& operator=(block_pool const&) = delete;
+
+    /**
+     * @brief Dtor. All blocks must be released
+     */
+    ~block_pool();
+
+    /**
+     * @return block with reference count 1
+     */
+    block* acquire();
+
+    /**
+     * @brief Increment block's reference count
+     * @param blk - block
+     */
+    static void retain(block* blk) noexcept;
+
+    /**
+     * @brief Decrement block's reference count, return block to its pool when it drops to zero
+     * @param blk - block
+     */
+    static void release(block* blk) noexcept;
+
+    /**
+     * @return data size of block
+     */
+    std::size_t block_size() const noexcept;
+
+    /**
+     * @return allocated blocks count
+     */
+    std::size_t allocated() const noexcept;
+
+    /**
+     * @return blocks count in free list
+     */
+    std::size_t available() const noexcept;
+
+private:
+    void push_free(block* blk) noexcept;
+
+    std::size_t m_block_size;
+    std::size_t m_stride;
+    std::size_t m_blocks_per_slab;
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<std::byte[]>> m_slabs;
+    block* m_free = nullptr;
+    std::size_t m_available = 0;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_BLOCK_POOL_H
@@ -0,0 +1,140 @@
+#ifndef PROTEI_TEST_TASK_BUFFER_POOL_H
+#define PROTEI_TEST_TASK_BUFFER_POOL_H
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace protei::buffer
+{
+
+class buffer_pool;
+
+/**
+ * @brief Buffer borrowed from buffer_pool, returned to pool on destruction. Move only
+ */
+class pooled_buffer
+{
+public:
+    pooled_buffer() noexcept = default;
+    pooled_buffer(pooled_buffer&& other) noexcept;
+    pooled_buffer& operator=(pooled_buffer&& other) noexcept;
+    ~pooled_buffer();
+
+    /**
+     * @brief Return buffer to pool. Buffer becomes empty
+     */
+    void release() noexcept;
+
+    /**
+     * @return buffer data, nullptr if empty
+     */
+    char* data() const noexcept
+    {
+        return m_data;
+    }
+
+    /**
+     * @return buffer size, size of its size class
+     */
+    std::size_t size() const noexcept;
+
+    /**
+     * @return true if buffer is borrowed
+     */
+    explicit operator bool() const noexcept
+    {
+        return m_data != nullptr;
+    }
+
+private:
+    friend class buffer_pool;
+
+    pooled_buffer(buffer_pool* pool, char* data, unsigned size_class) noexcept;
+
+    buffer_pool* m_pool = nullptr;
+    char* m_data = nullptr;
+    unsigned m_size_class = 0;
+};
+
+
+/**
+ * @brief Slab allocator of receive buffers with power of 2 size classes. Owned by reactor and used from its thread
+ * only, so isn't synchronized. Connections borrow buffers only while they have unconsumed data, idle connections
+ * don't hold memory. Slabs are kept until pool destruction.
+ */
+class buffer_pool
+{
+public:
+    static constexpr std::size_t MIN_BUFFER_SIZE = 256;
+    static constexpr std::size_t MAX_BUFFER_SIZE = 1 << 20;
+    static constexpr std::size_t SIZE_CLASSES = 13;
+
+    /**
+     * @brief Pool statistics
+     */
+    struct stats_t
+    {
+        /// borrowed buffers count and their total size
+        std::size_t in_use = 0;
+        std::size_t in_use_bytes = 0;
+        /// max values of in_use and in_use_bytes since pool creation
+        std::size_t high_water = 0;
+        std::size_t high_water_bytes = 0;
+        /// memory allocated by slabs
+        std::size_t allocated_bytes = 0;
+    };
+
+    /**
+     * @brief Ctor. Doesn't allocate
+     * @param slab_size - memory allocated at once for size class, at least one buffer
+     */
+    explicit buffer_pool(std::size_t slab_size = 64 * 1024) noexcept;
+
+    buffer_pool(buffer_pool const&) = delete;
+    buffer_pool& operator=(buffer_pool const&) = delete;
+
+    /**
+     * @brief Dtor. All buffers must be returned
+     */
+    ~buffer_pool();
+
+    /**
+     * @brief Borrow buffer of the smallest size class fitting size
+     * @param size - required size, must not exceed MAX_BUFFER_SIZE
+     * @return buffer, empty if size is too large
+     */
+    pooled_buffer acquire(std::size_t size);
+
+    /**
+     * @return pool statistics
+     */
+    stats_t const& stats() const noexcept
+    {
+        return m_stats;
+    }
+
+    /**
+     * @param size_class - size class index
+     * @return size of buffers of class
+     */
+    static constexpr std::size_t class_size(unsigned size_class) noexcept
+    {
+        return MIN_BUFFER_SIZE << size_class;
+    }
+
+private:
+    friend class pooled_buffer;
+
+    void release(char* data, unsigned size_class) noexcept;
+
+    std::size_t m_slab_size;
+    std::vector<std::unique_ptr<char[]>> m_slabs;
+    std::array<std::vector<char*>, SIZE_CLASSES> m_free;
+    stats_t m_stats;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_BUFFER_POOL_H
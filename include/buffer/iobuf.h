@@ -0,0 +1,123 @@
+#ifndef PROTEI_TEST_TASK_IOBUF_H
+#define PROTEI_TEST_TASK_IOBUF_H
+
+#include <buffer/block_pool.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace protei::buffer
+{
+
+/**
+ * @brief Contiguous memory range of gather send. Layout compatible with iovec
+ */
+struct io_slice
+{
+    void const* data;
+    std::size_t size;
+};
+
+
+/**
+ * @brief Chain of refcounted block ranges. Copying, slicing, prepending and appending other chain share blocks
+ * instead of copying data, blocks return to pool when the last chain referencing them is destroyed. Socket copies
+ * data on send, so chain may be destroyed right after send returns.
+ */
+class iobuf
+{
+public:
+    /**
+     * @brief Ctor
+     * @param pool - pool of blocks for appended data, must outlive chain
+     */
+    explicit iobuf(block_pool& pool) noexcept;
+
+    iobuf(iobuf const& other) noexcept;
+    iobuf& operator=(iobuf const& other) noexcept;
+    iobuf(iobuf&& other) noexcept;
+    iobuf& operator=(iobuf&& other) noexcept;
+    ~iobuf();
+
+    /**
+     * @brief Copy data to the end of chain. Free space of the last block is reused if block isn't shared
+     * @param data - data
+     * @param n - data size
+     */
+    void append(void const* data, std::size_t n);
+
+    /**
+     * @brief Share other chain's blocks at the end of chain
+     * @param other - chain
+     */
+    void append(iobuf const& other);
+
+    /**
+     * @brief Copy data to the beginning of chain, such as protocol header
+     * @param data - data
+     * @param n - data size, must not exceed block size
+     */
+    void prepend(void const* data, std::size_t n);
+
+    /**
+     * @brief Get range of chain sharing its blocks
+     * @param offset - range offset
+     * @param n - range size, is cut by chain end
+     * @return chain range
+     */
+    iobuf slice(std::size_t offset, std::size_t n) const;
+
+    /**
+     * @brief Remove bytes from the beginning of chain, e.g. sent by partial send
+     * @param n - bytes count
+     */
+    void consume(std::size_t n) noexcept;
+
+    /**
+     * @brief Fill gather send slices
+     * @param slices - slices storage
+     * @param max_slices - storage size
+     * @return filled slices count
+     */
+    std::size_t to_slices(io_slice* slices, std::size_t max_slices) const noexcept;
+
+    /**
+     * @brief Copy chain data to contiguous buffer
+     * @param out - buffer, at least size() bytes
+     */
+    void copy_to(void* out) const noexcept;
+
+    /**
+     * @return data size
+     */
+    std::size_t size() const noexcept;
+
+    /**
+     * @return true if chain has no data
+     */
+    bool empty() const noexcept;
+
+    /**
+     * @return count of block ranges
+     */
+    std::size_t segments() const noexcept;
+
+private:
+    struct segment
+    {
+        block* blk;
+        std::uint32_t offset;
+        std::uint32_t size;
+    };
+
+    void release() noexcept;
+
+    block_pool* m_pool;
+    std::vector<segment> m_segments;
+    std::size_t m_size = 0;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_IOBUF_H
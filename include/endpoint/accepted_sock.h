@@ -2,18 +2,20 @@
 #define PROTEI_TEST_TASK_ACCEPTED_SOCK_H
 
 #include <endpoint/send_recv_i.h>
+#include <metrics/endpoint_metrics.h>
 #include <socket/socket.h>
+#include <uring/fixed_io.h>
 #include <utils/mbind.h>
 
 namespace protei::endpoint
 {
 
 /**
- * @brief TCP accepted socket, created from listening server socket.
+ * @brief Connection based protocol accepted socket, created from listening server socket.
  * @tparam Proto - protocol type
  */
 template <typename Proto>
-class accepted_sock : public send_recv_i
+class accepted_sock : public basic_send_recv_i<sock::proto_address_t<Proto>>
 {
     static_assert(!Proto::is_connectionless);
 public:
@@ -21,10 +23,15 @@ public:
      * @brief Ctor
      * @param rem - remote address
      * @param sock - accepted socket
+     * @param metrics - metrics of server, traffic is accounted to
      */
-    accepted_sock(sock::in_address_port_t rem, sock::active_socket_t<Proto>&& sock) noexcept
+    accepted_sock(
+            sock::proto_address_t<Proto> rem
+            , sock::active_socket_t<Proto>&& sock
+            , metrics::metrics_ref metrics = {}) noexcept
         : m_sock{std::move(sock)}
         , m_remote{rem}
+        , m_metrics{std::move(metrics)}
     {}
 
     /**
@@ -34,6 +41,8 @@ public:
     accepted_sock(accepted_sock&& other) noexcept
         : m_sock{std::move(other.m_sock)}
         , m_remote{std::move(other.m_remote)}
+        , m_fixed{std::move(other.m_fixed)}
+        , m_metrics{std::move(other.m_metrics)}
     {}
 
     /**
@@ -44,8 +53,11 @@ public:
     {
         if (this != &other)
         {
+            // registered file keeps socket open, so slot is released first
+            m_fixed = std::move(other.m_fixed);
             m_sock = std::move(other.m_sock);
             m_remote = std::move(other.m_remote);
+            m_metrics = std::move(other.m_metrics);
         }
         return *this;
     }
@@ -59,20 +71,60 @@ public:
         return m_sock.native_handle();
     }
 
+    /**
+     * @brief Account traffic to metrics of other server, set by server on accept and on attachment
+     * @param metrics - server's metrics
+     */
+    void set_metrics(metrics::metrics_ref metrics) noexcept
+    {
+        m_metrics = std::move(metrics);
+    }
+
+    /**
+     * @brief Serve socket through io_uring fixed io slot: send queues data to slot's send buffer, recv takes data
+     * received by slot, receive timestamps aren't read. Set by server with fixed io on accept
+     * @param slot - slot socket is attached to
+     */
+    void set_fixed_slot(uring::fixed_slot&& slot) noexcept
+    {
+        m_fixed = std::move(slot);
+    }
+
 private:
     std::optional<std::size_t> send_impl(void* buffer, std::size_t n) override
     {
-        return m_sock.send(buffer, n, 0);
+        return m_metrics.sent(m_fixed ? m_fixed->send(buffer, n) : m_sock.send(buffer, n, 0), m_sock);
     }
 
-    std::optional<std::pair<sock::in_address_port_t, std::size_t>> recv_impl(void* buffer, std::size_t n) override
+    std::optional<std::size_t> send_chain_impl(buffer::iobuf const& buf) override
     {
-        return utils::mbind(
-                m_sock.receive(buffer, n, 0)
-                , [this](std::size_t recv) -> std::optional<std::pair<sock::in_address_port_t, std::size_t>>
-                {
-                    return {{m_remote, recv}};
-                });
+        return m_metrics.sent(m_fixed ? m_fixed->send(buf) : m_sock.send(buf, 0), m_sock);
+    }
+
+    std::optional<std::pair<sock::proto_address_t<Proto>, std::size_t>> recv_impl(void* buffer, std::size_t n) override
+    {
+        auto received = m_fixed ? m_fixed->recv(buffer, n) : m_sock.receive(buffer, n, 0);
+        return with_remote(m_metrics.received(std::move(received), m_sock));
+    }
+
+    std::optional<std::pair<sock::proto_address_t<Proto>, std::size_t>> recv_timestamped_impl(
+            void* buffer, std::size_t n, std::optional<sock::timestamp_t>& ts) override
+    {
+        if constexpr (sock::is_local_v<Proto>)
+        {
+            ts.reset();
+            return recv_impl(buffer, n);
+        }
+        else if (m_fixed)
+        {
+            // slot receives without ancillary data
+            ts.reset();
+            return recv_impl(buffer, n);
+        }
+        else
+        {
+            return with_remote(m_metrics.received(m_sock.receive_timestamped(buffer, n, 0, ts), m_sock));
+        }
     }
 
     bool finished_send_impl() const override
@@ -85,8 +137,27 @@ private:
         return m_sock.again() || m_sock.would_block();
     }
 
+    int trace_fd() const noexcept override
+    {
+        return native_handle();
+    }
+
+    std::optional<std::pair<sock::proto_address_t<Proto>, std::size_t>> with_remote(
+            std::optional<std::size_t> received) const
+    {
+        return utils::mbind(
+                received
+                , [this](std::size_t recv) -> std::optional<std::pair<sock::proto_address_t<Proto>, std::size_t>>
+                {
+                    return {{m_remote, recv}};
+                });
+    }
+
     sock::active_socket_t<Proto> m_sock;
-    sock::in_address_port_t m_remote;
+    sock::proto_address_t<Proto> m_remote;
+    /// destroyed before socket
+    std::optional<uring::fixed_slot> m_fixed;
+    metrics::metrics_ref m_metrics;
 };
 
 }
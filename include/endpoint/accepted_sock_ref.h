@@ -3,6 +3,9 @@
 
 #include <endpoint/send_recv_i.h>
 #include <endpoint/proto_to_sum_of_states.h>
+#include <metrics/endpoint_metrics.h>
+#include <socket/native_address.h>
+#include <utils/mbind.h>
 
 namespace protei::endpoint
 {
@@ -12,16 +15,19 @@ namespace protei::endpoint
  * @tparam Proto - protocol type
  */
 template <typename Proto>
-class accepted_sock_ref : public send_recv_i
+class accepted_sock_ref : public basic_send_recv_i<sock::proto_address_t<Proto>>
 {
     static_assert(Proto::is_connectionless);
+    using address_t = sock::proto_address_t<Proto>;
 public:
     /**
      * @brief Ctor
      * @param sock - socket
+     * @param metrics - metrics of server, traffic is accounted to
      */
-    explicit accepted_sock_ref(sum_of_server_states_t<Proto>& sock) noexcept
+    explicit accepted_sock_ref(sum_of_server_states_t<Proto>& sock, metrics::metrics_ref metrics = {}) noexcept
         : m_sock{&sock}
+        , m_metrics{std::move(metrics)}
     {}
 
     /**
@@ -31,6 +37,7 @@ public:
     accepted_sock_ref(accepted_sock_ref&& other) noexcept
         : m_sock{std::exchange(other.m_sock, nullptr)}
         , m_remote{std::move(other.m_remote)}
+        , m_metrics{std::move(other.m_metrics)}
     {}
 
     /**
@@ -43,17 +50,19 @@ public:
         {
             m_sock = std::move(other.m_sock);
             m_remote = std::move(other.m_remote);
+            m_metrics = std::move(other.m_metrics);
         }
         return *this;
     }
 
     /**
      * @brief Get socket's native handle (file descriptor)
-     * @return file descriptor
+     * @return file descriptor, -1 if socket isn't active
      */
     int native_handle() const noexcept
     {
-        return m_sock->native_handle();
+        auto* sock = std::get_if<sock::active_socket_t<Proto>>(m_sock);
+        return sock ? sock->native_handle() : -1;
     }
 
 private:
@@ -61,9 +70,9 @@ private:
     {
         return call_if_active([&](auto& sock) -> std::optional<std::size_t>
         {
-            if (m_remote)
+            if (!m_remote.empty())
             {
-                return sock.send(*m_remote, buffer, n, 0);
+                return m_metrics.sent(sock.send(m_remote, buffer, n, 0), sock);
             }
             else
             {
@@ -72,19 +81,47 @@ private:
         });
     }
 
-    std::optional<std::pair<sock::in_address_port_t, std::size_t>> recv_impl(void* buffer, std::size_t n) override
+    std::optional<std::size_t> send_chain_impl(buffer::iobuf const& buf) override
     {
-        return call_if_active([&](auto& sock)
+        return call_if_active([&](auto& sock) -> std::optional<std::size_t>
         {
-            auto recv = sock.receive(buffer, n, 0);
-            if (recv)
+            if (!m_remote.empty())
             {
-                m_remote = recv->first;
+                return m_metrics.sent(sock.send(m_remote, buf, 0), sock);
             }
-            return recv;
+            else
+            {
+                return std::nullopt;
+            }
+        });
+    }
+
+    std::optional<std::pair<address_t, std::size_t>> recv_impl(void* buffer, std::size_t n) override
+    {
+        return call_if_active([&](auto& sock)
+        {
+            // remote is kept in native form, so replies are sent without address conversion
+            return with_remote(m_metrics.received(sock.receive(buffer, n, 0, m_remote), sock));
         });
     }
 
+    std::optional<std::pair<address_t, std::size_t>> recv_timestamped_impl(
+            void* buffer, std::size_t n, std::optional<sock::timestamp_t>& ts) override
+    {
+        ts.reset();
+        if constexpr (sock::is_local_v<Proto>)
+        {
+            return recv_impl(buffer, n);
+        }
+        else
+        {
+            return call_if_active([&](auto& sock)
+            {
+                return with_remote(m_metrics.received(sock.receive_timestamped(buffer, n, 0, m_remote, ts), sock));
+            });
+        }
+    }
+
     bool finished_send_impl() const override
     {
         return call_if_active([](auto const& sock) { return sock.again() || sock.would_block(); });
@@ -95,6 +132,33 @@ private:
         return call_if_active([](auto const& sock) { return sock.again() || sock.would_block(); });
     }
 
+    int trace_fd() const noexcept override
+    {
+        return native_handle();
+    }
+
+    std::optional<std::pair<address_t, std::size_t>> with_remote(std::optional<std::size_t> received) const
+    {
+        return utils::mbind(
+                received
+                , [this](std::size_t recv) -> std::optional<std::pair<address_t, std::size_t>>
+                {
+                    if constexpr (sock::is_native_address_v<Proto>)
+                    {
+                        return {{ m_remote, recv }};
+                    }
+                    else
+                    {
+                        return utils::mbind(
+                                m_remote.to_in_address_port()
+                                , [recv](address_t remote) -> std::optional<std::pair<address_t, std::size_t>>
+                                {
+                                    return {{ remote, recv }};
+                                });
+                    }
+                });
+    }
+
     template <typename Lambda>
     auto call_if_active(Lambda&& lambda)
     {
@@ -122,7 +186,8 @@ private:
     }
 
     sum_of_server_states_t<Proto>* m_sock;
-    std::optional<sock::in_address_port_t> m_remote;
+    sock::proto_native_address_t<Proto> m_remote;
+    metrics::metrics_ref m_metrics;
 };
 
 }
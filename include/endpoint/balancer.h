@@ -0,0 +1,72 @@
+#ifndef PROTEI_TEST_TASK_BALANCER_H
+#define PROTEI_TEST_TASK_BALANCER_H
+
+#include <endpoint/accepted_sock.h>
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace protei::endpoint
+{
+
+/**
+ * @brief Balancing policy, that moves connections from reactor to the least loaded one if loads differ by more
+ * than threshold
+ */
+struct least_loaded_balancer
+{
+    /**
+     * @param loads - reactors' loads
+     * @param source - index of reactor connection is migrated from
+     * @return index of destination reactor, std::nullopt if connection should stay on source
+     */
+    std::optional<std::size_t> operator()(std::vector<std::size_t> const& loads, std::size_t source) const noexcept;
+
+    /// minimal loads difference to migrate connection
+    std::size_t threshold = 1;
+};
+
+
+/**
+ * @brief Migrate connection to other reactor if balancing policy decides so. Must be called from thread proceeding
+ * source reactor.
+ * @tparam Server - server type (server_t)
+ * @tparam Proto - protocol type
+ * @tparam OnAttached - callable with accepted_sock<Proto>&&
+ * @tparam Balancer - balancing policy, callable with reactors' loads and source index
+ * @param reactors - servers proceeded by different threads
+ * @param source - index of reactor serving connection
+ * @param sock - connection, is moved from only if migrated
+ * @param on_attached - callback to be called by destination reactor, should capture connection's pending buffers
+ * and handlers
+ * @param balancer - balancing policy
+ * @return true if connection was migrated
+ */
+template <typename Server, typename Proto, typename OnAttached, typename Balancer = least_loaded_balancer>
+bool migrate(
+        std::vector<Server*> const& reactors
+        , std::size_t source
+        , accepted_sock<Proto>& sock
+        , OnAttached&& on_attached
+        , Balancer const& balancer = {})
+{
+    std::vector<std::size_t> loads;
+    loads.reserve(reactors.size());
+    for (auto const* reactor: reactors)
+    {
+        loads.push_back(reactor->load());
+    }
+
+    auto destination = balancer(loads, source);
+    if (!destination || *destination == source || !reactors[source]->detach(sock.native_handle()))
+    {
+        return false;
+    }
+    reactors[*destination]->attach(std::move(sock), std::forward<OnAttached>(on_attached));
+    return true;
+}
+
+}
+
+#endif //PROTEI_TEST_TASK_BALANCER_H
@@ -3,8 +3,12 @@
 
 #include <endpoint/endpoint.h>
 #include <endpoint/client_i.h>
+#include <endpoint/timestamping.h>
+#include <uring/fixed_io.h>
 #include <utils/address_from_string.h>
 
+#include <memory>
+
 
 namespace protei::endpoint
 {
@@ -16,10 +20,12 @@ namespace protei::endpoint
  * @tparam PollTraits - poll's static adapter
  */
 template <typename Proto, typename Poll, typename PollTraits = poll_traits<Poll>>
-class client_t : private endpoint_t<sum_of_client_states_t, Proto, Poll, PollTraits>, public client_i
+class client_t : private endpoint_t<sum_of_client_states_t, Proto, Poll, PollTraits>, public basic_client_i<sock::proto_address_t<Proto>>
 {
 public:
     using endpoint_t<sum_of_client_states_t, Proto, Poll, PollTraits>::endpoint_t;
+    /// receive buffers pool of client's reactor
+    using endpoint_t<sum_of_client_states_t, Proto, Poll, PollTraits>::buffers;
 
     ~client_t() override;
 
@@ -39,7 +45,7 @@ public:
     /**
      * @brief Start client. Creates binded socket internally
      * @param local_address - local address to bind to socket
-     * @param local_port - local port to bind to socket
+     * @param local_port - local port to bind to socket, ignored by unix domain protocols
      * @return true for success
      */
     bool start(std::string const& local_address, std::uint_fast16_t local_port) noexcept;
@@ -52,7 +58,7 @@ public:
     /**
      * @brief Connect client to remote
      * @param remote_address - remote address
-     * @param remote_port - remote port
+     * @param remote_port - remote port, ignored by unix domain protocols
      * @param on_connect - callback to be called on connection establishment
      * @param on_read_ready - callback to be called on data reception
      * @param on_disconnect - callback to be called on disconnection
@@ -65,21 +71,68 @@ public:
             , std::function<void()> on_read_ready
             , std::function<void()> on_disconnect) noexcept;
 
+    /**
+     * @brief Configure outgoing multicast datagrams. Connectionless protocols only. Client must be started.
+     * @param ttl - time to live (hop limit for IPv6)
+     * @param loop - deliver sent datagrams to local receivers
+     * @param iface - outgoing interface address (IPv4 only), empty string for default interface
+     * @return true for success
+     */
+    bool set_multicast(unsigned ttl, bool loop, std::string const& iface = {}) noexcept;
+
+    /**
+     * @brief Enable kernel software timestamps (SO_TIMESTAMPING). Internet protocols only. Client must be connected,
+     * settings are dropped on stop. RX stamps are read by recv_timestamped. TX stamps are read by client on error
+     * readiness and passed to on_tx, on_disconnect is called only if socket has pending error besides them
+     * @param rx - timestamp received data
+     * @param on_tx - TX timestamps handler, TX timestamping is off if empty
+     * @return true for success
+     */
+    bool set_timestamping(bool rx, on_tx_timestamp_t on_tx = nullptr) noexcept;
+
+    /**
+     * @brief Serve connected client through io_uring completion based path (uring::fixed_io): send queues data to
+     * registered buffer, recv takes data received by always queued receive, on_read_ready is called when it
+     * completes. Operations queued between proceeds are submitted in one batch by proceed, ring's descriptor is
+     * polled by client. Connection based protocols only. Dropped on stop
+     * @param buffer_size - receive and send buffer size
+     * @param fixed_buffers - register buffers, so send is zero copy
+     * @return true for success, false if client isn't connected, path is already set or io_uring isn't supported
+     */
+    bool set_fixed_io(std::size_t buffer_size, bool fixed_buffers = false) noexcept;
+
+    /**
+     * @brief Get client metrics: traffic, disconnects and event loop timings. Thread safe. Zeroed if compiled with
+     * PROTEI_NO_METRICS
+     * @return current metrics
+     */
+    metrics::metrics_snapshot metrics() const noexcept;
+
 private:
     std::optional<std::size_t> send_impl(void* buffer, std::size_t n) override;
-    std::optional<std::pair<sock::in_address_port_t, std::size_t>> recv_impl(void* buffer, std::size_t n) override;
+    std::optional<std::size_t> send_chain_impl(buffer::iobuf const& buf) override;
+    std::optional<std::pair<sock::proto_address_t<Proto>, std::size_t>> recv_impl(void* buffer, std::size_t n) override;
+    std::optional<std::pair<sock::proto_address_t<Proto>, std::size_t>> recv_timestamped_impl(
+            void* buffer, std::size_t n, std::optional<sock::timestamp_t>& ts) override;
     bool finished_recv_impl() const override;
     bool finished_send_impl() const override;
+    int trace_fd() const noexcept override;
 
     bool again_or_would_block() const;
 
     void register_cbs();
     void unregister_cbs();
+    bool failed(int fd) noexcept;
 
-    std::optional<sock::in_address_port_t> m_remote;
+    std::optional<sock::proto_address_t<Proto>> m_remote;
+    std::unique_ptr<uring::fixed_io> m_fixed_io;
+    /// destroyed before fixed io and socket
+    std::optional<uring::fixed_slot> m_fixed;
+    metrics::metrics_ref m_account{this->m_metrics};
     std::function<void()> m_on_connect;
     std::function<void()> m_on_read_ready;
     std::function<void()> m_on_disconnect;
+    on_tx_timestamp_t m_on_tx;
     mutable std::mutex m_mutex;
 };
 
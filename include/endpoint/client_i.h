@@ -9,10 +9,14 @@ namespace protei::endpoint
 
 /**
  * @brief Client interface
+ * @tparam Address - remote address type
  */
-struct client_i : proceed_i, send_recv_i
+template <typename Address>
+struct basic_client_i : proceed_i, basic_send_recv_i<Address>
 {};
 
+using client_i = basic_client_i<sock::in_address_port_t>;
+
 }
 
 #endif //PROTEI_TEST_TASK_CLIENT_I_H
@@ -4,11 +4,12 @@
 #include <endpoint/event_observer.h>
 #include <endpoint/proto_to_sum_of_states.h>
 #include <utils/lambda_visitor.h>
+#include <buffer/buffer_pool.h>
 
 namespace protei::endpoint
 {
 
-namespace
+namespace detail
 {
 
 /**
@@ -31,7 +32,7 @@ struct poll_holder_t
  * @tparam PollTraits - poll static adapter
  */
 template <template <typename> typename States, typename Proto, typename Poll, typename PollTraits = poll_traits<Poll>>
-struct endpoint_t : public poll_holder_t<Poll>, public event_observer_t<Poll*>
+struct endpoint_t : public detail::poll_holder_t<Poll>, public event_observer_t<Poll*>
 {
     /**
      * @brief Ctor
@@ -58,6 +59,8 @@ struct endpoint_t : public poll_holder_t<Poll>, public event_observer_t<Poll*>
 
     int af;
     States<Proto> state;
+    /// receive buffers of connections served by endpoint's poll
+    buffer::buffer_pool buffers;
 };
 
 }
@@ -3,6 +3,7 @@
 
 #include <endpoint/poll_traits.h>
 #include <endpoint/proceed_exception.h>
+#include <metrics/endpoint_metrics.h>
 #include <utils/enum_op.h>
 
 #include <map>
@@ -56,6 +57,10 @@ public:
      */
     bool proceed(std::chrono::milliseconds timeout);
 
+protected:
+    /// event loop and traffic metrics of endpoint, shared with accepted sockets
+    metrics::shared_metrics m_metrics{metrics::make_metrics()};
+
 private:
     std::exception_ptr handle_unhandled(std::vector<poll_event::event> const& events);
     std::pair<bool, std::exception_ptr> handle_event(poll_event::event event);
@@ -0,0 +1,53 @@
+#ifndef PROTEI_TEST_TASK_HANDOFF_H
+#define PROTEI_TEST_TASK_HANDOFF_H
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace protei::endpoint
+{
+
+/**
+ * @brief Descriptors received on hot restart handoff. Owned by receiver
+ */
+struct handoff_fds
+{
+    int listening;
+    std::vector<int> accepted;
+};
+
+
+/**
+ * @brief Pass listening socket and accepted sockets to new process over unix socket (SCM_RIGHTS).
+ * Blocks until new process acknowledges adoption. Sender still owns passed descriptors.
+ * @param address - unix socket address new process receives handoff on
+ * @param listening_fd - listening socket
+ * @param accepted_fds - accepted sockets
+ * @param timeout - time to wait for new process
+ * @return true if new process adopted descriptors
+ */
+bool send_handoff(
+        std::string const& address
+        , int listening_fd
+        , std::vector<int> const& accepted_fds
+        , std::chrono::milliseconds timeout) noexcept;
+
+/**
+ * @brief Receive descriptors passed by send_handoff. Blocks until old process connects and passes descriptors
+ * @param address - unix socket address to receive handoff on
+ * @param timeout - time to wait for old process
+ * @return received descriptors
+ */
+std::optional<handoff_fds> receive_handoff(std::string const& address, std::chrono::milliseconds timeout) noexcept;
+
+/**
+ * @brief Close received descriptors, that can't be adopted
+ * @param fds - received descriptors
+ */
+void close_handoff(handoff_fds const& fds) noexcept;
+
+}
+
+#endif //PROTEI_TEST_TASK_HANDOFF_H
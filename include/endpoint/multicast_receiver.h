@@ -0,0 +1,71 @@
+#ifndef PROTEI_TEST_TASK_MULTICAST_RECEIVER_H
+#define PROTEI_TEST_TASK_MULTICAST_RECEIVER_H
+
+#include <endpoint/server.h>
+
+#include <vector>
+
+namespace protei::endpoint
+{
+
+/**
+ * @brief Multicast receiver endpoint. Connectionless server, which socket is binded to wildcard address and joined
+ * to several multicast groups.
+ * @tparam Proto - protocol type
+ * @tparam Poll - poll type
+ * @tparam PollTraits - poll's static adapter
+ */
+template <typename Proto, typename Poll, typename PollTraits = poll_traits<Poll>>
+class multicast_receiver_t : public server_t<Proto, Poll, PollTraits>
+{
+    static_assert(Proto::is_connectionless);
+public:
+    using server_t<Proto, Poll, PollTraits>::server_t;
+    using server_t<Proto, Poll, PollTraits>::start;
+
+    /**
+     * @brief Start receiver. Socket allows address reuse, so several receivers on host can share port.
+     * @param port - local port to bind to socket
+     * @param groups - multicast groups addresses to join
+     * @param iface - local interface address (IPv4 only), empty string for default interface
+     * @param on_conn - callback to be called on incoming datagrams
+     * @param on_close - callback to be called on termination events
+     * @return true for success, if any group can't be joined receiver is stopped
+     */
+    bool start(
+            std::uint_fast16_t port
+            , std::vector<std::string> const& groups
+            , std::string const& iface
+            , std::function<void(accepted_sock_ref<Proto>&&)> on_conn
+            , std::function<void()> on_close)
+    {
+        // Type erasure
+        bool started = this->start_impl(
+                this->any_address()
+                , port
+                , [on_conn = std::move(on_conn)](basic_send_recv_i<sock::proto_address_t<Proto>>&& sock)
+                {
+                    on_conn(static_cast<accepted_sock_ref<Proto>&&>(sock));
+                }
+                , [on_close = std::move(on_close)](int) { on_close(); }
+                , true);
+        if (!started)
+        {
+            return false;
+        }
+
+        for (auto const& group: groups)
+        {
+            if (!this->join_group(group, iface))
+            {
+                this->stop();
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_MULTICAST_RECEIVER_H
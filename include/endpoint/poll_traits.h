@@ -6,12 +6,27 @@
 #include <utils/lambda_visitor.h>
 
 #include <memory>
+#include <type_traits>
 #include <vector>
 #include <chrono>
 
 namespace protei::endpoint
 {
 
+/**
+ * @brief Checks if poll appends proceeded events to caller's vector, so caller can reuse its capacity
+ */
+template <typename Poll, typename = void>
+struct has_appending_proceed : std::false_type
+{};
+
+template <typename Poll>
+struct has_appending_proceed<Poll, std::void_t<decltype(std::declval<Poll&>().proceed(
+        std::declval<std::chrono::milliseconds>(), std::declval<std::vector<poll_event::event>&>()))>>
+    : std::true_type
+{};
+
+
 /**
  * @brief Poll static adapter
  * @tparam Poll - poll type
@@ -25,12 +40,35 @@ struct poll_traits
         return poll.proceed(timeout);
     }
 
+    /**
+     * @brief Append proceeded events. Doesn't allocate if poll supports appending and events has enough capacity
+     */
+    static std::size_t proceed(Poll& poll, std::chrono::milliseconds timeout, std::vector<poll_event::event>& events)
+    {
+        if constexpr (has_appending_proceed<Poll>::value)
+        {
+            return poll.proceed(timeout, events);
+        }
+        else
+        {
+            auto proceeded = poll.proceed(timeout);
+            events.insert(events.end(), proceeded.begin(), proceeded.end());
+            return proceeded.size();
+        }
+    }
+
     static bool add_socket(Poll& poll, int sock_fd, sock::sock_op op)
             noexcept(noexcept(poll.add_socket(sock_fd, op)))
     {
         return poll.add_socket(sock_fd, op);
     }
 
+    static bool add_socket(Poll& poll, int sock_fd, sock::sock_op op, bool exclusive)
+            noexcept(noexcept(poll.add_socket(sock_fd, op, exclusive)))
+    {
+        return poll.add_socket(sock_fd, op, exclusive);
+    }
+
     static bool mod_socket(Poll& poll, int sock_fd, sock::sock_op op)
             noexcept(noexcept(poll.mod_socket(sock_fd, op)))
     {
@@ -54,12 +92,26 @@ struct poll_traits<std::unique_ptr<Poll>>
         return poll_traits<Poll>::proceed(*poll, timeout);
     }
 
+    static std::size_t proceed(
+            std::unique_ptr<Poll>& poll
+            , std::chrono::milliseconds timeout
+            , std::vector<poll_event::event>& events)
+    {
+        return poll_traits<Poll>::proceed(*poll, timeout, events);
+    }
+
     static bool add_socket(std::unique_ptr<Poll>& poll, int sock_fd, sock::sock_op op)
             noexcept(noexcept(poll_traits<Poll>::add_socket(*poll, sock_fd, op)))
     {
         return poll_traits<Poll>::add_socket(*poll, sock_fd, op);
     }
 
+    static bool add_socket(std::unique_ptr<Poll>& poll, int sock_fd, sock::sock_op op, bool exclusive)
+            noexcept(noexcept(poll_traits<Poll>::add_socket(*poll, sock_fd, op, exclusive)))
+    {
+        return poll_traits<Poll>::add_socket(*poll, sock_fd, op, exclusive);
+    }
+
     static bool mod_socket(std::unique_ptr<Poll>& poll, int sock_fd, sock::sock_op op)
             noexcept(noexcept(poll_traits<Poll>::mod_socket(*poll, sock_fd, op)))
     {
@@ -83,12 +135,26 @@ struct poll_traits<std::shared_ptr<Poll>>
         return poll_traits<Poll>::proceed(*poll, timeout);
     }
 
+    static std::size_t proceed(
+            std::shared_ptr<Poll>& poll
+            , std::chrono::milliseconds timeout
+            , std::vector<poll_event::event>& events)
+    {
+        return poll_traits<Poll>::proceed(*poll, timeout, events);
+    }
+
     static bool add_socket(std::shared_ptr<Poll>& poll, int sock_fd, sock::sock_op op)
             noexcept(noexcept(poll_traits<Poll>::add_socket(*poll, sock_fd, op)))
     {
         return poll_traits<Poll>::add_socket(*poll, sock_fd, op);
     }
 
+    static bool add_socket(std::shared_ptr<Poll>& poll, int sock_fd, sock::sock_op op, bool exclusive)
+            noexcept(noexcept(poll_traits<Poll>::add_socket(*poll, sock_fd, op, exclusive)))
+    {
+        return poll_traits<Poll>::add_socket(*poll, sock_fd, op, exclusive);
+    }
+
     static bool mod_socket(std::shared_ptr<Poll>& poll, int sock_fd, sock::sock_op op)
             noexcept(noexcept(poll_traits<Poll>::mod_socket(*poll, sock_fd, op)))
     {
@@ -112,12 +178,23 @@ struct poll_traits<Poll*>
         return poll_traits<Poll>::proceed(*poll, timeout);
     }
 
+    static std::size_t proceed(Poll* poll, std::chrono::milliseconds timeout, std::vector<poll_event::event>& events)
+    {
+        return poll_traits<Poll>::proceed(*poll, timeout, events);
+    }
+
     static bool add_socket(Poll* poll, int sock_fd, sock::sock_op op)
             noexcept(noexcept(poll_traits<Poll>::add_socket(*poll, sock_fd, op)))
     {
         return poll_traits<Poll>::add_socket(*poll, sock_fd, op);
     }
 
+    static bool add_socket(Poll* poll, int sock_fd, sock::sock_op op, bool exclusive)
+            noexcept(noexcept(poll_traits<Poll>::add_socket(*poll, sock_fd, op, exclusive)))
+    {
+        return poll_traits<Poll>::add_socket(*poll, sock_fd, op, exclusive);
+    }
+
     static bool mod_socket(Poll* poll, int sock_fd, sock::sock_op op)
             noexcept(noexcept(poll_traits<Poll>::mod_socket(*poll, sock_fd, op)))
     {
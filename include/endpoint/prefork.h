@@ -0,0 +1,72 @@
+#ifndef PROTEI_TEST_TASK_PREFORK_H
+#define PROTEI_TEST_TASK_PREFORK_H
+
+#include <csignal>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace protei::endpoint
+{
+
+/**
+ * @brief Prefork workers sharing one listening socket. Each worker registers the socket in its own poll with
+ * exclusive wake up (server_t::start(listening_fd, ..., true)), so incoming connection wakes up one worker only.
+ */
+class prefork_t
+{
+public:
+    /**
+     * @brief Worker entry point, called in forked process. Returned value is worker's exit code
+     * @param listening_fd - worker's copy of listening socket, owned by worker
+     * @param index - worker index
+     */
+    using worker_main_t = std::function<int(int listening_fd, unsigned index)>;
+
+    /**
+     * @brief Fork workers. Master keeps its own listening socket, it may be closed after start
+     * @param listening_fd - listening socket
+     * @param workers - workers count
+     * @param worker_main - worker entry point
+     * @return prefork_t instance if all workers are forked, already forked workers are killed otherwise
+     */
+    static std::optional<prefork_t> start(int listening_fd, unsigned workers, worker_main_t const& worker_main) noexcept;
+
+    prefork_t(prefork_t const&) = delete;
+    prefork_t& operator=(prefork_t const&) = delete;
+
+    prefork_t(prefork_t&&) noexcept = default;
+    prefork_t& operator=(prefork_t&&) noexcept = default;
+
+    /**
+     * @brief Kills and waits running workers
+     */
+    ~prefork_t();
+
+    /**
+     * @brief Send signal to all running workers
+     * @param signal - signal number
+     * @return true if signal is sent to all running workers
+     */
+    bool stop(int signal = SIGTERM) noexcept;
+
+    /**
+     * @brief Wait all workers termination
+     * @return true if all workers exited with zero code
+     */
+    bool wait() noexcept;
+
+    /**
+     * @return process ids of running workers
+     */
+    std::vector<int> const& workers() const noexcept;
+
+private:
+    prefork_t() noexcept = default;
+
+    std::vector<int> m_workers;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_PREFORK_H
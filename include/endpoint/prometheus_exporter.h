@@ -0,0 +1,113 @@
+#ifndef PROTEI_TEST_TASK_PROMETHEUS_EXPORTER_H
+#define PROTEI_TEST_TASK_PROMETHEUS_EXPORTER_H
+
+#include <endpoint/server.h>
+#include <epoll/epoll.h>
+#include <metrics/endpoint_metrics.h>
+
+#include <array>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace protei::endpoint
+{
+
+/**
+ * @brief Minimal HTTP/1.1 responder serving endpoint metrics at /metrics in Prometheus text format. It is
+ * server_t<tcp, epoll_t> proceeded by reactor thread along with exported endpoints, so scrape is served between
+ * their proceeds. Response buffers and snapshots are kept between scrapes: once they grew to response size
+ * scrapes don't allocate.
+ */
+class prometheus_exporter : public proceed_i
+{
+public:
+    using source_t = std::function<metrics::metrics_snapshot()>;
+
+    /// request head larger than that is answered with 431 and connection is closed
+    static constexpr std::size_t MAX_REQUEST_SIZE = 2048;
+
+    /**
+     * @brief Ctor
+     * @param max_conns - expected scrapers count, connection slots are preallocated for them
+     */
+    explicit prometheus_exporter(std::size_t max_conns = 4);
+
+    /**
+     * @brief Export endpoint metrics
+     * @tparam Endpoint - endpoint type with metrics() (server_t, client_t)
+     * @param name - value of endpoint label
+     * @param endpoint - endpoint, must outlive exporter
+     */
+    template <typename Endpoint>
+    void add(std::string name, Endpoint const& endpoint)
+    {
+        add_source(std::move(name), [&endpoint]() { return endpoint.metrics(); });
+    }
+
+    /**
+     * @brief Export metrics of arbitrary source. Must be called before start
+     * @param name - value of endpoint label
+     * @param source - metrics source, called from proceeding thread on each scrape
+     */
+    void add_source(std::string name, source_t source);
+
+    /**
+     * @brief Start listening for scrapes
+     * @param address - local address
+     * @param port - local port
+     * @return true for success
+     */
+    bool start(std::string const& address, std::uint_fast16_t port) noexcept;
+
+    /**
+     * @brief Stop listening and close scrapers' connections
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Accept scrapers and answer their requests
+     * @param timeout - blocking timeout, zero for reactor already blocking on other endpoint
+     * @return true if at least one event was proceeded
+     */
+    bool proceed(std::chrono::milliseconds timeout) override;
+
+    /**
+     * @brief Render metrics of all sources
+     * @return metrics in Prometheus text format, valid until next render or scrape
+     */
+    std::string_view render();
+
+private:
+    struct connection
+    {
+        accepted_sock<sock::tcp> sock;
+        std::array<char, MAX_REQUEST_SIZE> request{};
+        std::size_t size = 0;
+    };
+
+    bool serve(connection& conn);
+    bool respond(connection& conn, std::string_view head);
+    bool send_response(connection& conn, std::string_view status, std::string_view body, bool keep_alive);
+    void close(std::size_t index) noexcept;
+
+    void family(std::string_view name, std::string_view type, std::string_view help);
+    /// appends series name and endpoint label, further labels may follow
+    void series(std::string_view name, std::string_view suffix, std::size_t source);
+    /// closes labels and appends value
+    void end(std::uint64_t value);
+    void end(double value);
+
+    std::vector<std::pair<std::string, source_t>> m_sources;
+    std::vector<metrics::metrics_snapshot> m_snapshots;
+    std::vector<connection> m_conns;
+    std::vector<char> m_body;
+    std::vector<char> m_response;
+    /// declared last: server's destructor reports termination to erase callback, that looks up connections
+    server_t<sock::tcp, epoll::epoll_t> m_server;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_PROMETHEUS_EXPORTER_H
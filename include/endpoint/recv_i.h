@@ -1,12 +1,15 @@
 #ifndef PROTEI_TEST_TASK_RECV_I_H
 #define PROTEI_TEST_TASK_RECV_I_H
 
+#include <socket/timestamp.h>
+
 #include <cstdint>
 #include <optional>
 
 namespace protei::sock
 {
 struct in_address_port_t;
+class unix_address_t;
 }
 
 namespace protei::endpoint
@@ -14,11 +17,13 @@ namespace protei::endpoint
 
 /**
  * @brief Receiving interface
+ * @tparam Address - remote address type
  */
-class recv_i
+template <typename Address>
+class basic_recv_i
 {
 public:
-    virtual ~recv_i() = default;
+    virtual ~basic_recv_i() = default;
 
     /**
      * @brief Receive to buffer
@@ -26,18 +31,45 @@ public:
      * @param buff_size - buffer size
      * @return Pair of remote and bytes received count, if nothing received returns std::nullopt
      */
-    std::optional<std::pair<sock::in_address_port_t, std::size_t>> recv(void* buffer, std::size_t buff_size);
+    std::optional<std::pair<Address, std::size_t>> recv(void* buffer, std::size_t buff_size);
+
+    /**
+     * @brief Receive to buffer with kernel RX timestamp, enabled by set_timestamping of endpoint
+     * @param buffer - buffer
+     * @param buff_size - buffer size
+     * @param ts - receive timestamp, std::nullopt if endpoint doesn't timestamp received data
+     * @return Pair of remote and bytes received count, if nothing received returns std::nullopt
+     */
+    std::optional<std::pair<Address, std::size_t>> recv_timestamped(
+            void* buffer, std::size_t buff_size, std::optional<sock::timestamp_t>& ts);
 
     /**
      * @return true if finished receiving (EWOULDBLOCK or EAGAIN return in internal socket)
      */
     bool finished_recv() const;
 private:
-    virtual std::optional<std::pair<sock::in_address_port_t, std::size_t>>
+    virtual std::optional<std::pair<Address, std::size_t>>
             recv_impl(void* buffer, std::size_t buff_size) = 0;
     virtual bool finished_recv_impl() const = 0;
+    /// sockets of internet protocols override it, others receive without timestamp
+    virtual std::optional<std::pair<Address, std::size_t>>
+            recv_timestamped_impl(void* buffer, std::size_t buff_size, std::optional<sock::timestamp_t>& ts)
+    {
+        ts.reset();
+        return recv_impl(buffer, buff_size);
+    }
+    /// descriptor recorded to trace, sockets override it
+    virtual int trace_fd() const noexcept
+    {
+        return -1;
+    }
 };
 
+extern template class basic_recv_i<sock::in_address_port_t>;
+extern template class basic_recv_i<sock::unix_address_t>;
+
+using recv_i = basic_recv_i<sock::in_address_port_t>;
+
 }
 
 #endif //PROTEI_TEST_TASK_RECV_I_H
@@ -1,6 +1,8 @@
 #ifndef PROTEI_TEST_TASK_SEND_I_H
 #define PROTEI_TEST_TASK_SEND_I_H
 
+#include <buffer/iobuf.h>
+
 #include <cstdint>
 #include <optional>
 
@@ -19,6 +21,12 @@ public:
      * @return Bytes sent count, if nothing sent returns std::nullopt
      */
     std::optional<std::size_t> send(void* buffer, std::size_t buff_size);
+    /**
+     * @brief Send buffer chain. Stream sockets may send it partially, sent bytes should be consumed from chain
+     * @param buf - buffer chain
+     * @return Bytes sent count, if nothing sent returns std::nullopt
+     */
+    std::optional<std::size_t> send(buffer::iobuf const& buf);
     /**
      * @return true if finished sending (EWOULDBLOCK or EAGAIN return in internal socket)
      */
@@ -26,6 +34,13 @@ public:
 private:
     virtual std::optional<std::size_t> send_impl(void* buffer, std::size_t buff_size) = 0;
     virtual bool finished_send_impl() const = 0;
+    /// copies chain to contiguous buffer, sockets supporting gather send override it
+    virtual std::optional<std::size_t> send_chain_impl(buffer::iobuf const& buf);
+    /// descriptor recorded to trace, sockets override it
+    virtual int trace_fd() const noexcept
+    {
+        return -1;
+    }
 };
 
 }
@@ -9,13 +9,17 @@ namespace protei::endpoint
 
 /**
  * @brief Combination of receive and send interfaces
+ * @tparam Address - remote address type
  */
-class send_recv_i : public send_i, public recv_i
+template <typename Address>
+class basic_send_recv_i : public send_i, public basic_recv_i<Address>
 {
 public:
-    virtual ~send_recv_i() = default;
+    virtual ~basic_send_recv_i() = default;
 };
 
+using send_recv_i = basic_send_recv_i<sock::in_address_port_t>;
+
 }
 
 #endif //PROTEI_TEST_TASK_SEND_RECV_I_H
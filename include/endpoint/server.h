@@ -4,11 +4,20 @@
 #include <endpoint/endpoint.h>
 #include <endpoint/accepted_sock.h>
 #include <endpoint/accepted_sock_ref.h>
+#include <endpoint/session_table.h>
+#include <endpoint/handoff.h>
+#include <endpoint/timestamping.h>
 #include <utils/mbind.h>
 #include <endpoint/proceed_i.h>
+#include <socket/af_inet.h>
 #include <utils/address_from_string.h>
 
+#include <sys/eventfd.h>
+#include <unistd.h>
+
 #include <set>
+#include <atomic>
+#include <memory>
 #include <cassert>
 
 namespace protei::endpoint
@@ -24,10 +33,11 @@ struct interface_proxy
     /**
      * @brief Start server. Creates listening socket internally
      * @param address - local address to bind to socket
-     * @param port - local port to bind to socket
+     * @param port - local port to bind to socket, ignored by unix domain protocols
      * @param max_conns - incoming connections limit
      * @param on_conn - callback to be called on new incoming connection
      * @param erase_active_socket - callback to be called on terminated connection
+     * @param reuse_address - allow binding to address with connections in TIME_WAIT (SO_REUSEADDR)
      * @return true for success
      */
     bool start(
@@ -35,7 +45,117 @@ struct interface_proxy
             , std::uint_fast16_t port
             , unsigned max_conns
             , std::function<void(accepted_sock<Proto>&&)> on_conn
+            , std::function<void(int fd)> erase_active_socket
+            , bool reuse_address = false) noexcept;
+
+    /**
+     * @brief Start server around listening socket created elsewhere (inherited or passed by systemd). No bind or
+     * listen is performed
+     * @param listening_fd - listening socket, owned by server on success
+     * @param max_conns - incoming connections limit socket was listened with
+     * @param on_conn - callback to be called on new incoming connection
+     * @param erase_active_socket - callback to be called on terminated connection
+     * @param exclusive - listening socket is shared with other processes (prefork), only one of them is woken up
+     * on incoming connection
+     * @return true for success, false if listening_fd isn't listening socket of Proto
+     */
+    bool start(
+            int listening_fd
+            , unsigned max_conns
+            , std::function<void(accepted_sock<Proto>&&)> on_conn
+            , std::function<void(int fd)> erase_active_socket
+            , bool exclusive = false) noexcept;
+
+    /**
+     * @brief Start server with listening socket (and accepted connections) handed off by previous process with
+     * handoff. No rebinding is performed, so pending connections are kept. Blocks until handoff is received.
+     * @param handoff_address - unix socket address to receive handoff on
+     * @param timeout - time to wait for previous process
+     * @param max_conns - incoming connections limit
+     * @param on_conn - callback to be called on new incoming connection and on each adopted connection
+     * @param erase_active_socket - callback to be called on terminated connection
+     * @return true for success
+     */
+    bool adopt(
+            std::string const& handoff_address
+            , std::chrono::milliseconds timeout
+            , unsigned max_conns
+            , std::function<void(accepted_sock<Proto>&&)> on_conn
             , std::function<void(int fd)> erase_active_socket) noexcept;
+
+    /**
+     * @brief Hand off listening socket and optionally accepted connections to new process, that calls adopt.
+     * On success server stops accepting and erase_active_socket is called for each handed off connection,
+     * other connections are still served, so process can drain them and exit.
+     * @param handoff_address - unix socket address new process receives handoff on
+     * @param accepted_fds - native handles of accepted connections to be handed off
+     * @param timeout - time to wait for new process
+     * @return true for success
+     */
+    bool handoff(
+            std::string const& handoff_address
+            , std::vector<int> const& accepted_fds
+            , std::chrono::milliseconds timeout) noexcept;
+
+    /**
+     * @brief Remove accepted connection from server's poll without erase_active_socket call, so it can be attached
+     * to other server (reactor). Must be called from thread proceeding this server. Connection served through fixed
+     * io isn't detached: its operations are completed by this server's ring.
+     * @param fd - accepted connection native handle
+     * @return true if connection was served by this server
+     */
+    bool detach(int fd) noexcept;
+
+    /**
+     * @brief Attach connection detached from other server. Thread safe: connection is queued and server's poll is
+     * woken up, even if it is blocked in proceed, then connection is added to poll and on_attached is called from
+     * proceeding thread. Server must be started. Pending buffers and handlers should be captured by on_attached to
+     * travel with connection.
+     * @param sock - detached connection
+     * @param on_attached - callback to be called on attachment, on_conn of start is called if empty
+     */
+    void attach(accepted_sock<Proto>&& sock, std::function<void(accepted_sock<Proto>&&)> on_attached = nullptr);
+
+    /**
+     * @return count of connections served by this server, counting queued for attachment
+     */
+    std::size_t load() const noexcept;
+
+    /**
+     * @brief Serve connections accepted from now on through io_uring completion based path (uring::fixed_io): send of
+     * accepted_sock queues data to registered buffer, recv takes data received by always queued receive. Operations
+     * queued between proceeds are submitted in one batch by proceed, ring's descriptor is polled by server, so
+     * completions are reaped by the same reactor. Connections over slots limit are served with plain syscalls.
+     * Can be set once, from thread proceeding this server. Connections served through it must be destroyed before
+     * server
+     * @param slots - connections limit of the path
+     * @param buffer_size - receive and send buffer size of connection
+     * @param fixed_buffers - register buffers arena, so send is zero copy
+     * @return true for success, false if already set or io_uring isn't supported
+     */
+    bool set_fixed_io(unsigned slots, std::size_t buffer_size, bool fixed_buffers = false) noexcept;
+
+    ~interface_proxy();
+
+protected:
+    void attach_queued();
+    void serve_fixed(accepted_sock<Proto>& sock) noexcept;
+
+    std::atomic<std::size_t> m_load{0};
+    /// eventfd polled by server, signaled on attach
+    int m_attach_event = -1;
+    /// completion based path of accepted connections, address is kept by slots
+    std::unique_ptr<uring::fixed_io> m_fixed_io;
+
+private:
+    void start_impl(
+            sock::listening_socket_t<Proto>&& listener
+            , std::function<void(accepted_sock<Proto>&&)> on_conn
+            , std::function<void(int fd)> erase_active_socket
+            , bool exclusive = false) noexcept;
+
+    std::mutex m_attach_mutex;
+    std::vector<std::pair<accepted_sock<Proto>, std::function<void(accepted_sock<Proto>&&)>>> m_attached;
 };
 
 
@@ -45,7 +165,7 @@ struct interface_proxy<Proto, D, PollTraits, sock::is_connectionless_t<Proto>>
     /**
      * @brief Start server. Creates binded socket internally
      * @param address - local address to bind to socket
-     * @param port - local port to bind to socket
+     * @param port - local port to bind to socket, ignored by unix domain protocols
      * @param on_conn - callback to be called on incoming messages. Must not use provided sockets after server_t
      * destruction.
      * @param on_close - callback to be called on termination events. After that must not use any of accepted sockets,
@@ -57,6 +177,66 @@ struct interface_proxy<Proto, D, PollTraits, sock::is_connectionless_t<Proto>>
             , std::uint_fast16_t port
             , std::function<void(accepted_sock_ref<Proto>&&)> on_conn
             , std::function<void()> on_close);
+
+    /**
+     * @brief Start server with per-peer session layer. Creates binded socket internally. Server receives datagrams
+     * itself and demultiplexes them to sessions by remote address. Idle sessions are expired on proceed.
+     * @param address - local address to bind to socket
+     * @param port - local port to bind to socket, ignored by unix domain protocols
+     * @param options - session layer options
+     * @param on_session - callback to be called on first datagram from new peer
+     * @param on_datagram - callback to be called on each received datagram
+     * @param on_expire - callback to be called on session expiration and on server termination
+     * @return true for success
+     */
+    bool start(
+            std::string const& address
+            , std::uint_fast16_t port
+            , session_options const& options
+            , typename session_table<Proto>::on_session_t on_session
+            , typename session_table<Proto>::on_datagram_t on_datagram
+            , typename session_table<Proto>::on_session_t on_expire);
+
+    /**
+     * @return session table if server was started with session layer, nullptr otherwise
+     */
+    session_table<Proto>* sessions() noexcept;
+
+    /**
+     * @brief Join multicast group on started server's socket. Several groups can be joined.
+     * @param group - group address
+     * @param iface - local interface address (IPv4 only), empty string for default interface
+     * @return true for success
+     */
+    bool join_group(std::string const& group, std::string const& iface = {}) noexcept;
+
+    /**
+     * @brief Leave multicast group
+     * @param group - group address
+     * @param iface - local interface address (IPv4 only), empty string for default interface
+     * @return true for success
+     */
+    bool leave_group(std::string const& group, std::string const& iface = {}) noexcept;
+
+protected:
+    void expire_sessions();
+
+    /**
+     * @return wildcard address of server's address family
+     */
+    std::string any_address() const;
+
+    bool start_impl(
+            std::string const& address
+            , std::uint_fast16_t port
+            , std::function<void(basic_send_recv_i<sock::proto_address_t<Proto>>&&)> on_conn
+            , std::function<void(int fd)> on_close
+            , bool reuse_address = false);
+
+private:
+    bool multicast_membership(std::string const& group, std::string const& iface, bool join) noexcept;
+
+    std::unique_ptr<session_table<Proto>> m_sessions;
 };
 
 
@@ -69,6 +249,8 @@ class server_t :
     friend class interface_proxy<Proto, server_t<Proto, Poll, PollTraits>, PollTraits>;
 public:
     using endpoint_t<sum_of_server_states_t, Proto, Poll, PollTraits>::endpoint_t;
+    /// receive buffers pool of server's reactor
+    using endpoint_t<sum_of_server_states_t, Proto, Poll, PollTraits>::buffers;
 
     ~server_t() override;
 
@@ -84,12 +266,33 @@ public:
      */
     void stop() noexcept;
 
+    /**
+     * @brief Get server metrics: traffic of accepted sockets, accepts, disconnects and event loop timings. Thread
+     * safe. Zeroed if compiled with PROTEI_NO_METRICS
+     * @return current metrics
+     */
+    metrics::metrics_snapshot metrics() const noexcept;
+
+    /**
+     * @brief Enable kernel software timestamps (SO_TIMESTAMPING) of server's socket (connectionless protocols) or of
+     * connections accepted from now on. Internet protocols only. Settings are kept across restarts. RX stamps are
+     * read by recv_timestamped of served sockets. TX stamps are read by server on error readiness and passed to
+     * on_tx, connection is terminated only if it has pending error besides them
+     * @param rx - timestamp received data
+     * @param on_tx - TX timestamps handler, TX timestamping is off if empty
+     * @return true for success
+     */
+    bool set_timestamping(bool rx, on_tx_timestamp_t on_tx = nullptr) noexcept;
+
 private:
     void register_cbs();
     void unregister_cbs();
+    bool apply_timestamping(sock::active_socket_t<Proto>& sock) noexcept;
+    bool failed(int fd) noexcept;
 
-    std::function<void(send_recv_i&&)> m_on_conn;
+    std::function<void(basic_send_recv_i<sock::proto_address_t<Proto>>&&)> m_on_conn;
     std::function<void(int fd)> m_erase_active_socket;
+    timestamping_t m_timestamping;
     mutable std::mutex m_mutex;
 };
 
@@ -0,0 +1,153 @@
+#ifndef PROTEI_TEST_TASK_SESSION_TABLE_H
+#define PROTEI_TEST_TASK_SESSION_TABLE_H
+
+#include <endpoint/udp_session.h>
+#include <utils/flat_hash_map.h>
+
+#include <functional>
+#include <vector>
+
+namespace protei::endpoint
+{
+
+/**
+ * @brief Demultiplexes datagrams of connectionless socket to per-peer sessions and expires idle ones.
+ * Doesn't allocate per datagram: receive buffer and table are preallocated.
+ * @tparam Proto - protocol type
+ */
+template <typename Proto>
+class session_table
+{
+public:
+    using session_t = udp_session<Proto>;
+    using address_t = typename session_t::address_t;
+    using on_session_t = std::function<void(session_t&)>;
+    using on_datagram_t = std::function<void(session_t&, void const* data, std::size_t size)>;
+
+    /**
+     * @brief Ctor
+     * @param options - session layer options
+     * @param on_session - callback to be called on first datagram from new peer
+     * @param on_datagram - callback to be called on each received datagram
+     * @param on_expire - callback to be called on session expiration
+     */
+    session_table(
+            session_options const& options
+            , on_session_t on_session
+            , on_datagram_t on_datagram
+            , on_session_t on_expire)
+        : m_options{options}
+        , m_sessions{options.capacity}
+        , m_buffer(options.max_datagram_size)
+        , m_on_session{std::move(on_session)}
+        , m_on_datagram{std::move(on_datagram)}
+        , m_on_expire{std::move(on_expire)}
+    {}
+
+    /**
+     * @brief Receive all pending datagrams and dispatch them to sessions
+     * @param sock - server socket
+     * @return received datagrams count
+     */
+    std::size_t demultiplex(sock::active_socket_t<Proto>& sock)
+    {
+        std::size_t received = 0;
+        auto now = session_t::clock_t::now();
+        while (auto rec = sock.receive(m_buffer.data(), m_buffer.size(), 0, m_from))
+        {
+            auto [session, created] = m_sessions.try_emplace(m_from, m_from, sock, now);
+            if (created)
+            {
+                if (m_on_session)
+                {
+                    m_on_session(*session);
+                }
+            }
+            else
+            {
+                session->touch(now);
+            }
+
+            if (m_on_datagram)
+            {
+                m_on_datagram(*session, m_buffer.data(), *rec);
+            }
+            ++received;
+        }
+
+        return received;
+    }
+
+    /**
+     * @brief Expire idle sessions. Checks next options.expire_batch slots of table, so whole table is swept
+     * in several calls.
+     * @param now - current time
+     * @return expired sessions count
+     */
+    std::size_t expire(typename session_t::clock_t::time_point now)
+    {
+        if (m_cursor >= m_sessions.slot_count())
+        {
+            m_cursor = 0;
+        }
+
+        auto expired = m_sessions.erase_if(m_cursor, m_options.expire_batch
+                , [&](address_t const&, session_t& session)
+                {
+                    if (now - session.last_active() >= m_options.idle_timeout)
+                    {
+                        if (m_on_expire)
+                        {
+                            m_on_expire(session);
+                        }
+                        return true;
+                    }
+                    return false;
+                });
+        m_cursor += m_options.expire_batch;
+        return expired;
+    }
+
+    /**
+     * @brief Expire all sessions
+     */
+    void clear()
+    {
+        if (m_on_expire)
+        {
+            m_sessions.for_each([this](address_t const&, session_t& session) { m_on_expire(session); });
+        }
+        m_sessions.clear();
+    }
+
+    /**
+     * @param peer - remote address
+     * @return session or nullptr if there is no session for peer
+     */
+    session_t* find(address_t const& peer) noexcept
+    {
+        return m_sessions.find(peer);
+    }
+
+    /**
+     * @return active sessions count
+     */
+    std::size_t size() const noexcept
+    {
+        return m_sessions.size();
+    }
+
+private:
+    session_options m_options;
+    utils::flat_hash_map<address_t, session_t, typename address_t::hash> m_sessions;
+    std::vector<std::byte> m_buffer;
+    address_t m_from;
+    std::size_t m_cursor = 0;
+    on_session_t m_on_session;
+    on_datagram_t m_on_datagram;
+    on_session_t m_on_expire;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_SESSION_TABLE_H
@@ -0,0 +1,97 @@
+#ifndef PROTEI_TEST_TASK_SHM_ACCEPTED_SOCK_H
+#define PROTEI_TEST_TASK_SHM_ACCEPTED_SOCK_H
+
+#include <endpoint/send_recv_i.h>
+#include <shm/shm_channel.h>
+#include <socket/socket.h>
+#include <socket/unix_address.h>
+#include <utils/mbind.h>
+
+namespace protei::endpoint
+{
+
+/**
+ * @brief Shared memory connection accepted by shm_server_t. Messages go through shared memory channel, handshake
+ * unix socket is kept to detect peer termination.
+ */
+class shm_accepted_sock : public basic_send_recv_i<sock::unix_address_t>
+{
+public:
+    /**
+     * @brief Ctor
+     * @param sock - handshake socket
+     * @param channel - shared memory channel
+     */
+    shm_accepted_sock(sock::active_socket_t<sock::unix_stream>&& sock, shm::shm_channel&& channel) noexcept
+        : m_sock{std::move(sock)}
+        , m_channel{std::move(channel)}
+        , m_remote{m_sock.remote().value_or(sock::unix_address_t{})}
+    {}
+
+    shm_accepted_sock(shm_accepted_sock&&) noexcept = default;
+    shm_accepted_sock& operator=(shm_accepted_sock&&) noexcept = default;
+
+    /**
+     * @brief Get handshake socket's native handle (file descriptor). Identifies connection in server's callbacks
+     * @return file descriptor
+     */
+    int native_handle() const noexcept
+    {
+        return m_sock.native_handle();
+    }
+
+    /**
+     * @return descriptor, that becomes readable when peer sends to drained channel
+     */
+    int event_fd() const noexcept
+    {
+        return m_channel.event_fd();
+    }
+
+    /**
+     * @return descriptor, that becomes readable when peer frees room in channel send found full
+     */
+    int writable_fd() const noexcept
+    {
+        return m_channel.writable_fd();
+    }
+
+private:
+    std::optional<std::size_t> send_impl(void* buffer, std::size_t n) override
+    {
+        return m_channel.send(buffer, n);
+    }
+
+    std::optional<std::pair<sock::unix_address_t, std::size_t>> recv_impl(void* buffer, std::size_t n) override
+    {
+        return utils::mbind(
+                m_channel.receive(buffer, n)
+                , [this](std::size_t recv) -> std::optional<std::pair<sock::unix_address_t, std::size_t>>
+                {
+                    return {{m_remote, recv}};
+                });
+    }
+
+    bool finished_send_impl() const override
+    {
+        return m_channel.finished_send();
+    }
+
+    bool finished_recv_impl() const override
+    {
+        return m_channel.finished_recv();
+    }
+
+    int trace_fd() const noexcept override
+    {
+        return native_handle();
+    }
+
+    sock::active_socket_t<sock::unix_stream> m_sock;
+    shm::shm_channel m_channel;
+    sock::unix_address_t m_remote;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_SHM_ACCEPTED_SOCK_H
@@ -0,0 +1,103 @@
+#ifndef PROTEI_TEST_TASK_SHM_CLIENT_H
+#define PROTEI_TEST_TASK_SHM_CLIENT_H
+
+#include <endpoint/endpoint.h>
+#include <endpoint/client_i.h>
+#include <shm/shm_channel.h>
+#include <socket/af_unix.h>
+#include <socket/unix_address.h>
+
+#include <mutex>
+
+namespace protei::endpoint
+{
+
+/**
+ * @brief Shared memory client. Connects to shm_server_t over unix stream socket and receives shared memory channel
+ * descriptors on handshake. After that messages bypass the kernel.
+ * @tparam Poll - poll type
+ * @tparam PollTraits - poll's static adapter
+ */
+template <typename Poll, typename PollTraits = poll_traits<Poll>>
+class shm_client_t :
+        private endpoint_t<sum_of_client_states_t, sock::unix_stream, Poll, PollTraits>
+        , public basic_client_i<sock::unix_address_t>
+{
+public:
+    /**
+     * @brief Ctor
+     * @param poller - poll instance
+     */
+    explicit shm_client_t(Poll poller);
+
+    ~shm_client_t() override;
+
+    /**
+     * @brief Proceed events
+     * @param timeout - blocking timeout
+     * @return true if at least one event was proceeded
+     */
+    bool proceed(std::chrono::milliseconds timeout) override;
+
+    /**
+     * @brief Start client. Creates handshake socket internally
+     * @return true for success
+     */
+    bool start() noexcept;
+
+    /**
+     * @brief Stop client
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Connect client to shm_server_t
+     * @param remote_address - server's unix socket address, '@' prefixed for abstract namespace
+     * @param on_connect - callback to be called on handshake completion
+     * @param on_read_ready - callback to be called on messages reception
+     * @param on_disconnect - callback to be called on server termination
+     * @return true if connection is initiated
+     */
+    bool connect(
+            std::string const& remote_address
+            , std::function<void()> on_connect
+            , std::function<void()> on_read_ready
+            , std::function<void()> on_disconnect) noexcept;
+
+    /**
+     * @return true if handshake is completed
+     */
+    bool connected() const noexcept;
+
+    /**
+     * @return descriptor, that becomes readable when server frees room in channel send found full, -1 if handshake
+     * isn't completed
+     */
+    int writable_fd() const noexcept;
+
+private:
+    std::optional<std::size_t> send_impl(void* buffer, std::size_t n) override;
+    std::optional<std::pair<sock::unix_address_t, std::size_t>> recv_impl(void* buffer, std::size_t n) override;
+    bool finished_recv_impl() const override;
+    bool finished_send_impl() const override;
+    int trace_fd() const noexcept override;
+
+    void handshake();
+    void disconnect(int fd);
+
+    void register_cbs();
+    void unregister_cbs();
+
+    std::optional<sock::unix_address_t> m_remote;
+    std::optional<shm::shm_channel> m_channel;
+    std::function<void()> m_on_connect;
+    std::function<void()> m_on_read_ready;
+    std::function<void()> m_on_disconnect;
+    mutable std::mutex m_mutex;
+};
+
+}
+
+#include "../../src/endpoint/shm_client.tpp"
+
+#endif //PROTEI_TEST_TASK_SHM_CLIENT_H
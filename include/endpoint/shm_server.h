@@ -0,0 +1,79 @@
+#ifndef PROTEI_TEST_TASK_SHM_SERVER_H
+#define PROTEI_TEST_TASK_SHM_SERVER_H
+
+#include <endpoint/endpoint.h>
+#include <endpoint/proceed_i.h>
+#include <endpoint/shm_accepted_sock.h>
+#include <socket/af_unix.h>
+
+#include <mutex>
+
+namespace protei::endpoint
+{
+
+/**
+ * @brief Shared memory server. Listens unix stream socket, on each accepted connection creates shared memory channel
+ * and passes its descriptors to client (SCM_RIGHTS). After handshake messages bypass the kernel.
+ * @tparam Poll - poll type
+ * @tparam PollTraits - poll's static adapter
+ */
+template <typename Poll, typename PollTraits = poll_traits<Poll>>
+class shm_server_t :
+        private endpoint_t<sum_of_server_states_t, sock::unix_stream, Poll, PollTraits>
+        , public proceed_i
+{
+public:
+    /// default ring size of each channel direction
+    static constexpr std::size_t DEFAULT_RING_CAPACITY = 1u << 20u;
+
+    /**
+     * @brief Ctor
+     * @param poller - poll instance
+     * @param ring_capacity - ring size of each channel direction in bytes
+     */
+    explicit shm_server_t(Poll poller, std::size_t ring_capacity = DEFAULT_RING_CAPACITY);
+
+    ~shm_server_t() override;
+
+    /**
+     * @brief Start server. Creates listening unix socket internally
+     * @param address - unix socket address, '@' prefixed for abstract namespace
+     * @param max_conns - incoming connections limit
+     * @param on_conn - callback to be called on new connection after handshake
+     * @param erase_active_socket - callback to be called on terminated connection with its native handle
+     * @return true for success
+     */
+    bool start(
+            std::string const& address
+            , unsigned max_conns
+            , std::function<void(shm_accepted_sock&&)> on_conn
+            , std::function<void(int fd)> erase_active_socket) noexcept;
+
+    /**
+     * @brief Stop server
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Proceed events
+     * @param timeout - blocking timeout
+     * @return true if at least one event was proceeded
+     */
+    bool proceed(std::chrono::milliseconds timeout) override;
+
+private:
+    void register_cbs();
+    void unregister_cbs();
+    void accept_all();
+
+    std::size_t m_ring_capacity;
+    std::function<void(shm_accepted_sock&&)> m_on_conn;
+    std::function<void(int fd)> m_erase_active_socket;
+    mutable std::mutex m_mutex;
+};
+
+}
+
+#include "../../src/endpoint/shm_server.tpp"
+
+#endif //PROTEI_TEST_TASK_SHM_SERVER_H
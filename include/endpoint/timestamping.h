@@ -0,0 +1,45 @@
+#ifndef PROTEI_TEST_TASK_ENDPOINT_TIMESTAMPING_H
+#define PROTEI_TEST_TASK_ENDPOINT_TIMESTAMPING_H
+
+#include <socket/timestamp.h>
+
+#include <functional>
+
+namespace protei::endpoint
+{
+
+/// TX timestamp handler, called with descriptor of socket timestamp was read from
+using on_tx_timestamp_t = std::function<void(int fd, sock::tx_timestamp_t const& ts)>;
+
+/**
+ * @brief Kernel timestamping settings of endpoint
+ */
+struct timestamping_t
+{
+    /// timestamp received data, stamps are read by recv_timestamped
+    bool rx = false;
+    /// TX timestamps handler, TX timestamping is off if empty
+    on_tx_timestamp_t on_tx;
+
+    /**
+     * @return true if any timestamping is on
+     */
+    bool enabled() const noexcept
+    {
+        return rx || on_tx;
+    }
+};
+
+/**
+ * @brief Handle error readiness of socket with TX timestamping on: pass queued TX timestamps to handler, then read
+ * pending socket error
+ * @param fd - socket descriptor, not owned
+ * @param af - socket address family
+ * @param on_tx - TX timestamps handler
+ * @return true if socket has pending error besides timestamps, so connection should be terminated
+ */
+bool drain_error_queue(int fd, int af, on_tx_timestamp_t const& on_tx) noexcept;
+
+}
+
+#endif //PROTEI_TEST_TASK_ENDPOINT_TIMESTAMPING_H
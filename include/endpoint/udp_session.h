@@ -0,0 +1,107 @@
+#ifndef PROTEI_TEST_TASK_UDP_SESSION_H
+#define PROTEI_TEST_TASK_UDP_SESSION_H
+
+#include <socket/socket.h>
+#include <socket/native_address.h>
+
+#include <chrono>
+
+namespace protei::endpoint
+{
+
+/**
+ * @brief Session layer options of connectionless server
+ */
+struct session_options
+{
+    /// sessions count to reserve space for
+    std::size_t capacity = 1024;
+    /// session is expired if no datagrams were received during this time
+    std::chrono::milliseconds idle_timeout{30000};
+    /// receive buffer size, datagrams exceeding it are truncated
+    std::size_t max_datagram_size = 65536;
+    /// table slots checked for expiration on each proceed
+    std::size_t expire_batch = 1024;
+};
+
+
+/**
+ * @brief Per-peer session of connectionless server. Valid only inside session callbacks.
+ * @tparam Proto - protocol type
+ */
+template <typename Proto>
+class udp_session
+{
+    static_assert(Proto::is_connectionless);
+public:
+    using clock_t = std::chrono::steady_clock;
+    using address_t = sock::proto_native_address_t<Proto>;
+
+    /**
+     * @brief Ctor
+     * @param peer - remote address
+     * @param sock - server socket
+     * @param now - session creation time
+     */
+    udp_session(address_t const& peer, sock::active_socket_t<Proto>& sock, clock_t::time_point now) noexcept
+        : m_peer{peer}
+        , m_sock{&sock}
+        , m_last_active{now}
+    {}
+
+    /**
+     * @brief Send datagram to peer
+     * @param buffer - buffer
+     * @param n - buffer size
+     * @return bytes sent count, if nothing sent returns std::nullopt
+     */
+    std::optional<std::size_t> send(void* buffer, std::size_t n) noexcept
+    {
+        return m_sock->send(m_peer, buffer, n, 0);
+    }
+
+    /**
+     * @return true if finished sending (EWOULDBLOCK or EAGAIN return in internal socket)
+     */
+    bool finished_send() const noexcept
+    {
+        return m_sock->again() || m_sock->would_block();
+    }
+
+    /**
+     * @return remote address
+     */
+    address_t const& peer() const noexcept
+    {
+        return m_peer;
+    }
+
+    /**
+     * @return last datagram reception time
+     */
+    clock_t::time_point last_active() const noexcept
+    {
+        return m_last_active;
+    }
+
+    /**
+     * @brief Update last datagram reception time
+     * @param now - reception time
+     */
+    void touch(clock_t::time_point now) noexcept
+    {
+        m_last_active = now;
+    }
+
+    /// user's per-peer state
+    void* context = nullptr;
+
+private:
+    address_t m_peer;
+    sock::active_socket_t<Proto>* m_sock;
+    clock_t::time_point m_last_active;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_UDP_SESSION_H
@@ -0,0 +1,145 @@
+#ifndef PROTEI_TEST_TASK_URING_SERVER_H
+#define PROTEI_TEST_TASK_URING_SERVER_H
+
+#include <endpoint/server.h>
+#include <uring/uring.h>
+
+#include <cerrno>
+#include <string_view>
+#include <unordered_map>
+
+#include <unistd.h>
+
+namespace protei::endpoint
+{
+
+/**
+ * @brief Options of completion based server
+ */
+struct uring_options
+{
+    /// buffers provided to kernel for receiving, power of 2. Shared by all connections
+    std::uint16_t buffers = 1024;
+    std::uint32_t buffer_size = 4096;
+};
+
+
+/**
+ * @brief Completion based server of connection based protocol over io_uring. Listening socket is served by one
+ * multishot accept, each connection by one multishot recv into buffers picked by kernel from provided buffer ring,
+ * so operations aren't resubmitted and idle connections don't hold buffers. Received data is passed to on_data
+ * instead of readiness notification, accepted_sock is used for sending only. Must be used from one thread.
+ * @tparam Proto - connection based protocol type
+ */
+template <typename Proto, typename PollTraits>
+class server_t<Proto, uring::uring_t, PollTraits> : public proceed_i
+{
+    static_assert(!Proto::is_connectionless, "io_uring server supports connection based protocols only");
+public:
+    using on_data_t = std::function<void(int fd, std::string_view data)>;
+
+    /**
+     * @brief Ctor
+     * @tparam AF - address family type. Must be convertible to int
+     * @param ring - io_uring instance
+     * @param af - address family
+     * @param options - provided buffers options
+     */
+    template <typename AF>
+    server_t(uring::uring_t ring, AF af, uring_options const& options = {}) noexcept;
+
+    ~server_t() override;
+
+    /**
+     * @brief Start server. Creates listening socket internally
+     * @param address - local address to bind to socket
+     * @param port - local port to bind to socket, ignored by unix domain protocols
+     * @param max_conns - incoming connections limit
+     * @param on_conn - callback to be called on new incoming connection
+     * @param on_data - callback to be called on received data, data is valid inside callback only
+     * @param erase_active_socket - callback to be called on terminated connection
+     * @return true for success, false if kernel doesn't support multishot operations or buffer rings
+     */
+    bool start(
+            std::string const& address
+            , std::uint_fast16_t port
+            , unsigned max_conns
+            , std::function<void(accepted_sock<Proto>&&)> on_conn
+            , on_data_t on_data
+            , std::function<void(int fd)> erase_active_socket) noexcept;
+
+    /**
+     * @brief Start server around listening socket created elsewhere
+     * @param listening_fd - listening socket, owned by server on success
+     * @param max_conns - incoming connections limit socket was listened with
+     * @param on_conn - callback to be called on new incoming connection
+     * @param on_data - callback to be called on received data, data is valid inside callback only
+     * @param erase_active_socket - callback to be called on terminated connection
+     * @return true for success
+     */
+    bool start(
+            int listening_fd
+            , unsigned max_conns
+            , std::function<void(accepted_sock<Proto>&&)> on_conn
+            , on_data_t on_data
+            , std::function<void(int fd)> erase_active_socket) noexcept;
+
+    /**
+     * @brief Stop receiving on connection before accepted_sock is destroyed. Pending recv holds socket, so it isn't
+     * closed until recv is cancelled. erase_active_socket isn't called.
+     * @param fd - accepted connection native handle
+     * @return true if connection was served by this server
+     */
+    bool close(int fd) noexcept;
+
+    /**
+     * @brief Proceed completions
+     * @param timeout - blocking timeout
+     * @return true if at least one completion was proceeded
+     */
+    bool proceed(std::chrono::milliseconds timeout) override;
+
+    /**
+     * @brief Stop server
+     */
+    void stop() noexcept;
+
+    /**
+     * @return count of connections served by this server
+     */
+    std::size_t load() const noexcept;
+
+private:
+    /// user data is generation of fd in upper half and fd in lower one, so completions of closed fd are ignored
+    static constexpr std::uint32_t ACCEPT_GENERATION = 0;
+    static constexpr std::uint32_t CANCEL_GENERATION = 0xffffffff;
+
+    static std::uint64_t user_data(std::uint32_t generation, int fd) noexcept;
+
+    bool start_impl(
+            sock::listening_socket_t<Proto>&& listener
+            , std::function<void(accepted_sock<Proto>&&)> on_conn
+            , on_data_t on_data
+            , std::function<void(int fd)> erase_active_socket) noexcept;
+
+    void on_accept(uring::completion const& completion);
+    void on_recv(int fd, std::uint32_t generation, uring::completion const& completion);
+
+    uring::uring_t m_ring;
+    int m_af;
+    uring_options m_options;
+    std::optional<uring::provided_buffers> m_buffers;
+    std::optional<sock::listening_socket_t<Proto>> m_listener;
+    std::unordered_map<int, std::uint32_t> m_conns;
+    std::uint32_t m_generation = ACCEPT_GENERATION;
+    std::vector<uring::completion> m_completions;
+    std::function<void(accepted_sock<Proto>&&)> m_on_conn;
+    on_data_t m_on_data;
+    std::function<void(int fd)> m_erase_active_socket;
+};
+
+}
+
+#include "../../src/endpoint/uring_server.tpp"
+
+#endif //PROTEI_TEST_TASK_URING_SERVER_H
@@ -44,9 +44,11 @@ public:
      * @brief Add socket to epoll
      * @param sock_fd - file descriptor
      * @param op - socket's operations to subscribe
+     * @param exclusive - wake up only one of epolls waiting on the same socket (EPOLLEXCLUSIVE). Used for listening
+     * socket shared by several processes, such socket can't be modified and peer close is reported as HANGUP only
      * @return true if added successfully
      */
-    bool add_socket(int sock_fd, sock::sock_op op) noexcept;
+    bool add_socket(int sock_fd, sock::sock_op op, bool exclusive = false) noexcept;
 
     /**
      * @brief Modify socket in epoll
@@ -70,14 +72,22 @@ public:
      */
     std::vector<poll_event::event> proceed(std::chrono::milliseconds timeout) noexcept;
 
+    /**
+     * @brief Proceed events without allocation once events has enough capacity
+     * @param timeout - blocking timeout
+     * @param events - proceeded events are appended to
+     * @return proceeded events count
+     */
+    std::size_t proceed(std::chrono::milliseconds timeout, std::vector<poll_event::event>& events) noexcept;
+
 private:
     epoll_t() noexcept = default;
 
     void exchange(epoll_t&&) noexcept;
 
-    bool epoll_ctl(int sock_fd, int ctl_op, std::optional<sock::sock_op> op) noexcept;
+    bool epoll_ctl(int sock_fd, int ctl_op, std::optional<sock::sock_op> op, bool exclusive = false) noexcept;
 
-    static std::uint_fast32_t flags_from_op(sock::sock_op op) noexcept;
+    static std::uint_fast32_t flags_from_op(sock::sock_op op, bool exclusive) noexcept;
     static poll_event::event_type event_type_from_flags(std::uint_fast32_t flags) noexcept;
 
     int m_fd;
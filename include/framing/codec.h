@@ -0,0 +1,133 @@
+#ifndef PROTEI_TEST_TASK_CODEC_H
+#define PROTEI_TEST_TASK_CODEC_H
+
+#include <framing/ring_buffer.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace protei::framing
+{
+
+/**
+ * @brief Frame search result
+ */
+struct frame_t
+{
+    enum class status_t
+    {
+        /// more data needed
+        INCOMPLETE,
+        /// frame found
+        COMPLETE,
+        /// stream violates framing, connection should be closed
+        MALFORMED
+    };
+
+    status_t status = status_t::INCOMPLETE;
+    /// payload offset from the first unread byte
+    std::size_t offset = 0;
+    /// payload size
+    std::size_t size = 0;
+    /// bytes taken by frame including header and delimiter
+    std::size_t consumed = 0;
+};
+
+
+/**
+ * @brief Length prefixed frames: fixed size big endian or varint (LEB128) length followed by payload
+ */
+class length_prefix_codec
+{
+public:
+    enum class prefix_t
+    {
+        U8,
+        U16,
+        U32,
+        VARINT
+    };
+
+    /// max encoded header size
+    static constexpr std::size_t MAX_HEADER_SIZE = 10;
+    static constexpr std::size_t MAX_TRAILER_SIZE = 0;
+
+    /**
+     * @brief Ctor
+     * @param prefix - length prefix type
+     * @param max_frame - payload size limit, larger frame is malformed
+     */
+    length_prefix_codec(prefix_t prefix, std::size_t max_frame) noexcept;
+
+    /**
+     * @brief Find the first frame in unread data
+     * @param ring - received data
+     * @return search result
+     */
+    frame_t find(ring_buffer const& ring) noexcept;
+
+    /**
+     * @brief Encode frame header
+     * @param size - payload size
+     * @param out - header storage, at least MAX_HEADER_SIZE bytes
+     * @return header size, 0 if size can't be encoded by prefix
+     */
+    std::size_t header(std::size_t size, char* out) const noexcept;
+
+    /**
+     * @return 0, frames have no trailer
+     */
+    std::size_t trailer(std::size_t, char*) const noexcept;
+
+private:
+    prefix_t m_prefix;
+    std::size_t m_max_frame;
+};
+
+
+/**
+ * @brief Frames terminated by delimiter byte, such as newline. Delimiter isn't included in payload
+ */
+class delimiter_codec
+{
+public:
+    static constexpr std::size_t MAX_HEADER_SIZE = 0;
+    static constexpr std::size_t MAX_TRAILER_SIZE = 1;
+
+    /**
+     * @brief Ctor
+     * @param delimiter - frame terminator
+     * @param max_frame - payload size limit, larger frame is malformed
+     */
+    delimiter_codec(char delimiter, std::size_t max_frame) noexcept;
+
+    /**
+     * @brief Find the first frame in unread data. Bytes already scanned for incomplete frame aren't scanned again
+     * @param ring - received data
+     * @return search result
+     */
+    frame_t find(ring_buffer const& ring) noexcept;
+
+    /**
+     * @return 0, frames have no header
+     */
+    std::size_t header(std::size_t, char*) const noexcept;
+
+    /**
+     * @brief Encode frame trailer
+     * @param size - payload size
+     * @param out - trailer storage, at least 1 byte
+     * @return trailer size
+     */
+    std::size_t trailer(std::size_t size, char* out) const noexcept;
+
+private:
+    char m_delimiter;
+    std::size_t m_max_frame;
+    /// bytes of incomplete frame known not to contain delimiter
+    std::size_t m_scanned = 0;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_CODEC_H
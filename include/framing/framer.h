@@ -0,0 +1,80 @@
+#ifndef PROTEI_TEST_TASK_FRAMER_H
+#define PROTEI_TEST_TASK_FRAMER_H
+
+#include <framing/ring_buffer.h>
+#include <framing/codec.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace protei::framing
+{
+
+/**
+ * @brief Per-connection framing layer over stream socket (accepted_sock, client_t). Reads socket into ring buffer and
+ * passes complete frames to handler as views into the ring.
+ * @tparam Codec - framing codec (length_prefix_codec, delimiter_codec)
+ */
+template <typename Codec>
+class framer_t
+{
+public:
+    /**
+     * @brief Ctor
+     * @param codec - framing codec
+     * @param capacity - ring buffer size, must fit the largest frame with header
+     */
+    framer_t(Codec codec, std::size_t capacity);
+
+    /**
+     * @brief Ctor. Ring storage is borrowed from pool only while connection has unframed data
+     * @param codec - framing codec
+     * @param pool - reactor's buffer pool, must outlive framer
+     * @param capacity - ring buffer size, must fit the largest frame with header
+     */
+    framer_t(Codec codec, buffer::buffer_pool& pool, std::size_t capacity);
+
+    /**
+     * @brief Receive all available data and pass complete frames to handler. Frame view is valid only inside handler.
+     * Reading stops on short read, which drains stream socket, so socket isn't probed until EAGAIN
+     * @tparam Sock - socket type, recv(buffer, n) returns std::optional of pair with received bytes count as second
+     * @tparam Handler - callable with std::string_view
+     * @param sock - socket
+     * @param handler - frame handler
+     * @return passed frames count, std::nullopt if stream is malformed or frame doesn't fit ring buffer
+     */
+    template <typename Sock, typename Handler>
+    std::optional<std::size_t> read(Sock& sock, Handler&& handler);
+
+    /**
+     * @brief Send frame
+     * @tparam Sock - socket type, send(buffer, n) returns std::optional of sent bytes count
+     * @param sock - socket
+     * @param payload - frame payload
+     * @return sent bytes count including header and trailer, std::nullopt if nothing sent or payload can't be framed
+     */
+    template <typename Sock>
+    std::optional<std::size_t> write(Sock& sock, std::string_view payload);
+
+    /**
+     * @return received but not framed yet bytes count
+     */
+    std::size_t pending() const noexcept;
+
+private:
+    template <typename Handler>
+    std::optional<std::size_t> dispatch(Handler& handler);
+
+    Codec m_codec;
+    ring_buffer m_ring;
+    /// storage of frames wrapping the ring
+    std::string m_scratch;
+    std::string m_out;
+};
+
+}
+
+#include "../../src/framing/framer.tpp"
+
+#endif //PROTEI_TEST_TASK_FRAMER_H
@@ -0,0 +1,103 @@
+#ifndef PROTEI_TEST_TASK_RING_BUFFER_H
+#define PROTEI_TEST_TASK_RING_BUFFER_H
+
+#include <buffer/buffer_pool.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace protei::framing
+{
+
+/**
+ * @brief Per-connection byte ring. Socket reads directly into free space, frames are read in place and copied only
+ * if they wrap around the end of storage.
+ */
+class ring_buffer
+{
+public:
+    /**
+     * @brief Ctor
+     * @param capacity - size in bytes, rounded up to power of 2
+     */
+    explicit ring_buffer(std::size_t capacity);
+
+    /**
+     * @brief Ctor. Storage is borrowed from pool on first write and returned when ring is drained
+     * @param pool - reactor's buffer pool, must outlive ring
+     * @param capacity - size in bytes, rounded up to power of 2, must not exceed buffer_pool::MAX_BUFFER_SIZE
+     */
+    ring_buffer(buffer::buffer_pool& pool, std::size_t capacity) noexcept;
+
+    ring_buffer(ring_buffer&&) noexcept = default;
+    ring_buffer& operator=(ring_buffer&&) noexcept = default;
+
+    /**
+     * @return contiguous free space after written data. Empty if ring is full or storage can't be borrowed
+     */
+    std::pair<char*, std::size_t> write_area() noexcept;
+
+    /**
+     * @brief Mark bytes of write_area as written
+     * @param n - bytes count
+     */
+    void commit(std::size_t n) noexcept;
+
+    /**
+     * @brief Mark bytes as read. Borrowed storage is returned to pool when ring is drained
+     * @param n - bytes count
+     */
+    void consume(std::size_t n) noexcept;
+
+    /**
+     * @brief Return borrowed storage to pool if ring is empty
+     */
+    void release() noexcept;
+
+    /**
+     * @return written data as two contiguous segments, second one is non-empty if data wraps
+     */
+    std::pair<std::string_view, std::string_view> readable() const noexcept;
+
+    /**
+     * @brief Get written data range
+     * @param offset - offset from the first unread byte
+     * @param n - range size, offset + n must not exceed size()
+     * @param scratch - storage range is copied to if it wraps
+     * @return range view, valid until consume or scratch modification
+     */
+    std::string_view view(std::size_t offset, std::size_t n, std::string& scratch) const;
+
+    /**
+     * @param offset - offset from the first unread byte, must be less than size()
+     * @return byte
+     */
+    char at(std::size_t offset) const noexcept;
+
+    /**
+     * @return unread bytes count
+     */
+    std::size_t size() const noexcept;
+
+    /**
+     * @return ring size in bytes
+     */
+    std::size_t capacity() const noexcept;
+
+private:
+    std::unique_ptr<char[]> m_own;
+    buffer::buffer_pool* m_pool = nullptr;
+    buffer::pooled_buffer m_borrowed;
+    char* m_data;
+    std::size_t m_mask;
+    /// monotonic read and write positions
+    std::size_t m_head = 0;
+    std::size_t m_tail = 0;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_RING_BUFFER_H
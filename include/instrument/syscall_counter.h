@@ -0,0 +1,112 @@
+#ifndef PROTEI_TEST_TASK_SYSCALL_COUNTER_H
+#define PROTEI_TEST_TASK_SYSCALL_COUNTER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace protei::instrument
+{
+
+/**
+ * @brief Counted libc entry points used by socket_impl and epoll_t
+ */
+enum class syscall_t
+{
+    SEND,
+    RECV,
+    SENDTO,
+    RECVFROM,
+    SENDMSG,
+    RECVMSG,
+    RECVMMSG,
+    /// accept and accept4
+    ACCEPT,
+    EPOLL_WAIT,
+    EPOLL_CTL,
+    COUNT
+};
+
+/**
+ * @param call - syscall
+ * @return syscall name
+ */
+char const* syscall_name(syscall_t call) noexcept;
+
+
+/**
+ * @brief Syscalls made by thread
+ */
+struct syscall_stats
+{
+    std::array<std::uint64_t, static_cast<std::size_t>(syscall_t::COUNT)> calls{};
+    /// calls failed with EAGAIN or EWOULDBLOCK: probes of drained or full socket
+    std::array<std::uint64_t, static_cast<std::size_t>(syscall_t::COUNT)> would_block{};
+
+    /**
+     * @return calls of syscall
+     */
+    std::uint64_t operator[](syscall_t call) const noexcept
+    {
+        return calls[static_cast<std::size_t>(call)];
+    }
+
+    /**
+     * @return calls failed with EAGAIN of syscall
+     */
+    std::uint64_t blocked(syscall_t call) const noexcept
+    {
+        return would_block[static_cast<std::size_t>(call)];
+    }
+
+    /**
+     * @return calls of all syscalls
+     */
+    std::uint64_t total() const noexcept;
+
+    /**
+     * @return calls failed with EAGAIN of all syscalls
+     */
+    std::uint64_t total_blocked() const noexcept;
+
+    /**
+     * @return counters difference, calls made between two snapshots
+     */
+    syscall_stats operator-(syscall_stats const& other) const noexcept;
+};
+
+
+/**
+ * @brief Counters of calling thread. Counting is link-time interposition: binary is linked with syscall_counter
+ * library, which defines counted libc functions and forwards them to libc. Transport library itself isn't
+ * instrumented.
+ * @return syscalls made by calling thread since its start
+ */
+syscall_stats thread_syscalls() noexcept;
+
+
+/**
+ * @brief Counts syscalls of calling thread made during scope lifetime
+ */
+class syscall_scope
+{
+public:
+    syscall_scope() noexcept
+        : m_start{thread_syscalls()}
+    {}
+
+    /**
+     * @return syscalls made since scope construction
+     */
+    syscall_stats stats() const noexcept
+    {
+        return thread_syscalls() - m_start;
+    }
+
+private:
+    syscall_stats m_start;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_SYSCALL_COUNTER_H
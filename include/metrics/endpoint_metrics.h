@@ -0,0 +1,344 @@
+#ifndef PROTEI_TEST_TASK_ENDPOINT_METRICS_H
+#define PROTEI_TEST_TASK_ENDPOINT_METRICS_H
+
+#include <metrics/histogram.h>
+#include <utils/may_be_unused.h>
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace protei::metrics
+{
+
+/// metrics are collected unless compiled with PROTEI_NO_METRICS (TRANSPORT_METRICS=OFF cmake option)
+#ifdef PROTEI_NO_METRICS
+inline constexpr bool enabled = false;
+#else
+inline constexpr bool enabled = true;
+#endif
+
+/**
+ * @brief Connection termination reason, first termination event reported by poll
+ */
+enum class disconnect_t
+{
+    PEER_CLOSED,
+    HANGUP,
+    ERROR,
+    EXCEPTION,
+    COUNT
+};
+
+
+/**
+ * @brief Endpoint metrics at some moment
+ */
+struct metrics_snapshot
+{
+    std::uint64_t bytes_in = 0;
+    std::uint64_t bytes_out = 0;
+    std::uint64_t messages_in = 0;
+    std::uint64_t messages_out = 0;
+    std::uint64_t accepts = 0;
+    std::array<std::uint64_t, static_cast<std::size_t>(disconnect_t::COUNT)> disconnects{};
+    /// send or recv failed with EAGAIN or EWOULDBLOCK
+    std::uint64_t eagain = 0;
+    std::uint64_t proceeds = 0;
+    std::uint64_t events = 0;
+    histogram_snapshot events_per_proceed;
+    /// handlers execution time of each polled event, user callbacks included
+    histogram_snapshot handler_ns;
+    /// time between return from proceed and next proceed call: ready events wait that long before being polled
+    histogram_snapshot loop_lag_ns;
+
+    /**
+     * @return count of connections terminated with reason
+     */
+    std::uint64_t disconnected(disconnect_t reason) const noexcept
+    {
+        return disconnects[static_cast<std::size_t>(reason)];
+    }
+};
+
+
+#ifndef PROTEI_NO_METRICS
+
+/**
+ * @brief Endpoint counters and histograms. Counters are relaxed atomics: endpoint may be proceeded by one thread and
+ * sent to by others, snapshot may be taken from any thread.
+ */
+class endpoint_metrics
+{
+public:
+    using clock_t = std::chrono::steady_clock;
+
+    void sent(std::size_t bytes) noexcept
+    {
+        add(m_bytes_out, bytes);
+        add(m_messages_out, 1);
+    }
+
+    void received(std::size_t bytes) noexcept
+    {
+        add(m_bytes_in, bytes);
+        add(m_messages_in, 1);
+    }
+
+    void would_block() noexcept
+    {
+        add(m_eagain, 1);
+    }
+
+    void accepted() noexcept
+    {
+        add(m_accepts, 1);
+    }
+
+    void disconnected(disconnect_t reason) noexcept
+    {
+        add(m_disconnects[static_cast<std::size_t>(reason)], 1);
+    }
+
+    /**
+     * @brief Mark entry to proceed, records loop lag since previous proceed
+     */
+    void loop_entered() noexcept
+    {
+        auto left = m_left.load(std::memory_order_relaxed);
+        if (left != clock_t::rep{})
+        {
+            m_loop_lag.record(since(left, now()));
+        }
+    }
+
+    /**
+     * @brief Mark return from poll
+     * @param events - polled events count
+     * @return start time of first event handling
+     */
+    clock_t::rep polled(std::size_t events) noexcept
+    {
+        add(m_proceeds, 1);
+        add(m_events, events);
+        m_events_per_proceed.record(events);
+        return now();
+    }
+
+    /**
+     * @brief Mark end of event handling
+     * @param start - start time of handling
+     * @return start time of next event handling
+     */
+    clock_t::rep handled(clock_t::rep start) noexcept
+    {
+        auto end = now();
+        m_handler.record(since(start, end));
+        return end;
+    }
+
+    /**
+     * @brief Mark return from proceed
+     * @param end - end time of last event handling
+     */
+    void loop_left(clock_t::rep end) noexcept
+    {
+        m_left.store(end, std::memory_order_relaxed);
+    }
+
+    /**
+     * @return current metrics
+     */
+    metrics_snapshot snapshot() const noexcept;
+
+private:
+    static void add(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept
+    {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    static clock_t::rep now() noexcept
+    {
+        return clock_t::now().time_since_epoch().count();
+    }
+
+    static std::uint64_t since(clock_t::rep start, clock_t::rep end) noexcept
+    {
+        return end > start ? std::chrono::nanoseconds{clock_t::duration{end - start}}.count() : 0;
+    }
+
+    std::atomic<std::uint64_t> m_bytes_in{0};
+    std::atomic<std::uint64_t> m_bytes_out{0};
+    std::atomic<std::uint64_t> m_messages_in{0};
+    std::atomic<std::uint64_t> m_messages_out{0};
+    std::atomic<std::uint64_t> m_accepts{0};
+    std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(disconnect_t::COUNT)> m_disconnects{};
+    std::atomic<std::uint64_t> m_eagain{0};
+    std::atomic<std::uint64_t> m_proceeds{0};
+    std::atomic<std::uint64_t> m_events{0};
+    std::atomic<clock_t::rep> m_left{0};
+    histogram m_events_per_proceed;
+    histogram m_handler;
+    histogram m_loop_lag;
+};
+
+
+/// metrics of endpoint, shared with sockets it serves
+using shared_metrics = std::shared_ptr<endpoint_metrics>;
+
+/**
+ * @return new endpoint metrics
+ */
+inline shared_metrics make_metrics()
+{
+    return std::make_shared<endpoint_metrics>();
+}
+
+#else
+
+/**
+ * @brief Compiled out endpoint metrics: no state, no clock reads
+ */
+class endpoint_metrics
+{
+public:
+    using clock_t = std::chrono::steady_clock;
+
+    void sent(std::size_t) noexcept {}
+    void received(std::size_t) noexcept {}
+    void would_block() noexcept {}
+    void accepted() noexcept {}
+    void disconnected(disconnect_t) noexcept {}
+    void loop_entered() noexcept {}
+    clock_t::rep polled(std::size_t) noexcept { return {}; }
+    clock_t::rep handled(clock_t::rep) noexcept { return {}; }
+    void loop_left(clock_t::rep) noexcept {}
+    metrics_snapshot snapshot() const noexcept { return {}; }
+};
+
+
+/**
+ * @brief Compiled out shared metrics: holds stateless stub in place instead of allocating it
+ */
+class shared_metrics
+{
+public:
+    endpoint_metrics* operator->() noexcept
+    {
+        return &m_stub;
+    }
+
+    endpoint_metrics const* operator->() const noexcept
+    {
+        return &m_stub;
+    }
+
+private:
+    endpoint_metrics m_stub;
+};
+
+/**
+ * @return compiled out metrics, doesn't allocate
+ */
+inline shared_metrics make_metrics() noexcept
+{
+    return {};
+}
+
+#endif
+
+
+/**
+ * @brief Nullable reference to endpoint metrics, held by sockets served by endpoint to account their traffic. Shares
+ * metrics ownership, so accepted socket may outlive its server or be migrated to other one
+ */
+class metrics_ref
+{
+public:
+    metrics_ref() noexcept = default;
+
+    explicit metrics_ref(shared_metrics const& metrics) noexcept
+#ifndef PROTEI_NO_METRICS
+        : m_metrics{metrics}
+#endif
+    {
+        MAY_BE_UNUSED(metrics);
+    }
+
+    /**
+     * @brief Account send result
+     * @param result - sent bytes count, std::nullopt if nothing sent
+     * @param sock - socket, asked for EAGAIN if nothing sent
+     * @return result
+     */
+    template <typename Result, typename Sock>
+    Result sent(Result&& result, Sock const& sock) const noexcept
+    {
+#ifndef PROTEI_NO_METRICS
+        if (m_metrics)
+        {
+            if (result)
+            {
+                m_metrics->sent(transferred(*result));
+            }
+            else if (sock.again() || sock.would_block())
+            {
+                m_metrics->would_block();
+            }
+        }
+#endif
+        MAY_BE_UNUSED(sock);
+        return std::forward<Result>(result);
+    }
+
+    /**
+     * @brief Account recv result
+     * @param result - received bytes count or pair of remote and bytes count, std::nullopt if nothing received
+     * @param sock - socket, asked for EAGAIN if nothing received
+     * @return result
+     */
+    template <typename Result, typename Sock>
+    Result received(Result&& result, Sock const& sock) const noexcept
+    {
+#ifndef PROTEI_NO_METRICS
+        if (m_metrics)
+        {
+            if (result)
+            {
+                // end of stream isn't a message
+                if (auto bytes = transferred(*result); bytes != 0)
+                {
+                    m_metrics->received(bytes);
+                }
+            }
+            else if (sock.again() || sock.would_block())
+            {
+                m_metrics->would_block();
+            }
+        }
+#endif
+        MAY_BE_UNUSED(sock);
+        return std::forward<Result>(result);
+    }
+
+private:
+    static std::size_t transferred(std::size_t bytes) noexcept
+    {
+        return bytes;
+    }
+
+    template <typename Address>
+    static std::size_t transferred(std::pair<Address, std::size_t> const& received) noexcept
+    {
+        return received.second;
+    }
+
+#ifndef PROTEI_NO_METRICS
+    std::shared_ptr<endpoint_metrics> m_metrics;
+#endif
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_ENDPOINT_METRICS_H
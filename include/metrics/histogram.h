@@ -0,0 +1,131 @@
+#ifndef PROTEI_TEST_TASK_HISTOGRAM_H
+#define PROTEI_TEST_TASK_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace protei::metrics
+{
+
+/**
+ * @brief Log-linear bucketing: values below SUB_BUCKETS have own buckets, every next power of two range is split
+ * into SUB_BUCKETS linear buckets, so relative error of bucket bounds is at most 1 / SUB_BUCKETS
+ */
+struct log_linear
+{
+    static constexpr std::size_t SUB_BUCKET_BITS = 3;
+    static constexpr std::size_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    /// greater values are recorded to the last bucket, for nanoseconds it is about 18 minutes
+    static constexpr std::size_t MAX_VALUE_BITS = 40;
+    static constexpr std::uint64_t MAX_VALUE = (std::uint64_t{1} << MAX_VALUE_BITS) - 1;
+    static constexpr std::size_t BUCKETS = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    /**
+     * @param value - recorded value
+     * @return index of bucket value falls to
+     */
+    static constexpr std::size_t bucket(std::uint64_t value) noexcept
+    {
+        if (value > MAX_VALUE)
+        {
+            value = MAX_VALUE;
+        }
+        if (value < SUB_BUCKETS)
+        {
+            return value;
+        }
+        std::size_t shift = 63 - __builtin_clzll(value) - SUB_BUCKET_BITS;
+        return shift * SUB_BUCKETS + (value >> shift);
+    }
+
+    /**
+     * @param index - bucket index
+     * @return least value of bucket
+     */
+    static constexpr std::uint64_t lower_bound(std::size_t index) noexcept
+    {
+        if (index < SUB_BUCKETS)
+        {
+            return index;
+        }
+        std::size_t shift = index / SUB_BUCKETS - 1;
+        return std::uint64_t{index % SUB_BUCKETS + SUB_BUCKETS} << shift;
+    }
+
+    /**
+     * @param index - bucket index
+     * @return greatest value of bucket
+     */
+    static constexpr std::uint64_t upper_bound(std::size_t index) noexcept
+    {
+        return index + 1 < BUCKETS ? lower_bound(index + 1) - 1 : MAX_VALUE;
+    }
+};
+
+
+/**
+ * @brief Histogram values at some moment
+ */
+struct histogram_snapshot
+{
+    std::array<std::uint64_t, log_linear::BUCKETS> buckets{};
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+    std::uint64_t max = 0;
+
+    /**
+     * @return mean of recorded values, 0 if nothing recorded
+     */
+    double mean() const noexcept;
+
+    /**
+     * @param quantile - quantile in [0, 1]
+     * @return upper bound of bucket holding quantile, exact maximum for quantile 1, 0 if nothing recorded
+     */
+    std::uint64_t percentile(double quantile) const noexcept;
+
+    /**
+     * @param bound - exclusive bound, exact if it is lower bound of bucket (powers of two are)
+     * @return count of values less than bound
+     */
+    std::uint64_t count_below(std::uint64_t bound) const noexcept;
+};
+
+
+/**
+ * @brief Log-linear histogram of non-negative values. Recording is lock free: relaxed atomic increments only, so
+ * histogram may be recorded from several threads and read concurrently. Snapshot of concurrently recorded
+ * histogram may be inconsistent by values recorded during reading.
+ */
+class histogram
+{
+public:
+    /**
+     * @brief Record value
+     * @param value - value
+     */
+    void record(std::uint64_t value) noexcept
+    {
+        m_buckets[log_linear::bucket(value)].fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+        auto max = m_max.load(std::memory_order_relaxed);
+        while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+        {}
+    }
+
+    /**
+     * @return recorded values
+     */
+    histogram_snapshot snapshot() const noexcept;
+
+private:
+    std::array<std::atomic<std::uint64_t>, log_linear::BUCKETS> m_buckets{};
+    std::atomic<std::uint64_t> m_sum{0};
+    std::atomic<std::uint64_t> m_max{0};
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_HISTOGRAM_H
@@ -3,6 +3,7 @@
 
 #include <socket/proto.h>
 #include <socket/in_address.h>
+#include <socket/native_address.h>
 #include <utils/mbind.h>
 #include <socket_states/active_socket.h>
 
@@ -23,14 +24,63 @@ public:
     std::optional<active_socket_t<Proto>> accept() const
     {
         using utils::mbind;
-        return mbind(
-                derived().m_impl.accept()
-                , [this](std::pair<protei::sock::impl::socket_impl, in_address_port_t>&& accepted)
-                        -> std::optional<active_socket_t<Proto>>
-                {
-                    return active_socket_t<Proto>{std::move(accepted.first), accepted.second, derived().local(), true};
-                });
+        if constexpr (is_native_address_v<Proto>)
+        {
+            proto_address_t<Proto> remote;
+            return mbind(
+                    derived().m_impl.accept(remote)
+                    , [this, &remote](protei::sock::impl::socket_impl&& accepted)
+                            -> std::optional<active_socket_t<Proto>>
+                    {
+                        return active_socket_t<Proto>{std::move(accepted), remote, derived().local(), true};
+                    });
+        }
+        else
+        {
+            return mbind(
+                    derived().m_impl.accept()
+                    , [this](std::pair<protei::sock::impl::socket_impl, in_address_port_t>&& accepted)
+                            -> std::optional<active_socket_t<Proto>>
+                    {
+                        return active_socket_t<Proto>{
+                                std::move(accepted.first), accepted.second, derived().local(), true};
+                    });
+        }
     }
+
+    /**
+     * @brief Take connection accepted from this socket elsewhere, e.g. by io_uring multishot accept. Unlike adopt only
+     * remote address is queried: descriptor must be accepted with SOCK_NONBLOCK
+     * @param fd - accepted descriptor, closed on failure
+     * @return active_socket_t instance, std::nullopt if peer has already reset connection
+     */
+    std::optional<active_socket_t<Proto>> accepted(int fd) const
+    {
+        using utils::mbind;
+        if constexpr (is_native_address_v<Proto>)
+        {
+            proto_address_t<Proto> remote;
+            return mbind(
+                    derived().m_impl.accepted(fd, remote)
+                    , [this, &remote](protei::sock::impl::socket_impl&& accepted)
+                            -> std::optional<active_socket_t<Proto>>
+                    {
+                        return active_socket_t<Proto>{std::move(accepted), remote, derived().local(), true};
+                    });
+        }
+        else
+        {
+            return mbind(
+                    derived().m_impl.accepted(fd)
+                    , [this](std::pair<protei::sock::impl::socket_impl, in_address_port_t>&& accepted)
+                            -> std::optional<active_socket_t<Proto>>
+                    {
+                        return active_socket_t<Proto>{
+                                std::move(accepted.first), accepted.second, derived().local(), true};
+                    });
+        }
+    }
+
 private:
     D<Proto> const& derived() const noexcept
     {
@@ -3,6 +3,7 @@
 
 #include <socket/proto.h>
 #include <socket/in_address.h>
+#include <socket/unix_address.h>
 #include <socket_states/active_socket.h>
 #include <socket_states/binded_socket.h>
 
@@ -20,7 +21,7 @@ template <template <typename> typename D, typename Proto, typename = void>
 struct bind_policy
 {
 public:
-    std::optional<binded_socket_t<Proto>> bind(in_address_port_t const& local) noexcept
+    std::optional<binded_socket_t<Proto>> bind(proto_address_t<Proto> const& local) noexcept
     {
         auto& der = derived();
         if (der.m_impl.bind(local))
@@ -50,7 +51,7 @@ template <template <typename> typename D, typename Proto>
 struct bind_policy<D, Proto, is_connectionless_t<Proto>>
 {
 public:
-    std::optional<active_socket_t<Proto>> bind(in_address_port_t const& local) noexcept
+    std::optional<active_socket_t<Proto>> bind(proto_address_t<Proto> const& local) noexcept
     {
         auto& der = derived();
         if (der.m_impl.bind(local))
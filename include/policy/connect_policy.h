@@ -3,6 +3,7 @@
 
 #include <socket/proto.h>
 #include <socket/in_address.h>
+#include <socket/unix_address.h>
 #include <socket_states/active_socket.h>
 
 #include <type_traits>
@@ -11,11 +12,12 @@ namespace protei::sock::policies
 {
 
 /**
- * @brief Connect policy for connection based protocols
+ * @brief Connect policy. For connection based protocols establishes connection, for connectionless protocols sets
+ * default destination, so datagrams from other peers are filtered by kernel.
  * @tparam D - derived type
  * @tparam Proto - protocol type
  */
-template <template <typename> typename D, typename Proto, typename = void>
+template <template <typename> typename D, typename Proto>
 struct connect_policy
 {
     template <typename T, typename = void>
@@ -23,7 +25,7 @@ struct connect_policy
     template <typename T>
     struct has_local_addr<T, std::void_t<decltype(T::m_local)>> : std::true_type {};
 public:
-    std::optional<active_socket_t<Proto>> connect(in_address_port_t const& remote) noexcept
+    std::optional<active_socket_t<Proto>> connect(proto_address_t<Proto> const& remote) noexcept
     {
         auto& der = derived();
         if (der.m_impl.connect(remote))
@@ -50,16 +52,6 @@ private:
     }
 };
 
-
-/**
- * @brief Connect policy for connectionless protocols
- * @tparam D - derived type
- * @tparam Proto - protocol type
- */
-template <template <typename> typename D, typename Proto>
-struct connect_policy<D, Proto, is_connectionless_t<Proto>>
-{};
-
 }
 
 #endif //PROTEI_TEST_TASK_CONNECTION_POLICY_H
@@ -0,0 +1,69 @@
+#ifndef PROTEI_TEST_TASK_FD_PASSING_POLICY_H
+#define PROTEI_TEST_TASK_FD_PASSING_POLICY_H
+
+#include <socket/proto.h>
+
+#include <optional>
+#include <type_traits>
+
+namespace protei::sock::policies
+{
+
+/**
+ * @brief File descriptors passing policy for internet protocols
+ * @tparam D - derived type
+ * @tparam Proto - protocol type
+ */
+template <template <typename> typename D, typename Proto, typename = void>
+struct fd_passing_policy
+{};
+
+
+/**
+ * @brief File descriptors passing policy for unix domain protocols (SCM_RIGHTS)
+ * @tparam D - derived type
+ * @tparam Proto - protocol type
+ */
+template <template <typename> typename D, typename Proto>
+struct fd_passing_policy<D, Proto, is_local_t<Proto>>
+{
+public:
+    /**
+     * @brief Send data with file descriptors. Descriptors are duplicated into peer process, caller still owns them
+     * @param buffer - data, at least one byte for stream protocol
+     * @param size - data size
+     * @param fds - file descriptors
+     * @param fds_count - file descriptors count, up to socket_impl::MAX_PASSED_FDS
+     * @return bytes sent count, if nothing sent returns std::nullopt
+     */
+    std::optional<std::size_t> send_fds(void* buffer, std::size_t size, int const* fds, std::size_t fds_count) noexcept
+    {
+        return derived().m_impl.send_fds(buffer, size, fds, fds_count);
+    }
+
+    /**
+     * @brief Receive data with file descriptors. Received descriptors are owned by caller and have close-on-exec flag.
+     * Descriptors beyond fds buffer capacity are closed
+     * @param buffer - buffer
+     * @param size - buffer size
+     * @param fds - buffer for file descriptors
+     * @param fds_count - in: fds buffer capacity, out: received file descriptors count
+     * @return bytes received count, if nothing received or descriptors were truncated by kernel (EMSGSIZE) returns
+     * std::nullopt
+     */
+    std::optional<std::size_t> receive_fds(void* buffer, std::size_t size, int* fds, std::size_t& fds_count) noexcept
+    {
+        return derived().m_impl.receive_fds(buffer, size, fds, fds_count);
+    }
+
+private:
+    D<Proto>& derived() noexcept
+    {
+        static_assert(std::is_base_of_v<fd_passing_policy, D<Proto>>);
+        return static_cast<D<Proto>&>(*this);
+    }
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_FD_PASSING_POLICY_H
@@ -0,0 +1,125 @@
+#ifndef PROTEI_TEST_TASK_MULTICAST_POLICY_H
+#define PROTEI_TEST_TASK_MULTICAST_POLICY_H
+
+#include <socket/proto.h>
+#include <socket/in_address.h>
+
+#include <type_traits>
+
+namespace protei::sock::policies
+{
+
+/**
+ * @brief Multicast policy for connection based protocols
+ * @tparam D - derived type
+ * @tparam Proto - protocol type
+ */
+template <template <typename> typename D, typename Proto, typename = void>
+struct multicast_policy
+{};
+
+
+/**
+ * @brief Multicast policy for connectionless protocols
+ * @tparam D - derived type
+ * @tparam Proto - protocol type
+ */
+template <template <typename> typename D, typename Proto>
+struct multicast_policy<D, Proto, is_connectionless_t<Proto>>
+{
+public:
+    /**
+     * @brief Join multicast group
+     * @param group - group address
+     * @param if_index - interface index, 0 for default interface
+     * @return true if succeed
+     */
+    bool join_group(in_address_t const& group, unsigned if_index = 0) noexcept
+    {
+        return derived().m_impl.multicast_membership(group, nullptr, if_index, true);
+    }
+
+    /**
+     * @brief Join multicast group on interface with address. IPv4 only
+     * @param group - group address
+     * @param iface - interface address
+     * @return true if succeed
+     */
+    bool join_group(in_address_t const& group, in_address_t const& iface) noexcept
+    {
+        return derived().m_impl.multicast_membership(group, &iface, 0, true);
+    }
+
+    /**
+     * @brief Leave multicast group
+     * @param group - group address
+     * @param if_index - interface index, 0 for default interface
+     * @return true if succeed
+     */
+    bool leave_group(in_address_t const& group, unsigned if_index = 0) noexcept
+    {
+        return derived().m_impl.multicast_membership(group, nullptr, if_index, false);
+    }
+
+    /**
+     * @brief Leave multicast group on interface with address. IPv4 only
+     * @param group - group address
+     * @param iface - interface address
+     * @return true if succeed
+     */
+    bool leave_group(in_address_t const& group, in_address_t const& iface) noexcept
+    {
+        return derived().m_impl.multicast_membership(group, &iface, 0, false);
+    }
+
+    /**
+     * @brief Enable or disable loopback of sent multicast datagrams to local receivers
+     * @param enable - loopback flag
+     * @return true if succeed
+     */
+    bool set_multicast_loop(bool enable) noexcept
+    {
+        return derived().m_impl.set_multicast_loop(enable);
+    }
+
+    /**
+     * @brief Set TTL (hop limit for IPv6) of sent multicast datagrams
+     * @param ttl - time to live
+     * @return true if succeed
+     */
+    bool set_multicast_ttl(unsigned ttl) noexcept
+    {
+        return derived().m_impl.set_multicast_ttl(ttl);
+    }
+
+    /**
+     * @brief Set outgoing interface for multicast datagrams
+     * @param if_index - interface index, 0 for default interface
+     * @return true if succeed
+     */
+    bool set_multicast_interface(unsigned if_index) noexcept
+    {
+        return derived().m_impl.set_multicast_interface(nullptr, if_index);
+    }
+
+    /**
+     * @brief Set outgoing interface for multicast datagrams by its address. IPv4 only
+     * @param iface - interface address
+     * @return true if succeed
+     */
+    bool set_multicast_interface(in_address_t const& iface) noexcept
+    {
+        return derived().m_impl.set_multicast_interface(&iface, 0);
+    }
+
+private:
+    D<Proto>& derived() noexcept
+    {
+        static_assert(std::is_base_of_v<multicast_policy, D<Proto>>);
+        return static_cast<D<Proto>&>(*this);
+    }
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_MULTICAST_POLICY_H
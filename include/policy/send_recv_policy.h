@@ -3,6 +3,10 @@
 
 #include <socket/proto.h>
 #include <socket/in_address.h>
+#include <socket/native_address.h>
+#include <socket/socket_impl.h>
+#include <buffer/iobuf.h>
+#include <utils/mbind.h>
 
 #include <type_traits>
 #include "socket_states/active_socket.h"
@@ -25,6 +29,17 @@ public:
         return derived().m_impl.send(buffer, size, flags);
     }
 
+    /**
+     * @brief Gather send of buffer chain, no data is copied. Sends at most impl::socket_impl::MAX_SLICES ranges of
+     * chain, so sent bytes should be consumed from chain and send repeated until chain is empty
+     */
+    std::optional<std::size_t> send(buffer::iobuf const& buf, int flags) noexcept
+    {
+        buffer::io_slice slices[impl::socket_impl::MAX_SLICES];
+        auto count = buf.to_slices(slices, impl::socket_impl::MAX_SLICES);
+        return derived().m_impl.send(slices, count, flags);
+    }
+
     std::optional<std::size_t> receive(void* buffer, std::size_t size, int flags) noexcept
     {
         return derived().m_impl.receive(buffer, size, flags);
@@ -54,14 +69,112 @@ template <template <typename> typename D, typename Proto>
 struct send_recv_policy<D, Proto, is_connectionless_t<Proto>>
 {
 public:
-    std::optional<std::size_t> send(in_address_port_t remote, void* buffer, std::size_t size, int flags) noexcept
+    /**
+     * @brief Set default destination. After that kernel drops datagrams from other peers and
+     * send without remote address can be used.
+     * @param remote - remote address
+     * @return true if succeed
+     */
+    bool connect(proto_address_t<Proto> const& remote) noexcept
+    {
+        auto& der = derived();
+        if (der.m_impl.connect(remote))
+        {
+            der.m_remote = remote;
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    std::optional<std::size_t> send(proto_address_t<Proto> remote, void* buffer, std::size_t size, int flags) noexcept
     {
         return derived().m_impl.send_to(remote, buffer, size, flags);
     }
 
-    std::optional<std::pair<in_address_port_t, std::size_t>> receive(void* buffer, std::size_t size, int flags) noexcept
+    /**
+     * @brief Send to remote in native form, no address conversion is performed
+     */
+    std::optional<std::size_t> send(
+            native_address_t const& remote, void* buffer, std::size_t size, int flags) noexcept
+    {
+        return derived().m_impl.send_to(remote, buffer, size, flags);
+    }
+
+    /**
+     * @brief Send to default destination. Socket must be connected.
+     */
+    std::optional<std::size_t> send(void* buffer, std::size_t size, int flags) noexcept
+    {
+        return derived().m_impl.send(buffer, size, flags);
+    }
+
+    /**
+     * @brief Send buffer chain as one datagram, no data is copied. Chain of more than
+     * impl::socket_impl::MAX_SLICES ranges isn't sent
+     */
+    std::optional<std::size_t> send(
+            proto_native_address_t<Proto> const& remote, buffer::iobuf const& buf, int flags) noexcept
+    {
+        buffer::io_slice slices[impl::socket_impl::MAX_SLICES];
+        if (buf.segments() > impl::socket_impl::MAX_SLICES)
+        {
+            return std::nullopt;
+        }
+        return derived().m_impl.send_to(remote, slices, buf.to_slices(slices, impl::socket_impl::MAX_SLICES), flags);
+    }
+
+    /**
+     * @brief Send buffer chain as one datagram to default destination. Socket must be connected.
+     */
+    std::optional<std::size_t> send(buffer::iobuf const& buf, int flags) noexcept
+    {
+        buffer::io_slice slices[impl::socket_impl::MAX_SLICES];
+        if (buf.segments() > impl::socket_impl::MAX_SLICES)
+        {
+            return std::nullopt;
+        }
+        return derived().m_impl.send(slices, buf.to_slices(slices, impl::socket_impl::MAX_SLICES), flags);
+    }
+
+    std::optional<std::pair<proto_address_t<Proto>, std::size_t>> receive(void* buffer, std::size_t size, int flags) noexcept
+    {
+        auto& der = derived();
+        if (der.m_remote)
+        {
+            // connected socket receives datagrams only from remote, no need to parse source address
+            return utils::mbind(
+                    der.m_impl.receive(buffer, size, flags)
+                    , [&der](std::size_t received) -> std::optional<std::pair<proto_address_t<Proto>, std::size_t>>
+                    {
+                        return {{ *der.m_remote, received }};
+                    });
+        }
+        else if constexpr (is_native_address_v<Proto>)
+        {
+            proto_address_t<Proto> remote;
+            return utils::mbind(
+                    der.m_impl.receive_from(buffer, size, flags, remote)
+                    , [&remote](std::size_t received) -> std::optional<std::pair<proto_address_t<Proto>, std::size_t>>
+                    {
+                        return {{ remote, received }};
+                    });
+        }
+        else
+        {
+            return der.m_impl.receive_from(buffer, size, flags);
+        }
+    }
+
+    /**
+     * @brief Receive datagram and its source address in native form, no address conversion is performed
+     */
+    std::optional<std::size_t> receive(
+            void* buffer, std::size_t size, int flags, proto_native_address_t<Proto>& remote) noexcept
     {
-        return derived().m_impl.receive_from(buffer, size, flags);
+        return derived().m_impl.receive_from(buffer, size, flags, remote);
     }
 
 private:
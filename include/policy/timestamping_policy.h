@@ -0,0 +1,127 @@
+#ifndef PROTEI_TEST_TASK_TIMESTAMPING_POLICY_H
+#define PROTEI_TEST_TASK_TIMESTAMPING_POLICY_H
+
+#include <socket/proto.h>
+#include <socket/in_address.h>
+#include <socket/native_address.h>
+#include <socket/timestamp.h>
+#include <utils/mbind.h>
+
+#include <optional>
+#include <type_traits>
+
+namespace protei::sock::policies
+{
+
+/**
+ * @brief Kernel software timestamping policy for internet protocols (SO_TIMESTAMPING)
+ * @tparam D - derived type
+ * @tparam Proto - protocol type
+ */
+template <template <typename> typename D, typename Proto, typename = void>
+struct timestamping_policy
+{
+public:
+    /// bytes received count, with remote address for connectionless protocols
+    using received_t = std::conditional_t<
+            Proto::is_connectionless
+            , std::pair<proto_address_t<Proto>, std::size_t>
+            , std::size_t>;
+
+    /**
+     * @brief Enable software timestamps. TX timestamps are queued to socket error queue, so poll reports error
+     * readiness until it is drained by receive_tx_timestamp: enable them only for sockets polled by owner. Endpoints
+     * enabling them by set_timestamping drain the queue on error readiness, other endpoints treat it as connection
+     * failure
+     * @param rx - timestamp received data
+     * @param tx - timestamp sent data: SCHEDULED and SENT stages, ACKED for stream protocols
+     * @return true if succeed
+     */
+    bool set_timestamping(bool rx, bool tx) noexcept
+    {
+        return derived().m_impl.set_timestamping(rx, tx, !Proto::is_connectionless);
+    }
+
+    /**
+     * @brief Receive with kernel RX timestamp. Stream socket reports timestamp of the last segment data was read from
+     * @param buffer - buffer
+     * @param size - buffer size
+     * @param flags - recvmsg flags
+     * @param ts - receive timestamp, std::nullopt if RX timestamping isn't enabled. Kernel switches stamping on
+     * asynchronously, packets received right after set_timestamping may miss it
+     * @return bytes received count (and remote address), if nothing received returns std::nullopt
+     */
+    std::optional<received_t> receive_timestamped(
+            void* buffer, std::size_t size, int flags, std::optional<timestamp_t>& ts) noexcept
+    {
+        if constexpr (Proto::is_connectionless)
+        {
+            native_address_t remote;
+            return utils::mbind(
+                    derived().m_impl.receive_timestamped(buffer, size, flags, &remote, ts)
+                    , [&remote](std::size_t received)
+                    {
+                        return utils::mbind(
+                                remote.to_in_address_port()
+                                , [received](in_address_port_t const& addr) -> std::optional<received_t>
+                                {
+                                    return {{addr, received}};
+                                });
+                    });
+        }
+        else
+        {
+            return derived().m_impl.receive_timestamped(buffer, size, flags, nullptr, ts);
+        }
+    }
+
+    /**
+     * @brief Receive datagram with kernel RX timestamp, keep source address in native form
+     * @param buffer - buffer
+     * @param size - buffer size
+     * @param flags - recvmsg flags
+     * @param remote - source address
+     * @param ts - receive timestamp, std::nullopt if RX timestamping isn't enabled
+     * @return bytes received count, if nothing received returns std::nullopt
+     */
+    std::optional<std::size_t> receive_timestamped(
+            void* buffer
+            , std::size_t size
+            , int flags
+            , native_address_t& remote
+            , std::optional<timestamp_t>& ts) noexcept
+    {
+        static_assert(Proto::is_connectionless);
+        return derived().m_impl.receive_timestamped(buffer, size, flags, &remote, ts);
+    }
+
+    /**
+     * @brief Read next TX timestamp from socket error queue. Other queued errors are discarded
+     * @return timestamp, std::nullopt if queue is drained
+     */
+    std::optional<tx_timestamp_t> receive_tx_timestamp() noexcept
+    {
+        return derived().m_impl.receive_tx_timestamp();
+    }
+
+private:
+    D<Proto>& derived() noexcept
+    {
+        static_assert(std::is_base_of_v<timestamping_policy, D<Proto>>);
+        return static_cast<D<Proto>&>(*this);
+    }
+};
+
+
+/**
+ * @brief Timestamping policy for unix domain protocols, SO_TIMESTAMPING isn't supported
+ * @tparam D - derived type
+ * @tparam Proto - protocol type
+ */
+template <template <typename> typename D, typename Proto>
+struct timestamping_policy<D, Proto, is_local_t<Proto>>
+{};
+
+}
+
+#endif //PROTEI_TEST_TASK_TIMESTAMPING_POLICY_H
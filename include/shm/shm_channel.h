@@ -0,0 +1,109 @@
+#ifndef PROTEI_TEST_TASK_SHM_CHANNEL_H
+#define PROTEI_TEST_TASK_SHM_CHANNEL_H
+
+#include <shm/spsc_ring.h>
+
+#include <array>
+#include <optional>
+
+namespace protei::shm
+{
+
+/**
+ * @brief Bidirectional shared memory channel: ring and two eventfds per direction. Peer is woken up only when message
+ * is pushed to drained ring or popped from ring it found full, so steady flow of messages costs no syscalls.
+ */
+class shm_channel
+{
+public:
+    /// file descriptors passed to peer on handshake
+    static constexpr std::size_t FDS_COUNT = 6;
+    using fds_t = std::array<int, FDS_COUNT>;
+
+    /**
+     * @brief Factory method. Creates rings and eventfds
+     * @param capacity - ring size of each direction in bytes
+     * @return shm_channel instance if construction succeeds
+     */
+    static std::optional<shm_channel> create(std::size_t capacity) noexcept;
+
+    /**
+     * @brief Factory method. Creates peer's end of channel from descriptors received on handshake
+     * @param fds - descriptors returned by peer_fds() of other end, ownership is taken
+     * @param fds_count - received descriptors count
+     * @return shm_channel instance if descriptors are valid
+     */
+    static std::optional<shm_channel> adopt(int const* fds, std::size_t fds_count) noexcept;
+
+    ~shm_channel();
+
+    shm_channel(shm_channel&&) noexcept;
+    shm_channel& operator=(shm_channel&&) noexcept;
+
+    /**
+     * @return descriptors to be passed to peer. Still owned by channel
+     */
+    fds_t peer_fds() const noexcept;
+
+    /**
+     * @brief Send message to peer
+     * @param buffer - message
+     * @param n - message size
+     * @return bytes sent count, std::nullopt if ring is full: writable_fd becomes readable when peer frees room
+     */
+    std::optional<std::size_t> send(void const* buffer, std::size_t n) noexcept;
+
+    /**
+     * @brief Receive message from peer. Message exceeding buffer is truncated
+     * @param buffer - buffer
+     * @param n - buffer size
+     * @return bytes received count, std::nullopt if there are no messages
+     */
+    std::optional<std::size_t> receive(void* buffer, std::size_t n) noexcept;
+
+    /**
+     * @return true if last send found ring full
+     */
+    bool finished_send() const noexcept;
+
+    /**
+     * @return true if last receive found ring drained
+     */
+    bool finished_recv() const noexcept;
+
+    /**
+     * @return descriptor to be polled for reading, becomes readable when peer sends to drained ring
+     */
+    int event_fd() const noexcept;
+
+    /**
+     * @return descriptor to be polled for reading, becomes readable when peer receives from ring send found full
+     */
+    int writable_fd() const noexcept;
+
+private:
+    shm_channel(
+            spsc_ring&& tx
+            , spsc_ring&& rx
+            , int tx_event
+            , int rx_event
+            , int tx_writable
+            , int rx_writable) noexcept;
+
+    void release() noexcept;
+
+    spsc_ring m_tx;
+    spsc_ring m_rx;
+    int m_tx_event;
+    int m_rx_event;
+    /// read by this end, written by peer on room freed in tx ring
+    int m_tx_writable;
+    /// written by this end on room freed in rx ring
+    int m_rx_writable;
+    bool m_tx_full = false;
+    bool m_rx_drained = false;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_SHM_CHANNEL_H
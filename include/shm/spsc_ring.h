@@ -0,0 +1,103 @@
+#ifndef PROTEI_TEST_TASK_SPSC_RING_H
+#define PROTEI_TEST_TASK_SPSC_RING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace protei::shm
+{
+
+/**
+ * @brief Single producer single consumer ring of messages placed in shared memory (memfd). Producer and consumer may
+ * live in different processes, each one maps ring by file descriptor.
+ */
+class spsc_ring
+{
+public:
+    /**
+     * @brief Push result
+     */
+    enum class push_status
+    {
+        /// no room for message
+        FULL,
+        /// message pushed, consumer is still draining the ring
+        PUSHED,
+        /// message pushed to drained ring, consumer should be woken up
+        NOTIFY
+    };
+
+    /**
+     * @brief Factory method. Creates memfd and maps it
+     * @param capacity - ring size in bytes, rounded up to power of 2
+     * @return spsc_ring instance if construction succeeds
+     */
+    static std::optional<spsc_ring> create(std::size_t capacity) noexcept;
+
+    /**
+     * @brief Factory method. Maps ring created by other process
+     * @param fd - ring file descriptor, ownership is taken even if attaching failed
+     * @return spsc_ring instance if fd is valid ring
+     */
+    static std::optional<spsc_ring> attach(int fd) noexcept;
+
+    ~spsc_ring();
+
+    spsc_ring(spsc_ring&&) noexcept;
+    spsc_ring& operator=(spsc_ring&&) noexcept;
+
+    /**
+     * @brief Push message. Producer only. If ring is full, consumer is asked to report freed room by
+     * take_producer_wakeup
+     * @param data - message
+     * @param size - message size
+     * @return push status
+     */
+    push_status push(void const* data, std::size_t size) noexcept;
+
+    /**
+     * @brief Pop message. Consumer only. Message exceeding buffer is truncated
+     * @param buffer - buffer
+     * @param size - buffer size
+     * @return copied bytes count, std::nullopt if ring is empty
+     */
+    std::optional<std::size_t> pop(void* buffer, std::size_t size) noexcept;
+
+    /**
+     * @brief Consumer only, to be called after pop. Producer, that found ring full, waits for room: report it once
+     * @return true if producer should be woken up
+     */
+    bool take_producer_wakeup() noexcept;
+
+    /**
+     * @return true if ring is empty
+     */
+    bool empty() const noexcept;
+
+    /**
+     * @return ring size in bytes
+     */
+    std::size_t capacity() const noexcept;
+
+    /**
+     * @return ring file descriptor
+     */
+    int fd() const noexcept;
+
+private:
+    struct header;
+
+    spsc_ring(int fd, void* mapping, std::size_t mapping_size) noexcept;
+
+    void release() noexcept;
+
+    int m_fd;
+    header* m_header;
+    std::byte* m_data;
+    std::size_t m_mapping_size;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_SPSC_RING_H
@@ -0,0 +1,14 @@
+#ifndef PROTEI_TEST_TASK_AF_UNIX_H
+#define PROTEI_TEST_TASK_AF_UNIX_H
+
+namespace protei::sock
+{
+
+struct local
+{
+    operator int() noexcept;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_AF_UNIX_H
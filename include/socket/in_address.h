@@ -2,6 +2,7 @@
 #define PROTEI_TEST_TASK_IN_ADDRESS_H
 
 #include <array>
+#include <cstddef>
 #include <string>
 #include <optional>
 
@@ -65,6 +66,11 @@ public:
      */
     bytes_t bytes() const noexcept;
 
+    /**
+     * @return significant address bytes count (4 for IPv4, 16 for IPv6)
+     */
+    std::size_t size() const noexcept;
+
 private:
     static constexpr unsigned MAX_IP4_STR_LEN = 16;
     static constexpr unsigned MAX_IP6_STR_LEN = 46;
@@ -79,6 +85,13 @@ private:
 };
 
 
+/**
+ * @brief Compare addresses. Only significant for address family bytes are compared
+ */
+bool operator==(in_address_t const& lhs, in_address_t const& rhs) noexcept;
+bool operator!=(in_address_t const& lhs, in_address_t const& rhs) noexcept;
+
+
 /**
  * @brief Address with port
  */
@@ -88,6 +101,18 @@ struct in_address_port_t
     std::uint_fast16_t port;
 };
 
+bool operator==(in_address_port_t const& lhs, in_address_port_t const& rhs) noexcept;
+bool operator!=(in_address_port_t const& lhs, in_address_port_t const& rhs) noexcept;
+
+
+/**
+ * @brief Address with port hasher
+ */
+struct in_address_port_hash
+{
+    std::size_t operator()(in_address_port_t const& addr) const noexcept;
+};
+
 }
 
 #endif //PROTEI_TEST_TASK_IN_ADDRESS_H
@@ -0,0 +1,128 @@
+#ifndef PROTEI_TEST_TASK_NATIVE_ADDRESS_H
+#define PROTEI_TEST_TASK_NATIVE_ADDRESS_H
+
+#include <socket/in_address.h>
+#include <socket/unix_address.h>
+#include <socket/proto.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+
+namespace protei::sock
+{
+
+namespace impl
+{
+class socket_impl;
+}
+
+/**
+ * @brief Internet address with port stored in native (sockaddr) form. Passed to kernel as is, so sending and
+ * receiving datagrams don't convert addresses. Cheap to compare and hash, can be used as map key.
+ */
+class native_address_t
+{
+    friend class impl::socket_impl;
+public:
+    /// sizeof(sockaddr_in6), the biggest of supported sockaddr types
+    static constexpr std::size_t MAX_SOCKADDR_LEN = 28;
+
+    /**
+     * @brief Ctor. Creates empty address
+     */
+    native_address_t() noexcept;
+
+    /**
+     * @brief Ctor
+     * @param addr - address with port
+     */
+    explicit native_address_t(in_address_port_t const& addr) noexcept;
+
+    /**
+     * @return address with port, std::nullopt if address is empty
+     */
+    std::optional<in_address_port_t> to_in_address_port() const;
+
+    /**
+     * @return address family, AF_UNSPEC for empty address
+     */
+    int family() const noexcept;
+
+    /**
+     * @return port
+     */
+    std::uint_fast16_t port() const noexcept;
+
+    /**
+     * @return true if address is empty
+     */
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    bool operator==(native_address_t const& other) const noexcept
+    {
+        return m_size == other.m_size && 0 == std::memcmp(m_storage.data(), other.m_storage.data(), m_size);
+    }
+
+    bool operator!=(native_address_t const& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * @brief Hasher
+     */
+    struct hash
+    {
+        std::size_t operator()(native_address_t const& addr) const noexcept
+        {
+            // family, port and IPv4 address fit first word, IPv6 address is in the following ones
+            std::uint64_t words[MAX_SOCKADDR_LEN / sizeof(std::uint64_t) + 1] = {};
+            std::memcpy(words, addr.m_storage.data(), addr.m_size);
+            std::uint64_t h = words[0] ^ (words[1] * 0x9e3779b97f4a7c15ull) ^ (words[2] * 0xc2b2ae3d27d4eb4full);
+            h ^= h >> 33u;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33u;
+            return static_cast<std::size_t>(h);
+        }
+    };
+
+private:
+    void normalize() noexcept;
+
+    alignas(std::uint32_t) std::array<std::byte, MAX_SOCKADDR_LEN> m_storage;
+    std::uint32_t m_size;
+};
+
+
+/**
+ * @brief Native form of protocol address. Protocols defining own address_t are expected to store it natively
+ */
+template <typename Proto, typename = void>
+struct proto_native_address
+{
+    using type = native_address_t;
+};
+
+
+template <typename Proto>
+struct proto_native_address<Proto, std::void_t<typename Proto::address_t>>
+{
+    using type = typename Proto::address_t;
+};
+
+
+template <typename Proto>
+using proto_native_address_t = typename proto_native_address<Proto>::type;
+
+template <typename Proto>
+inline constexpr bool is_native_address_v = std::is_same_v<proto_address_t<Proto>, proto_native_address_t<Proto>>;
+
+}
+
+#endif //PROTEI_TEST_TASK_NATIVE_ADDRESS_H
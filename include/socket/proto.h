@@ -6,6 +6,9 @@
 namespace protei::sock
 {
 
+struct in_address_port_t;
+class unix_address_t;
+
 struct tcp
 {
     static constexpr bool is_connectionless = false;
@@ -20,6 +23,22 @@ struct udp
 };
 
 
+struct unix_stream
+{
+    static constexpr bool is_connectionless = false;
+    using address_t = unix_address_t;
+    explicit operator int() noexcept;
+};
+
+
+struct unix_dgram
+{
+    static constexpr bool is_connectionless = true;
+    using address_t = unix_address_t;
+    explicit operator int() noexcept;
+};
+
+
 template <typename Proto, typename = void>
 struct has_flags : std::false_type
 {};
@@ -30,12 +49,38 @@ struct has_flags<Proto, std::void_t<decltype(Proto::flags)>> : std::true_type
 {};
 
 
+/**
+ * @brief Address type of protocol. Internet address with port unless protocol defines address_t
+ */
+template <typename Proto, typename = void>
+struct proto_address
+{
+    using type = in_address_port_t;
+};
+
+
+template <typename Proto>
+struct proto_address<Proto, std::void_t<typename Proto::address_t>>
+{
+    using type = typename Proto::address_t;
+};
+
+
 template <typename T>
 using is_connectionless_t = std::void_t<decltype(std::declval<char[T::is_connectionless]>())>;
 
+template <typename T>
+using is_local_t = std::enable_if_t<std::is_same_v<typename proto_address<T>::type, unix_address_t>>;
+
 template <typename T>
 inline constexpr bool has_flags_v = has_flags<T>::value;
 
+template <typename Proto>
+using proto_address_t = typename proto_address<Proto>::type;
+
+template <typename T>
+inline constexpr bool is_local_v = std::is_same_v<proto_address_t<T>, unix_address_t>;
+
 }
 
 #endif //PROTEI_TEST_TASK_PROTO_H
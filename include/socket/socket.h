@@ -5,6 +5,7 @@
 #include <policy/accept_policy.h>
 #include <policy/connect_policy.h>
 #include <policy/bind_policy.h>
+#include <policy/multicast_policy.h>
 #include <socket_states/binded_socket.h>
 #include <socket_states/active_socket.h>
 #include <socket_states/listening_socket.h>
@@ -21,11 +22,13 @@ template <typename Proto>
 class socket_t :
         public policies::connect_policy<socket_t, Proto>,
         public policies::bind_policy<socket_t, Proto>,
+        public policies::multicast_policy<socket_t, Proto>,
         public get_native_handle<socket_t<Proto>>
 {
     friend class get_native_handle<socket_t<Proto>>;
     friend class policies::connect_policy<socket_t, Proto>;
     friend class policies::bind_policy<socket_t, Proto>;
+    friend class policies::multicast_policy<socket_t, Proto>;
 public:
     /**
      * @brief Factory method for noexcept construction.
@@ -35,6 +38,13 @@ public:
     static std::optional<socket_t> create(int af) noexcept;
     ~socket_t();
 
+    /**
+     * @brief Allow binding to address in use (SO_REUSEADDR). Must be set before bind
+     * @param enable - reuse flag
+     * @return true if succeed
+     */
+    bool set_reuse_address(bool enable) noexcept;
+
     socket_t(socket_t&&) noexcept = default;
     socket_t& operator=(socket_t&&) noexcept = default;
 
@@ -2,13 +2,24 @@
 #define PROTEI_TEST_TASK_SOCKET_IMPL_H
 
 #include <socket/shutdown_dir.h>
+#include <socket/timestamp.h>
 
 #include <optional>
 #include <cstdint>
 
+struct sockaddr_un;
+
 namespace protei::sock
 {
+class in_address_t;
 struct in_address_port_t;
+class native_address_t;
+class unix_address_t;
+}
+
+namespace protei::buffer
+{
+struct io_slice;
 }
 
 namespace protei::sock::impl
@@ -20,6 +31,11 @@ namespace protei::sock::impl
 class socket_impl
 {
 public:
+    /// file descriptors count limit of one send_fds/receive_fds call
+    static constexpr std::size_t MAX_PASSED_FDS = 64;
+    /// slices count limit of one gather send call
+    static constexpr std::size_t MAX_SLICES = 64;
+
     socket_impl() noexcept = default;
     socket_impl(int fd, int fam) noexcept;
     socket_impl(socket_impl&&) noexcept;
@@ -28,18 +44,66 @@ public:
     bool empty() const noexcept;
 
     bool open(int fam, int proto, int flags) noexcept;
+    bool adopt(int fd, int proto, bool local) noexcept;
+    bool set_nonblocking() noexcept;
+    bool listening() const noexcept;
     bool shutdown(shutdown_dir dir) noexcept;
     bool close() noexcept;
     bool bind(in_address_port_t const& local) noexcept;
     bool connect(in_address_port_t const& remote) noexcept;
+    bool bind(unix_address_t const& local) noexcept;
+    bool connect(unix_address_t const& remote) noexcept;
     bool listen(unsigned max_conn) noexcept;
     std::optional<std::pair<socket_impl, in_address_port_t>> accept() const;
+    std::optional<socket_impl> accept(unix_address_t& remote) const;
+    std::optional<std::pair<socket_impl, in_address_port_t>> accepted(int fd) const;
+    std::optional<socket_impl> accepted(int fd, unix_address_t& remote) const noexcept;
     std::optional<std::size_t> send(void* buffer, std::size_t n, int flags) noexcept;
     std::optional<std::size_t> send_to(
             in_address_port_t const& remote, void* buffer, std::size_t n, int flags) noexcept;
+    std::optional<std::size_t> send_to(
+            native_address_t const& remote, void* buffer, std::size_t n, int flags) noexcept;
+    std::optional<std::size_t> send_to(
+            unix_address_t const& remote, void* buffer, std::size_t n, int flags) noexcept;
+    std::optional<std::size_t> send(buffer::io_slice const* slices, std::size_t count, int flags) noexcept;
+    std::optional<std::size_t> send_to(
+            native_address_t const& remote, buffer::io_slice const* slices, std::size_t count, int flags) noexcept;
+    std::optional<std::size_t> send_to(
+            unix_address_t const& remote, buffer::io_slice const* slices, std::size_t count, int flags) noexcept;
     std::optional<std::size_t> receive(void* buffer, std::size_t n, int flags) noexcept;
     std::optional<std::pair<in_address_port_t, std::size_t>> receive_from(
             void* buffer, std::size_t n, int flags);
+    std::optional<std::size_t> receive_from(
+            void* buffer, std::size_t n, int flags, native_address_t& remote) noexcept;
+    std::optional<std::size_t> receive_from(
+            void* buffer, std::size_t n, int flags, unix_address_t& remote) noexcept;
+
+    std::optional<std::size_t> receive_timestamped(
+            void* buffer
+            , std::size_t n
+            , int flags
+            , native_address_t* remote
+            , std::optional<timestamp_t>& ts) noexcept;
+    std::optional<tx_timestamp_t> receive_tx_timestamp() noexcept;
+    std::optional<int> pending_error() noexcept;
+
+    std::optional<std::size_t> send_fds(
+            void* buffer, std::size_t n, int const* fds, std::size_t fds_count) noexcept;
+    std::optional<std::size_t> receive_fds(
+            void* buffer, std::size_t n, int* fds, std::size_t& fds_count) noexcept;
+
+    std::optional<in_address_port_t> local_address() const;
+    std::optional<in_address_port_t> remote_address() const;
+    bool local_address(unix_address_t& local) const noexcept;
+    bool remote_address(unix_address_t& remote) const noexcept;
+
+    bool set_reuse_address(bool enable) noexcept;
+    bool set_timestamping(bool rx, bool tx, bool tx_ack) noexcept;
+    bool multicast_membership(
+            in_address_t const& group, in_address_t const* iface, unsigned if_index, bool join) noexcept;
+    bool set_multicast_loop(bool enable) noexcept;
+    bool set_multicast_ttl(unsigned ttl) noexcept;
+    bool set_multicast_interface(in_address_t const* iface, unsigned if_index) noexcept;
 
     bool eagain() const noexcept;
     bool would_block() const noexcept;
@@ -56,13 +120,11 @@ private:
     template <typename Addr>
     static std::optional<in_address_port_t> parse_addr(Addr const& addr, unsigned size);
 
-    template <typename ToSockAddr>
-    std::size_t send_to_impl(
-            in_address_port_t const& remote
-            , void* buffer
-            , std::size_t n
-            , int flags
-            , ToSockAddr f) noexcept;
+    static unsigned sock_addr_un(unix_address_t const& addr, sockaddr_un& sock_addr) noexcept;
+    static void parse_addr(sockaddr_un const& sock_addr, unsigned size, unix_address_t& addr) noexcept;
+
+    std::optional<std::size_t> send_msg(
+            void const* addr, unsigned addr_size, buffer::io_slice const* slices, std::size_t count, int flags) noexcept;
 
     template <typename Addr>
     std::optional<std::pair<in_address_port_t, std::size_t>> recv_from_impl(
@@ -0,0 +1,39 @@
+#ifndef PROTEI_TEST_TASK_TIMESTAMP_H
+#define PROTEI_TEST_TASK_TIMESTAMP_H
+
+#include <chrono>
+#include <cstdint>
+
+namespace protei::sock
+{
+
+/// kernel software timestamp, CLOCK_REALTIME, comparable to std::chrono::system_clock::now()
+using timestamp_t = std::chrono::system_clock::time_point;
+
+/**
+ * @brief Transmit timestamp read from socket error queue
+ */
+struct tx_timestamp_t
+{
+    /**
+     * @brief Point of transmit path timestamp is taken at
+     */
+    enum class stage_t
+    {
+        /// entered packet scheduler
+        SCHEDULED
+        /// handed to device driver
+        , SENT
+        /// all data acknowledged by peer, stream protocols only
+        , ACKED
+    };
+
+    timestamp_t time;
+    stage_t stage;
+    /// datagram counter for datagram protocols, offset of send call's last byte for stream ones, both start at 0
+    std::uint32_t id;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_TIMESTAMP_H
@@ -0,0 +1,93 @@
+#ifndef PROTEI_TEST_TASK_UNIX_ADDRESS_H
+#define PROTEI_TEST_TASK_UNIX_ADDRESS_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <optional>
+
+namespace protei::sock
+{
+
+namespace impl
+{
+class socket_impl;
+}
+
+/**
+ * @brief Unix domain socket address. Either filesystem path or name in abstract namespace. String form of abstract
+ * name starts with '@', the rest is the name itself. Default constructed address is unnamed.
+ */
+class unix_address_t
+{
+    friend class impl::socket_impl;
+public:
+    /// sizeof(sockaddr_un::sun_path)
+    static constexpr std::size_t MAX_PATH_LEN = 108;
+
+    /**
+     * @brief Factory method for noexcept construction.
+     * @param name - filesystem path or '@' prefixed abstract name
+     * @return unix_address_t instance if name fits sockaddr_un
+     */
+    static std::optional<unix_address_t> create(std::string const& name) noexcept;
+
+    /**
+     * @brief Ctor. Creates unnamed address
+     */
+    unix_address_t() noexcept;
+
+    /**
+     * @brief Ctor
+     * @param name - filesystem path or '@' prefixed abstract name
+     */
+    explicit unix_address_t(std::string const& name);
+
+    /**
+     * @return true if address is in abstract namespace
+     */
+    bool is_abstract() const noexcept
+    {
+        return m_size != 0 && m_path[0] == '\0';
+    }
+
+    /**
+     * @return true if address is unnamed
+     */
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * @return filesystem path or '@' prefixed abstract name, empty string for unnamed address
+     */
+    std::string name() const;
+
+    bool operator==(unix_address_t const& other) const noexcept
+    {
+        return m_size == other.m_size && 0 == std::memcmp(m_path.data(), other.m_path.data(), m_size);
+    }
+
+    bool operator!=(unix_address_t const& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * @brief Hasher
+     */
+    struct hash
+    {
+        std::size_t operator()(unix_address_t const& addr) const noexcept;
+    };
+
+private:
+    std::array<char, MAX_PATH_LEN> m_path;
+    std::uint32_t m_size;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_UNIX_ADDRESS_H
@@ -2,6 +2,9 @@
 #define PROTEI_TEST_TASK_ACTIVE_SOCKET_H
 
 #include <policy/send_recv_policy.h>
+#include <policy/multicast_policy.h>
+#include <policy/fd_passing_policy.h>
+#include <policy/timestamping_policy.h>
 #include <socket/socket_impl.h>
 #include <socket/get_native_handle.h>
 #include <socket/shutdown_dir.h>
@@ -16,10 +19,16 @@ namespace protei::sock
 template <typename Proto>
 class active_socket_t :
         public policies::send_recv_policy<active_socket_t, Proto>,
+        public policies::multicast_policy<active_socket_t, Proto>,
+        public policies::fd_passing_policy<active_socket_t, Proto>,
+        public policies::timestamping_policy<active_socket_t, Proto>,
         public get_native_handle<active_socket_t<Proto>>
 {
     friend class get_native_handle<active_socket_t<Proto>>;
     friend class policies::send_recv_policy<active_socket_t, Proto>;
+    friend class policies::multicast_policy<active_socket_t, Proto>;
+    friend class policies::fd_passing_policy<active_socket_t, Proto>;
+    friend class policies::timestamping_policy<active_socket_t, Proto>;
 public:
     /**
      * @brief ctor
@@ -30,11 +39,21 @@ public:
      */
     active_socket_t(
             impl::socket_impl&& impl
-            , std::optional<in_address_port_t> remote
-            , std::optional<in_address_port_t> local
+            , std::optional<proto_address_t<Proto>> remote
+            , std::optional<proto_address_t<Proto>> local
             , bool accepted = false) noexcept;
     ~active_socket_t();
 
+    /**
+     * @brief Take ownership of socket created elsewhere (inherited, socketpair, passed by SCM_RIGHTS).
+     * Checks socket type and address family, connection based socket must be connected. Switches socket to
+     * non-blocking mode.
+     * @param fd - socket descriptor, is left to caller on failure
+     * @param accepted - accepted by listening socket flag
+     * @return active_socket_t instance if fd is active socket of Proto
+     */
+    static std::optional<active_socket_t> adopt(int fd, bool accepted = false) noexcept;
+
     active_socket_t(active_socket_t&&) noexcept = default;
     active_socket_t& operator=(active_socket_t&&) noexcept = default;
 
@@ -46,12 +65,12 @@ public:
     /**
      * @return remote address
      */
-    std::optional<in_address_port_t> remote() const noexcept;
+    std::optional<proto_address_t<Proto>> remote() const noexcept;
 
     /**
      * @return local address
      */
-    std::optional<in_address_port_t> local() const noexcept;
+    std::optional<proto_address_t<Proto>> local() const noexcept;
 
     /**
      * @brief Shutdown socket
@@ -72,8 +91,8 @@ public:
 
 private:
     impl::socket_impl m_impl;
-    std::optional<in_address_port_t> m_remote;
-    std::optional<in_address_port_t> m_local;
+    std::optional<proto_address_t<Proto>> m_remote;
+    std::optional<proto_address_t<Proto>> m_local;
     bool m_accepted;
 };
 
@@ -29,7 +29,7 @@ public:
      * @param local - local address
      * @param impl - socket implementation
      */
-    binded_socket_t(in_address_port_t local, impl::socket_impl&& impl) noexcept;
+    binded_socket_t(proto_address_t<Proto> local, impl::socket_impl&& impl) noexcept;
     ~binded_socket_t();
 
     binded_socket_t(binded_socket_t&&) noexcept = default;
@@ -38,11 +38,11 @@ public:
     /**
      * @return local address
      */
-    in_address_port_t local() const noexcept;
+    proto_address_t<Proto> local() const noexcept;
 
 private:
     impl::socket_impl m_impl;
-    in_address_port_t m_local;
+    proto_address_t<Proto> m_local;
 };
 
 }
@@ -26,16 +26,25 @@ public:
      * @param local - local address
      * @param impl - socket implementation
      */
-    listening_socket_t(unsigned max_conn, in_address_port_t local, impl::socket_impl&& impl) noexcept;
+    listening_socket_t(unsigned max_conn, proto_address_t<Proto> local, impl::socket_impl&& impl) noexcept;
     ~listening_socket_t();
 
+    /**
+     * @brief Take ownership of listening socket created elsewhere (inherited, passed by systemd or SCM_RIGHTS).
+     * Checks socket type, address family and listening state, switches socket to non-blocking mode.
+     * @param fd - socket descriptor, is left to caller on failure
+     * @param max_conn - incoming connections limit socket was listened with
+     * @return listening_socket_t instance if fd is listening socket of Proto
+     */
+    static std::optional<listening_socket_t> adopt(int fd, unsigned max_conn) noexcept;
+
     listening_socket_t(listening_socket_t&&) noexcept = default;
     listening_socket_t& operator=(listening_socket_t&&) noexcept = default;
 
     /**
      * @return local address
      */
-    in_address_port_t local() const noexcept;
+    proto_address_t<Proto> local() const noexcept;
 
     /**
      * @return incoming connections limit
@@ -44,7 +53,7 @@ public:
 
 private:
     impl::socket_impl m_impl;
-    in_address_port_t m_local;
+    proto_address_t<Proto> m_local;
     unsigned m_max_conn;
 };
 
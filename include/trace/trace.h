@@ -0,0 +1,169 @@
+#ifndef PROTEI_TEST_TASK_TRACE_H
+#define PROTEI_TEST_TASK_TRACE_H
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Record socket operation to trace ring of calling thread. Macro, so descriptor and result expressions aren't
+ * evaluated when tracing is compiled out with PROTEI_NO_TRACE
+ * @param op - trace::op_t
+ * @param fd - file descriptor
+ * @param size - requested bytes
+ * @param ret - operation return, converted by trace::result
+ */
+#ifndef PROTEI_NO_TRACE
+#define PROTEI_TRACE_IO(op, fd, size, ret) ::protei::trace::write(op, fd, size, ::protei::trace::result(ret))
+#else
+#define PROTEI_TRACE_IO(op, fd, size, ret) ((void)0)
+#endif
+
+namespace protei::trace
+{
+
+#ifndef PROTEI_NO_TRACE
+constexpr bool enabled = true;
+#else
+constexpr bool enabled = false;
+#endif
+
+/**
+ * @brief Traced operation
+ */
+enum class op_t : std::uint16_t
+{
+    SEND = 1
+    , SEND_CHAIN
+    , RECV
+    , FINISHED_SEND
+    , FINISHED_RECV
+};
+
+/**
+ * @brief Fixed-size binary trace record, written to dump file as is
+ */
+struct record
+{
+    /// CLOCK_MONOTONIC
+    std::uint64_t timestamp_ns;
+    /// bytes transferred, 0 or 1 for finished_* operations, -errno if nothing was transferred
+    std::int64_t result;
+    /// requested bytes
+    std::uint32_t size;
+    std::int32_t fd;
+    std::uint32_t tid;
+    op_t op;
+    std::uint16_t reserved;
+};
+
+static_assert(sizeof(record) == 32);
+
+/// records kept per thread, older ones are overwritten
+constexpr std::size_t RING_RECORDS = 4096;
+/// threads traced simultaneously, rings of exited threads are reused
+constexpr std::size_t MAX_THREADS = 256;
+
+/**
+ * @brief Dump file header, followed by records
+ */
+struct file_header
+{
+    static constexpr std::array<char, 8> MAGIC{'P', 'R', 'T', 'T', 'R', 'A', 'C', 'E'};
+    static constexpr std::uint32_t VERSION = 1;
+
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t record_size;
+    /// CLOCK_REALTIME - CLOCK_MONOTONIC at dump, converts record timestamps to wall clock
+    std::int64_t realtime_offset_ns;
+    std::uint64_t records;
+};
+
+static_assert(sizeof(file_header) == 32);
+
+/**
+ * @brief Decoded dump
+ */
+struct trace_file
+{
+    file_header header;
+    /// records of all threads ordered by timestamp
+    std::vector<record> records;
+};
+
+/**
+ * @brief Write record to trace ring of calling thread. Lock free, doesn't allocate except the first call in thread
+ * allocates its ring. If all MAX_THREADS rings are owned by live threads record is dropped
+ * @param op - operation
+ * @param fd - file descriptor, -1 if unknown
+ * @param size - requested bytes
+ * @param result - operation result
+ */
+void write(op_t op, int fd, std::size_t size, std::int64_t result) noexcept;
+
+/**
+ * @param ret - send return
+ * @return bytes sent, -errno if nothing was sent
+ */
+inline std::int64_t result(std::optional<std::size_t> const& ret) noexcept
+{
+    return ret ? static_cast<std::int64_t>(*ret) : -errno;
+}
+
+/**
+ * @param ret - recv return
+ * @return bytes received, -errno if nothing was received
+ */
+template <typename Address>
+std::int64_t result(std::optional<std::pair<Address, std::size_t>> const& ret) noexcept
+{
+    return ret ? static_cast<std::int64_t>(ret->second) : -errno;
+}
+
+/**
+ * @param ret - finished_send or finished_recv return
+ * @return 1 if finished, 0 otherwise
+ */
+inline std::int64_t result(bool ret) noexcept
+{
+    return ret;
+}
+
+/**
+ * @brief Dump rings of all threads to memory-mapped file. May be called from any thread while others trace: record
+ * being overwritten during copy is skipped. Async-signal-safe, doesn't allocate
+ * @param path - file path, truncated if exists
+ * @return true for success
+ */
+bool dump(char const* path) noexcept;
+
+/**
+ * @brief Dump rings on SIGSEGV, SIGBUS, SIGILL, SIGFPE and SIGABRT, then let default action terminate process
+ * @param path - dump file path, copied
+ * @return true if handlers are installed
+ */
+bool install_crash_handler(std::string const& path) noexcept;
+
+/**
+ * @brief Read dump file
+ * @param path - file path
+ * @return decoded dump, std::nullopt if file isn't trace dump
+ */
+std::optional<trace_file> load(std::string const& path);
+
+/**
+ * @param op - operation
+ * @return operation name
+ */
+std::string_view to_string(op_t op) noexcept;
+
+}
+
+#endif //PROTEI_TEST_TASK_TRACE_H
@@ -0,0 +1,207 @@
+#ifndef PROTEI_TEST_TASK_FIXED_IO_H
+#define PROTEI_TEST_TASK_FIXED_IO_H
+
+#include <buffer/iobuf.h>
+#include <uring/uring.h>
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace protei::uring
+{
+
+class fixed_io;
+
+/**
+ * @brief Connection's slot in fixed_io: registered file, receive and send buffers in arena. Operations are queued to
+ * ring of fixed_io and completed by its reap. Slot is cleared on destruction: pending receive is cancelled, send in
+ * flight is completed by kernel, data queued after it is dropped. Slot must be destroyed before socket is closed and
+ * before fixed_io. Move only
+ */
+class fixed_slot
+{
+public:
+    fixed_slot(fixed_slot&& other) noexcept;
+    fixed_slot& operator=(fixed_slot&& other) noexcept;
+    ~fixed_slot();
+
+    /**
+     * @brief Queue data to send. Data is copied to slot's send buffer and sent by one operation, data queued while
+     * it is in flight is sent after its completion
+     * @param data - data to send
+     * @param n - data size, at most free space of send buffer is queued
+     * @return queued bytes count, std::nullopt on full send buffer with errno EAGAIN or with errno of failed send
+     */
+    std::optional<std::size_t> send(void const* data, std::size_t n) noexcept;
+
+    /**
+     * @brief Queue buffer chain to send
+     * @param buf - buffer chain, queued bytes should be consumed from it
+     * @return queued bytes count, std::nullopt on full send buffer with errno EAGAIN or with errno of failed send
+     */
+    std::optional<std::size_t> send(buffer::iobuf const& buf) noexcept;
+
+    /**
+     * @brief Take received data. Receive is queued again when all received data is taken
+     * @param data - buffer
+     * @param n - buffer size
+     * @return taken bytes count, 0 on end of stream, std::nullopt with errno EAGAIN if nothing is received yet or
+     * with errno of failed receive
+     */
+    std::optional<std::size_t> recv(void* data, std::size_t n) noexcept;
+
+    /**
+     * @return true if recv doesn't fail with EAGAIN: data, end of stream or error is received
+     */
+    bool readable() const noexcept;
+
+    /**
+     * @return bytes queued to send and not sent yet
+     */
+    std::size_t unsent() const noexcept;
+
+    /**
+     * @return registered file index
+     */
+    unsigned index() const noexcept
+    {
+        return m_index;
+    }
+
+private:
+    friend class fixed_io;
+
+    fixed_slot(fixed_io* io, unsigned index) noexcept;
+
+    fixed_io* m_io;
+    unsigned m_index;
+};
+
+
+/**
+ * @brief Completion based io_uring send/recv path for hot connections. Socket is registered in fixed files table, so
+ * kernel doesn't look up fd table per operation, and each slot has receive and send buffers in one preallocated
+ * arena. Receive is kept queued, send is queued when data is passed, both are submitted in batch by submit or reap,
+ * which is driven by poll of ring's descriptor. Arena can be registered as fixed buffer: then send is zero copy
+ * IORING_OP_SEND_ZC with IORING_RECVSEND_FIXED_BUF (WRITE_FIXED for sockets without zero copy support) and receive is
+ * READ_FIXED, so pages aren't pinned per operation. Not thread safe.
+ */
+class fixed_io
+{
+public:
+    /**
+     * @brief Factory method
+     * @param slots - registered connections limit
+     * @param buffer_size - receive and send buffer size of slot
+     * @param fixed_buffers - register arena as fixed buffer
+     * @return instance, std::nullopt if io_uring or registration isn't supported
+     */
+    static std::optional<fixed_io> create(unsigned slots, std::size_t buffer_size, bool fixed_buffers = false) noexcept;
+
+    fixed_io(fixed_io const&) = delete;
+    fixed_io& operator=(fixed_io const&) = delete;
+
+    /**
+     * @brief Move ctor. Moved instance must have no attached slots
+     */
+    fixed_io(fixed_io&& other) noexcept;
+    fixed_io& operator=(fixed_io&& other) noexcept;
+
+    /**
+     * @brief Dtor. All slots must be destroyed
+     */
+    ~fixed_io();
+
+    /**
+     * @brief Register socket and queue its receive
+     * @param fd - connected socket
+     * @return slot, std::nullopt if there is no free slot
+     */
+    std::optional<fixed_slot> attach(int fd) noexcept;
+
+    /**
+     * @return free slots count. Slot of destroyed fixed_slot is freed when its operations are completed
+     */
+    std::size_t available() const noexcept;
+
+    /**
+     * @param fd - socket
+     * @return true if socket is attached to slot
+     */
+    bool serves(int fd) const noexcept;
+
+    /**
+     * @brief Submit queued operations
+     * @return true for success
+     */
+    bool submit() noexcept;
+
+    /**
+     * @brief Submit queued operations and handle completions: received data is kept by slot until recv, send buffer
+     * is released on send completion (on notification for zero copy send) and data queued after it is sent
+     * @param timeout - time to wait for completion, zero for reaping driven by poll of native_handle()
+     * @return handled completions count
+     */
+    std::size_t reap(std::chrono::milliseconds timeout = std::chrono::milliseconds{0}) noexcept;
+
+    /**
+     * @return ring file descriptor, readable when completions are ready
+     */
+    int native_handle() const noexcept;
+
+private:
+    friend class fixed_slot;
+
+    /**
+     * @brief Operations state of slot
+     */
+    struct slot_state
+    {
+        /// bytes queued to send buffer, first in_flight of them are owned by kernel
+        std::size_t queued = 0;
+        std::size_t in_flight = 0;
+        /// result of send in flight, applied when kernel releases buffer
+        std::size_t sent = 0;
+        /// received bytes not taken yet start at recv_offset of receive buffer
+        std::size_t received = 0;
+        std::size_t recv_offset = 0;
+        bool recv_queued = false;
+        bool end_of_stream = false;
+        /// errno of failed operation, reported by next send or recv
+        int send_error = 0;
+        int recv_error = 0;
+        /// WRITE_FIXED is used, as socket has no zero copy support
+        bool copy_send = false;
+        /// attached socket, -1 after slot destruction
+        int fd = -1;
+        /// operations not completed by kernel, slot is freed after they are
+        unsigned pending = 0;
+    };
+
+    fixed_io(uring_t&& ring, std::size_t buffer_size, bool fixed_buffers) noexcept;
+
+    std::optional<std::size_t> send_space(unsigned index, std::size_t n) noexcept;
+    void commit_send(unsigned index, std::size_t n) noexcept;
+    std::optional<std::size_t> take_received(unsigned index, void* data, std::size_t n) noexcept;
+    bool queue_recv(unsigned index) noexcept;
+    bool flush(unsigned index) noexcept;
+    void complete(completion const& done) noexcept;
+    void detach(unsigned index) noexcept;
+    char* recv_buffer(unsigned index) const noexcept;
+    char* send_buffer(unsigned index) const noexcept;
+
+    uring_t m_ring;
+    std::size_t m_buffer_size;
+    bool m_fixed_buffers;
+    char* m_arena = nullptr;
+    std::size_t m_arena_size = 0;
+    std::vector<slot_state> m_slots;
+    std::vector<unsigned> m_free;
+    std::vector<completion> m_completions;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_FIXED_IO_H
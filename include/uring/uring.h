@@ -0,0 +1,277 @@
+#ifndef PROTEI_TEST_TASK_URING_H
+#define PROTEI_TEST_TASK_URING_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace protei::uring
+{
+
+/**
+ * @brief Completion of submitted operation
+ */
+struct completion
+{
+    std::uint64_t user_data;
+    /// operation result, negative errno on failure
+    int result;
+    /// operation stays armed and produces more completions (multishot)
+    bool more;
+    /// id of provided buffer picked by kernel
+    std::optional<std::uint16_t> buffer;
+    /// zero copy send notification: kernel released send buffer, it may be reused
+    bool notification = false;
+};
+
+
+/**
+ * @brief Registered resources used by operation
+ */
+struct fixed_t
+{
+    /// fd is index in registered files table, kernel doesn't look up process fd table
+    bool file = false;
+    /// data is inside registered buffer, kernel doesn't pin pages per operation
+    bool buffer = false;
+};
+
+
+/**
+ * @brief Linux io_uring over raw syscalls. Submission and completion queues are shared with kernel, so operations
+ * are queued and their results are harvested without syscall per operation. Not thread safe.
+ */
+class uring_t
+{
+public:
+    /**
+     * @brief Factory method for noexcept construction.
+     * @param entries - submission queue size, completion queue is 4 times larger for multishot operations
+     * @return uring_t instance if construction succeeds
+     */
+    static std::optional<uring_t> create(unsigned entries) noexcept;
+
+    /**
+     * @brief Ctor
+     * @param entries - submission queue size, completion queue is 4 times larger for multishot operations
+     */
+    explicit uring_t(unsigned entries);
+    ~uring_t();
+
+    uring_t(uring_t const&) = delete;
+    uring_t& operator=(uring_t const&) = delete;
+
+    uring_t(uring_t&&) noexcept;
+    uring_t& operator=(uring_t&&) noexcept;
+
+    /**
+     * @brief Queue multishot accept: one submission produces completion per accepted connection. Accepted sockets
+     * are non-blocking
+     * @param fd - listening socket
+     * @param user_data - user data of completions
+     * @return true if queued
+     */
+    bool accept_multishot(int fd, std::uint64_t user_data) noexcept;
+
+    /**
+     * @brief Queue multishot recv into buffers picked by kernel from provided buffers group
+     * @param fd - connected socket
+     * @param buffer_group - provided buffers group
+     * @param user_data - user data of completions
+     * @return true if queued
+     */
+    bool recv_multishot(int fd, std::uint16_t buffer_group, std::uint64_t user_data) noexcept;
+
+    /**
+     * @brief Queue send: IORING_OP_SEND, or IORING_OP_SEND_ZC with IORING_RECVSEND_FIXED_BUF when data is inside
+     * registered buffer. Zero copy send completes twice: with result and more flag, then with notification, after
+     * which data may be reused. Sockets without zero copy support (unix domain) fail it with EOPNOTSUPP. Stream
+     * socket send completes when all data is sent or on failure
+     * @param fd - connected socket or registered file index
+     * @param data - data to send
+     * @param n - data size
+     * @param user_data - user data of completion
+     * @param fixed - registered resources used
+     * @return true if queued
+     */
+    bool send(int fd, void const* data, std::size_t n, std::uint64_t user_data, fixed_t fixed = {}) noexcept;
+
+    /**
+     * @brief Queue write: IORING_OP_WRITE or IORING_OP_WRITE_FIXED with fixed buffer. Data is copied to socket
+     * buffer, so it sends registered buffer through sockets without zero copy support
+     * @param fd - connected socket or registered file index
+     * @param data - data to send
+     * @param n - data size
+     * @param user_data - user data of completion
+     * @param fixed - registered resources used
+     * @return true if queued
+     */
+    bool write(int fd, void const* data, std::size_t n, std::uint64_t user_data, fixed_t fixed = {}) noexcept;
+
+    /**
+     * @brief Queue recv: IORING_OP_RECV or IORING_OP_READ_FIXED with fixed buffer, as recv has no fixed buffer
+     * variant. Completes when data arrives
+     * @param fd - connected socket or registered file index
+     * @param data - buffer
+     * @param n - buffer size
+     * @param user_data - user data of completion
+     * @param fixed - registered resources used
+     * @return true if queued
+     */
+    bool recv(int fd, void* data, std::size_t n, std::uint64_t user_data, fixed_t fixed = {}) noexcept;
+
+    /**
+     * @brief Register sparse files table, slots are filled with update_file
+     * @param count - table size
+     * @return true for success
+     */
+    bool register_files(unsigned count) noexcept;
+
+    /**
+     * @brief Set registered files table slot
+     * @param index - slot index
+     * @param fd - file descriptor, -1 to clear slot. Table holds file reference, so file isn't closed with fd until
+     * slot is cleared
+     * @return true for success
+     */
+    bool update_file(unsigned index, int fd) noexcept;
+
+    /**
+     * @brief Register memory as fixed buffer with index 0. Pages are pinned once, for all operations
+     * @param data - memory
+     * @param size - memory size
+     * @return true for success
+     */
+    bool register_buffer(void* data, std::size_t size) noexcept;
+
+    /**
+     * @brief Queue cancellation of operation
+     * @param target - user data of operation to cancel
+     * @param user_data - user data of cancellation completion
+     * @return true if queued
+     */
+    bool cancel(std::uint64_t target, std::uint64_t user_data) noexcept;
+
+    /**
+     * @brief Submit queued operations
+     * @return true for success
+     */
+    bool submit() noexcept;
+
+    /**
+     * @brief Submit queued operations and wait for one completion without timeout
+     * @return completion, std::nullopt on wait failure
+     */
+    std::optional<completion> wait() noexcept;
+
+    /**
+     * @brief Submit queued operations and wait for completions
+     * @param timeout - blocking timeout
+     * @param completions - harvested completions are appended to
+     * @return harvested completions count
+     */
+    std::size_t proceed(std::chrono::milliseconds timeout, std::vector<completion>& completions) noexcept;
+
+    /**
+     * @return ring file descriptor
+     */
+    int native_handle() const noexcept;
+
+private:
+    uring_t() noexcept = default;
+
+    bool setup(unsigned entries) noexcept;
+    void exchange(uring_t&&) noexcept;
+    void unmap() noexcept;
+    void* get_sqe() noexcept;
+    bool queue_rw(int opcode, int fd, void const* data, std::size_t n, std::uint64_t user_data, fixed_t fixed) noexcept;
+    std::size_t harvest(std::vector<completion>& completions) noexcept;
+
+    int m_fd = -1;
+    void* m_sq_ring = nullptr;
+    std::size_t m_sq_ring_size = 0;
+    void* m_cq_ring = nullptr;
+    std::size_t m_cq_ring_size = 0;
+    void* m_sqes = nullptr;
+    std::size_t m_sqes_size = 0;
+
+    std::uint32_t* m_sq_head = nullptr;
+    std::uint32_t* m_sq_tail = nullptr;
+    std::uint32_t* m_sq_flags = nullptr;
+    std::uint32_t m_sq_mask = 0;
+    std::uint32_t m_sq_entries = 0;
+    std::uint32_t* m_cq_head = nullptr;
+    std::uint32_t* m_cq_tail = nullptr;
+    std::uint32_t m_cq_mask = 0;
+    void* m_cqes = nullptr;
+    /// queued but not submitted operations
+    unsigned m_pending = 0;
+};
+
+
+/**
+ * @brief Ring of buffers provided to kernel for operations with buffer selection. Kernel picks buffer on data
+ * arrival, so idle connections don't pin memory. Used buffer must be recycled.
+ */
+class provided_buffers
+{
+public:
+    /**
+     * @brief Factory method. Registers buffer ring in io_uring
+     * @param ring - io_uring, must outlive buffers
+     * @param group - buffers group id used by operations
+     * @param count - buffers count, power of 2 not greater than 32768
+     * @param size - buffer size
+     * @return buffers, std::nullopt if kernel doesn't support buffer rings or arguments are invalid
+     */
+    static std::optional<provided_buffers> create(
+            uring_t& ring
+            , std::uint16_t group
+            , std::uint16_t count
+            , std::uint32_t size) noexcept;
+
+    ~provided_buffers();
+
+    provided_buffers(provided_buffers const&) = delete;
+    provided_buffers& operator=(provided_buffers const&) = delete;
+
+    provided_buffers(provided_buffers&&) noexcept;
+    provided_buffers& operator=(provided_buffers&&) noexcept;
+
+    /**
+     * @param id - buffer id from completion
+     * @return buffer data
+     */
+    char* data(std::uint16_t id) const noexcept;
+
+    /**
+     * @brief Return buffer to kernel
+     * @param id - buffer id from completion
+     */
+    void recycle(std::uint16_t id) noexcept;
+
+    /**
+     * @return buffers group id
+     */
+    std::uint16_t group() const noexcept;
+
+private:
+    provided_buffers() noexcept = default;
+
+    void exchange(provided_buffers&&) noexcept;
+
+    int m_ring_fd = -1;
+    void* m_memory = nullptr;
+    std::size_t m_memory_size = 0;
+    char* m_buffers = nullptr;
+    std::uint32_t m_size = 0;
+    std::uint16_t m_count = 0;
+    std::uint16_t m_tail = 0;
+    std::uint16_t m_group = 0;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_URING_H
@@ -2,6 +2,7 @@
 #define PROTEI_TEST_TASK_ADDRESS_FROM_STRING_H
 
 #include <socket/in_address.h>
+#include <socket/unix_address.h>
 
 namespace protei::utils
 {
@@ -14,6 +15,22 @@ namespace protei::utils
  */
 std::optional<sock::in_address_port_t> from_string_and_port(std::string const& str, std::uint_fast16_t port) noexcept;
 
+/**
+ * @brief Create protocol address from string
+ * @tparam Address - address type
+ * @param str - address string
+ * @param port - port, ignored by addresses without ports
+ * @return created address if string was valid
+ */
+template <typename Address>
+std::optional<Address> address_from_string(std::string const& str, std::uint_fast16_t port) noexcept;
+
+template <>
+std::optional<sock::in_address_port_t> address_from_string(std::string const& str, std::uint_fast16_t port) noexcept;
+
+template <>
+std::optional<sock::unix_address_t> address_from_string(std::string const& str, std::uint_fast16_t port) noexcept;
+
 }
 
 #endif //PROTEI_TEST_TASK_ADDRESS_FROM_STRING_H
@@ -0,0 +1,289 @@
+#ifndef PROTEI_TEST_TASK_FLAT_HASH_MAP_H
+#define PROTEI_TEST_TASK_FLAT_HASH_MAP_H
+
+#include <vector>
+#include <optional>
+#include <utility>
+#include <functional>
+#include <cstdint>
+
+namespace protei::utils
+{
+
+/**
+ * @brief Open-addressing hash map with linear probing and backward shift deletion.
+ * Doesn't allocate while size stays below reserved capacity. References to values are invalidated by
+ * insertion and erasure.
+ * @tparam Key - key type
+ * @tparam Value - value type
+ * @tparam Hash - key hasher
+ * @tparam KeyEqual - key equality predicate
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class flat_hash_map
+{
+public:
+    using value_type = std::pair<Key, Value>;
+
+    /**
+     * @brief Ctor
+     * @param capacity - elements count to reserve space for
+     * @param hash - key hasher
+     * @param equal - key equality predicate
+     */
+    explicit flat_hash_map(std::size_t capacity = 0, Hash hash = Hash{}, KeyEqual equal = KeyEqual{})
+        : m_hash{std::move(hash)}
+        , m_equal{std::move(equal)}
+    {
+        reserve(capacity);
+    }
+
+    /**
+     * @brief Reserve space for elements. Rehashes if needed
+     * @param capacity - elements count
+     */
+    void reserve(std::size_t capacity)
+    {
+        // keep load factor below 3/4
+        std::size_t slots = MIN_SLOTS;
+        while (slots - slots / 4 < capacity)
+        {
+            slots <<= 1u;
+        }
+
+        if (slots > m_slots.size())
+        {
+            rehash(slots);
+        }
+    }
+
+    /**
+     * @brief Find value by key
+     * @param key - key
+     * @return pointer to value or nullptr if not found
+     */
+    Value* find(Key const& key) noexcept
+    {
+        if (auto idx = find_idx(key))
+        {
+            return &m_slots[*idx].kv->second;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Insert value if key not found
+     * @param key - key
+     * @param args - value ctor arguments
+     * @return pointer to value and true if inserted
+     */
+    template <typename... Args>
+    std::pair<Value*, bool> try_emplace(Key const& key, Args&&... args)
+    {
+        if (auto idx = find_idx(key))
+        {
+            return { &m_slots[*idx].kv->second, false };
+        }
+
+        if (m_size + 1 > m_slots.size() - m_slots.size() / 4)
+        {
+            rehash(m_slots.empty() ? MIN_SLOTS : m_slots.size() << 1u);
+        }
+
+        auto hash = m_hash(key);
+        auto idx = hash & mask();
+        while (m_slots[idx].kv)
+        {
+            idx = (idx + 1) & mask();
+        }
+        m_slots[idx].hash = hash;
+        m_slots[idx].kv.emplace(std::piecewise_construct
+                , std::forward_as_tuple(key)
+                , std::forward_as_tuple(std::forward<Args>(args)...));
+        ++m_size;
+        return { &m_slots[idx].kv->second, true };
+    }
+
+    /**
+     * @brief Erase value by key
+     * @param key - key
+     * @return true if erased
+     */
+    bool erase(Key const& key) noexcept
+    {
+        if (auto idx = find_idx(key))
+        {
+            erase_idx(*idx);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Erase all elements satisfying predicate
+     * @param pred - predicate, called with (Key const&, Value&)
+     * @return erased elements count
+     */
+    template <typename Pred>
+    std::size_t erase_if(Pred&& pred)
+    {
+        return erase_if(0, m_slots.size(), std::forward<Pred>(pred));
+    }
+
+    /**
+     * @brief Erase elements satisfying predicate in slots range. Allows incremental sweeping of big maps.
+     * Element moved by erasure from the beginning of table to its end can be visited twice.
+     * @param first - first slot index
+     * @param count - slots count to check
+     * @param pred - predicate, called with (Key const&, Value&)
+     * @return erased elements count
+     */
+    template <typename Pred>
+    std::size_t erase_if(std::size_t first, std::size_t count, Pred&& pred)
+    {
+        std::size_t erased = 0;
+        for (std::size_t i = first; i < m_slots.size() && i < first + count; )
+        {
+            auto& kv = m_slots[i].kv;
+            if (kv && std::invoke(pred, std::as_const(kv->first), kv->second))
+            {
+                // backward shift may move next element to current slot, check it again
+                erase_idx(i);
+                ++erased;
+            }
+            else
+            {
+                ++i;
+            }
+        }
+        return erased;
+    }
+
+    /**
+     * @brief Call function for each element
+     * @param func - function, called with (Key const&, Value&)
+     */
+    template <typename F>
+    void for_each(F&& func)
+    {
+        for (auto& entry: m_slots)
+        {
+            if (entry.kv)
+            {
+                std::invoke(func, std::as_const(entry.kv->first), entry.kv->second);
+            }
+        }
+    }
+
+    /**
+     * @brief Erase all elements. Keeps reserved space
+     */
+    void clear() noexcept
+    {
+        for (auto& entry: m_slots)
+        {
+            entry.kv.reset();
+        }
+        m_size = 0;
+    }
+
+    /**
+     * @return elements count
+     */
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * @return true if no elements
+     */
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * @return slots count
+     */
+    std::size_t slot_count() const noexcept
+    {
+        return m_slots.size();
+    }
+
+private:
+    static constexpr std::size_t MIN_SLOTS = 16;
+
+    struct slot
+    {
+        std::size_t hash;
+        std::optional<value_type> kv;
+    };
+
+    std::size_t mask() const noexcept
+    {
+        return m_slots.size() - 1;
+    }
+
+    std::optional<std::size_t> find_idx(Key const& key) const noexcept
+    {
+        if (m_size == 0)
+        {
+            return std::nullopt;
+        }
+
+        auto hash = m_hash(key);
+        for (auto idx = hash & mask(); m_slots[idx].kv; idx = (idx + 1) & mask())
+        {
+            if (m_slots[idx].hash == hash && m_equal(m_slots[idx].kv->first, key))
+            {
+                return idx;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void erase_idx(std::size_t idx) noexcept
+    {
+        auto hole = idx;
+        for (auto next = (hole + 1) & mask(); m_slots[next].kv; next = (next + 1) & mask())
+        {
+            // element can fill the hole only if its home slot is not in (hole, next]
+            auto home = m_slots[next].hash & mask();
+            if (((next - home) & mask()) >= ((next - hole) & mask()))
+            {
+                m_slots[hole] = std::move(m_slots[next]);
+                hole = next;
+            }
+        }
+        m_slots[hole].kv.reset();
+        --m_size;
+    }
+
+    void rehash(std::size_t slots)
+    {
+        std::vector<slot> old(slots);
+        old.swap(m_slots);
+        for (auto& entry: old)
+        {
+            if (entry.kv)
+            {
+                auto idx = entry.hash & mask();
+                while (m_slots[idx].kv)
+                {
+                    idx = (idx + 1) & mask();
+                }
+                m_slots[idx] = std::move(entry);
+            }
+        }
+    }
+
+    std::vector<slot> m_slots;
+    std::size_t m_size = 0;
+    Hash m_hash;
+    KeyEqual m_equal;
+};
+
+}
+
+#endif //PROTEI_TEST_TASK_FLAT_HASH_MAP_H
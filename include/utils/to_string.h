@@ -7,6 +7,8 @@ namespace protei::sock
 {
 class in_address_t;
 struct in_address_port_t;
+class native_address_t;
+class unix_address_t;
 }
 
 namespace protei::utils
@@ -18,6 +20,8 @@ namespace protei::utils
  */
 std::string to_string(sock::in_address_t addr) noexcept;
 std::string to_string(sock::in_address_port_t addr) noexcept;
+std::string to_string(sock::native_address_t const& addr) noexcept;
+std::string to_string(sock::unix_address_t const& addr) noexcept;
 }
 
 #endif //PROTEI_TEST_TASK_TO_STRING_H
@@ -0,0 +1,90 @@
+#include <buffer/block_pool.h>
+
+#include <cassert>
+#include <new>
+
+namespace protei::buffer
+{
+
+block_pool::block_pool(std::size_t block_size, std::size_t blocks_per_slab)
+    : m_block_size{block_size}
+    // keeps headers of all blocks in slab aligned
+    , m_stride{(sizeof(block) + block_size + alignof(block) - 1) / alignof(block) * alignof(block)}
+    , m_blocks_per_slab{blocks_per_slab ? blocks_per_slab : 1}
+{}
+
+
+block_pool::~block_pool()
+{
+    assert(m_available == allocated() && "block_pool destroyed with blocks in use");
+}
+
+
+block* block_pool::acquire()
+{
+    std::lock_guard lock{m_mutex};
+    if (!m_free)
+    {
+        auto& slab = m_slabs.emplace_back(new std::byte[m_stride * m_blocks_per_slab]);
+        for (std::size_t i = m_blocks_per_slab; i > 0; --i)
+        {
+            auto* blk = new (slab.get() + (i - 1) * m_stride) block{};
+            blk->pool = this;
+            blk->next_free = m_free;
+            m_free = blk;
+        }
+        m_available += m_blocks_per_slab;
+    }
+
+    auto* blk = m_free;
+    m_free = blk->next_free;
+    --m_available;
+    blk->refs.store(1, std::memory_order_relaxed);
+    return blk;
+}
+
+
+void block_pool::retain(block* blk) noexcept
+{
+    blk->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+void block_pool::release(block* blk) noexcept
+{
+    if (blk->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        blk->pool->push_free(blk);
+    }
+}
+
+
+void block_pool::push_free(block* blk) noexcept
+{
+    std::lock_guard lock{m_mutex};
+    blk->next_free = m_free;
+    m_free = blk;
+    ++m_available;
+}
+
+
+std::size_t block_pool::block_size() const noexcept
+{
+    return m_block_size;
+}
+
+
+std::size_t block_pool::allocated() const noexcept
+{
+    std::lock_guard lock{m_mutex};
+    return m_slabs.size() * m_blocks_per_slab;
+}
+
+
+std::size_t block_pool::available() const noexcept
+{
+    std::lock_guard lock{m_mutex};
+    return m_available;
+}
+
+}
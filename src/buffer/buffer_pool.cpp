@@ -0,0 +1,119 @@
+#include <buffer/buffer_pool.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace protei::buffer
+{
+
+static_assert(buffer_pool::class_size(buffer_pool::SIZE_CLASSES - 1) == buffer_pool::MAX_BUFFER_SIZE);
+
+pooled_buffer::pooled_buffer(buffer_pool* pool, char* data, unsigned size_class) noexcept
+    : m_pool{pool}
+    , m_data{data}
+    , m_size_class{size_class}
+{}
+
+
+pooled_buffer::pooled_buffer(pooled_buffer&& other) noexcept
+    : m_pool{other.m_pool}
+    , m_data{other.m_data}
+    , m_size_class{other.m_size_class}
+{
+    other.m_data = nullptr;
+}
+
+
+pooled_buffer& pooled_buffer::operator=(pooled_buffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        m_pool = other.m_pool;
+        m_data = other.m_data;
+        m_size_class = other.m_size_class;
+        other.m_data = nullptr;
+    }
+    return *this;
+}
+
+
+pooled_buffer::~pooled_buffer()
+{
+    release();
+}
+
+
+void pooled_buffer::release() noexcept
+{
+    if (m_data)
+    {
+        m_pool->release(m_data, m_size_class);
+        m_data = nullptr;
+    }
+}
+
+
+std::size_t pooled_buffer::size() const noexcept
+{
+    return m_data ? buffer_pool::class_size(m_size_class) : 0;
+}
+
+
+buffer_pool::buffer_pool(std::size_t slab_size) noexcept
+    : m_slab_size{slab_size}
+{}
+
+
+buffer_pool::~buffer_pool()
+{
+    assert(m_stats.in_use == 0 && "buffer_pool destroyed with borrowed buffers");
+}
+
+
+pooled_buffer buffer_pool::acquire(std::size_t size)
+{
+    if (size > MAX_BUFFER_SIZE)
+    {
+        return {};
+    }
+
+    unsigned size_class = 0;
+    while (class_size(size_class) < size)
+    {
+        ++size_class;
+    }
+
+    auto buffer_size = class_size(size_class);
+    auto& free = m_free[size_class];
+    if (free.empty())
+    {
+        auto count = std::max<std::size_t>(m_slab_size / buffer_size, 1);
+        auto& slab = m_slabs.emplace_back(new char[count * buffer_size]);
+        m_stats.allocated_bytes += count * buffer_size;
+        // free list never grows beyond buffers count, so release doesn't allocate
+        free.reserve(free.capacity() + count);
+        for (std::size_t i = count; i > 0; --i)
+        {
+            free.push_back(slab.get() + (i - 1) * buffer_size);
+        }
+    }
+
+    auto* data = free.back();
+    free.pop_back();
+    ++m_stats.in_use;
+    m_stats.in_use_bytes += buffer_size;
+    m_stats.high_water = std::max(m_stats.high_water, m_stats.in_use);
+    m_stats.high_water_bytes = std::max(m_stats.high_water_bytes, m_stats.in_use_bytes);
+    return {this, data, size_class};
+}
+
+
+void buffer_pool::release(char* data, unsigned size_class) noexcept
+{
+    m_free[size_class].push_back(data);
+    --m_stats.in_use;
+    m_stats.in_use_bytes -= class_size(size_class);
+}
+
+}
@@ -0,0 +1,230 @@
+#include <buffer/iobuf.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace protei::buffer
+{
+
+iobuf::iobuf(block_pool& pool) noexcept
+    : m_pool{&pool}
+{}
+
+
+iobuf::iobuf(iobuf const& other) noexcept
+    : m_pool{other.m_pool}
+    , m_segments{other.m_segments}
+    , m_size{other.m_size}
+{
+    for (auto const& seg: m_segments)
+    {
+        block_pool::retain(seg.blk);
+    }
+}
+
+
+iobuf& iobuf::operator=(iobuf const& other) noexcept
+{
+    if (this != &other)
+    {
+        iobuf copy{other};
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+
+iobuf::iobuf(iobuf&& other) noexcept
+    : m_pool{other.m_pool}
+    , m_segments{std::move(other.m_segments)}
+    , m_size{other.m_size}
+{
+    other.m_segments.clear();
+    other.m_size = 0;
+}
+
+
+iobuf& iobuf::operator=(iobuf&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        m_pool = other.m_pool;
+        m_segments = std::move(other.m_segments);
+        m_size = other.m_size;
+        other.m_segments.clear();
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+
+iobuf::~iobuf()
+{
+    release();
+}
+
+
+void iobuf::append(void const* data, std::size_t n)
+{
+    auto const* bytes = static_cast<char const*>(data);
+    auto block_size = m_pool->block_size();
+    if (!m_segments.empty())
+    {
+        // free space after the last range is owned by chain only if block isn't shared
+        auto& last = m_segments.back();
+        auto end = last.offset + last.size;
+        if (last.blk->refs.load(std::memory_order_acquire) == 1 && end < block_size)
+        {
+            auto chunk = std::min<std::size_t>(n, block_size - end);
+            std::memcpy(last.blk->data() + end, bytes, chunk);
+            last.size += static_cast<std::uint32_t>(chunk);
+            m_size += chunk;
+            bytes += chunk;
+            n -= chunk;
+        }
+    }
+
+    while (n > 0)
+    {
+        auto chunk = std::min(n, block_size);
+        auto* blk = m_pool->acquire();
+        std::memcpy(blk->data(), bytes, chunk);
+        m_segments.push_back({blk, 0, static_cast<std::uint32_t>(chunk)});
+        m_size += chunk;
+        bytes += chunk;
+        n -= chunk;
+    }
+}
+
+
+void iobuf::append(iobuf const& other)
+{
+    // copy first: other may be this chain
+    auto segments = other.m_segments;
+    for (auto const& seg: segments)
+    {
+        block_pool::retain(seg.blk);
+    }
+    m_size += other.m_size;
+    m_segments.insert(m_segments.end(), segments.begin(), segments.end());
+}
+
+
+void iobuf::prepend(void const* data, std::size_t n)
+{
+    assert(n <= m_pool->block_size());
+    if (n == 0)
+    {
+        return;
+    }
+
+    // data is placed at the block end, so block isn't reused by append
+    auto* blk = m_pool->acquire();
+    auto offset = static_cast<std::uint32_t>(m_pool->block_size() - n);
+    std::memcpy(blk->data() + offset, data, n);
+    m_segments.insert(m_segments.begin(), segment{blk, offset, static_cast<std::uint32_t>(n)});
+    m_size += n;
+}
+
+
+iobuf iobuf::slice(std::size_t offset, std::size_t n) const
+{
+    iobuf ret{*m_pool};
+    for (auto const& seg: m_segments)
+    {
+        if (n == 0)
+        {
+            break;
+        }
+        if (offset >= seg.size)
+        {
+            offset -= seg.size;
+            continue;
+        }
+
+        auto size = std::min<std::size_t>(seg.size - offset, n);
+        block_pool::retain(seg.blk);
+        ret.m_segments.push_back({
+                seg.blk
+                , static_cast<std::uint32_t>(seg.offset + offset)
+                , static_cast<std::uint32_t>(size)});
+        ret.m_size += size;
+        n -= size;
+        offset = 0;
+    }
+    return ret;
+}
+
+
+void iobuf::consume(std::size_t n) noexcept
+{
+    n = std::min(n, m_size);
+    m_size -= n;
+    auto it = m_segments.begin();
+    for (; it != m_segments.end() && n >= it->size; ++it)
+    {
+        n -= it->size;
+        block_pool::release(it->blk);
+    }
+    it = m_segments.erase(m_segments.begin(), it);
+    if (n > 0)
+    {
+        it->offset += static_cast<std::uint32_t>(n);
+        it->size -= static_cast<std::uint32_t>(n);
+    }
+}
+
+
+std::size_t iobuf::to_slices(io_slice* slices, std::size_t max_slices) const noexcept
+{
+    auto count = std::min(max_slices, m_segments.size());
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        slices[i] = {m_segments[i].blk->data() + m_segments[i].offset, m_segments[i].size};
+    }
+    return count;
+}
+
+
+void iobuf::copy_to(void* out) const noexcept
+{
+    auto* bytes = static_cast<char*>(out);
+    for (auto const& seg: m_segments)
+    {
+        std::memcpy(bytes, seg.blk->data() + seg.offset, seg.size);
+        bytes += seg.size;
+    }
+}
+
+
+std::size_t iobuf::size() const noexcept
+{
+    return m_size;
+}
+
+
+bool iobuf::empty() const noexcept
+{
+    return m_size == 0;
+}
+
+
+std::size_t iobuf::segments() const noexcept
+{
+    return m_segments.size();
+}
+
+
+void iobuf::release() noexcept
+{
+    for (auto const& seg: m_segments)
+    {
+        block_pool::release(seg.blk);
+    }
+    m_segments.clear();
+    m_size = 0;
+}
+
+}
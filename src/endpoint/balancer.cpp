@@ -0,0 +1,26 @@
+#include <endpoint/balancer.h>
+
+#include <algorithm>
+
+namespace protei::endpoint
+{
+
+std::optional<std::size_t> least_loaded_balancer::operator()(
+        std::vector<std::size_t> const& loads
+        , std::size_t source) const noexcept
+{
+    if (source >= loads.size())
+    {
+        return std::nullopt;
+    }
+
+    auto least = std::min_element(loads.begin(), loads.end());
+    // strict comparison keeps single connection from bouncing between equally loaded reactors
+    if (loads[source] > *least + threshold)
+    {
+        return static_cast<std::size_t>(least - loads.begin());
+    }
+    return std::nullopt;
+}
+
+}
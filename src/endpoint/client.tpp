@@ -27,8 +27,8 @@ bool client_t<Proto, Poll, PollTraits>::start(std::string const& local_address,
 {
     using utils::mbind;
     std::lock_guard lock{m_mutex};
-    std::optional<sock::in_address_port_t> address;
-    if (this->idle() && (address = utils::from_string_and_port(local_address, local_port)))
+    std::optional<sock::proto_address_t<Proto>> address;
+    if (this->idle() && (address = utils::address_from_string<sock::proto_address_t<Proto>>(local_address, local_port)))
     {
         auto sock = mbind(
                 sock::socket_t<Proto>::create(this->af)
@@ -53,10 +53,18 @@ template <typename Proto, typename Poll, typename PollTraits>
 void client_t<Proto, Poll, PollTraits>::stop() noexcept
 {
     std::lock_guard lock{m_mutex};
+    // registered file keeps socket open, so slot is released first
+    m_fixed.reset();
+    if (m_fixed_io)
+    {
+        PollTraits::del_socket(this->poll, m_fixed_io->native_handle());
+        m_fixed_io.reset();
+    }
     PollTraits::del_socket(
             this->poll
             , this->get_fd());
     this->state = std::optional<sock::socket_t<Proto>>{};
+    m_on_tx = nullptr;
     unregister_cbs();
 }
 
@@ -69,7 +77,7 @@ bool client_t<Proto, Poll, PollTraits>::connect(
         , std::function<void()> on_read_ready
         , std::function<void()> on_disconnect) noexcept
 {
-    static const auto set_fields = [&](sock::in_address_port_t addr)
+    auto set_fields = [&](sock::proto_address_t<Proto> addr)
     {
         this->m_remote = addr;
         this->m_on_connect = std::move(on_connect);
@@ -77,9 +85,9 @@ bool client_t<Proto, Poll, PollTraits>::connect(
         this->m_on_disconnect = std::move(on_disconnect);
     };
 
-    static const auto connect = [&](auto&& sock) -> bool
+    auto connect = [&](auto&& sock) -> bool
     {
-        auto parsed = utils::from_string_and_port(remote_address, remote_port);
+        auto parsed = utils::address_from_string<sock::proto_address_t<Proto>>(remote_address, remote_port);
         decltype(sock.connect(*parsed)) connected;
         if (parsed && (connected = sock.connect(*parsed)))
         {
@@ -92,9 +100,19 @@ bool client_t<Proto, Poll, PollTraits>::connect(
     MAY_BE_UNUSED(connect);
 
     return std::visit(utils::lambda_visitor_t{
-            [&](sock::active_socket_t<Proto>&)
+            [&](sock::active_socket_t<Proto>& sock)
             {
-                if (auto parsed = utils::from_string_and_port(remote_address, remote_port))
+                auto parsed = utils::address_from_string<sock::proto_address_t<Proto>>(remote_address, remote_port);
+                if constexpr (Proto::is_connectionless)
+                {
+                    // binded connectionless socket stays active, kernel filters datagrams by remote address
+                    if (parsed && sock.connect(*parsed))
+                    {
+                        set_fields(*parsed);
+                        return true;
+                    }
+                }
+                else if (parsed)
                 {
                     set_fields(*parsed);
                     return true;
@@ -103,29 +121,100 @@ bool client_t<Proto, Poll, PollTraits>::connect(
             }
             , [&](std::optional<sock::socket_t<Proto>>& sock)
             {
-                if constexpr (Proto::is_connectionless)
+                if (sock)
                 {
-                    return false;
+                    return connect(*sock);
                 }
                 else
                 {
-                    if (sock)
-                    {
-                        return connect(*sock);
-                    }
-                    else
-                    {
-                        return false;
-                    }
+                    return false;
                 }
             }
-            , [](auto& binded_sock) -> decltype(std::declval<sock::is_connectionless_t<Proto>>(), bool{})
+            , [&](auto& binded_sock) -> decltype(std::declval<sock::is_connectionless_t<Proto>>(), bool{})
             {
                 return connect(binded_sock);
             }}, this->state);
 }
 
 
+template <typename Proto, typename Poll, typename PollTraits>
+bool client_t<Proto, Poll, PollTraits>::set_multicast(unsigned ttl, bool loop, std::string const& iface) noexcept
+{
+    static_assert(Proto::is_connectionless);
+    std::lock_guard lock{m_mutex};
+    auto configure = [&](auto& sock)
+    {
+        if (!sock.set_multicast_ttl(ttl) || !sock.set_multicast_loop(loop))
+        {
+            return false;
+        }
+        else if (iface.empty())
+        {
+            return true;
+        }
+        else
+        {
+            auto iface_addr = sock::in_address_t::create(iface);
+            return iface_addr && sock.set_multicast_interface(*iface_addr);
+        }
+    };
+
+    // options should be set before connect, so route to group is resolved via chosen interface
+    return std::visit(utils::lambda_visitor_t{
+            [&](sock::active_socket_t<Proto>& sock) { return configure(sock); }
+            , [&](std::optional<sock::socket_t<Proto>>& sock) { return sock && configure(*sock); }}, this->state);
+}
+
+
+template <typename Proto, typename Poll, typename PollTraits>
+bool client_t<Proto, Poll, PollTraits>::set_timestamping(bool rx, on_tx_timestamp_t on_tx) noexcept
+{
+    static_assert(!sock::is_local_v<Proto>, "SO_TIMESTAMPING is supported by internet protocols only");
+    std::lock_guard lock{m_mutex};
+    auto* sock = std::get_if<sock::active_socket_t<Proto>>(&this->state);
+    if (sock && m_remote && sock->set_timestamping(rx, bool(on_tx)))
+    {
+        m_on_tx = std::move(on_tx);
+        return true;
+    }
+    return false;
+}
+
+
+template <typename Proto, typename Poll, typename PollTraits>
+bool client_t<Proto, Poll, PollTraits>::set_fixed_io(std::size_t buffer_size, bool fixed_buffers) noexcept
+{
+    static_assert(!Proto::is_connectionless, "fixed io serves connection based protocols only");
+    std::lock_guard lock{m_mutex};
+    auto* sock = std::get_if<sock::active_socket_t<Proto>>(&this->state);
+    auto io = sock && m_remote && !m_fixed_io ? uring::fixed_io::create(1, buffer_size, fixed_buffers) : std::nullopt;
+    if (!io)
+    {
+        return false;
+    }
+
+    // slot keeps address of fixed io, so it is attached to heap allocated instance
+    m_fixed_io = std::make_unique<uring::fixed_io>(std::move(*io));
+    m_fixed = m_fixed_io->attach(sock->native_handle());
+    if (!m_fixed)
+    {
+        m_fixed_io.reset();
+        return false;
+    }
+    PollTraits::add_socket(this->poll, m_fixed_io->native_handle(), sock::sock_op::READ);
+    return true;
+}
+
+
+template <typename Proto, typename Poll, typename PollTraits>
+bool client_t<Proto, Poll, PollTraits>::failed(int fd) noexcept
+{
+    std::lock_guard lock{m_mutex};
+    // TX timestamps are queued to error queue, so they are reported as error readiness too
+    return fd != this->get_fd() || !m_on_tx || drain_error_queue(fd, this->af, m_on_tx);
+}
+
+
 template <typename Proto, typename Poll, typename PollTraits>
 void client_t<Proto, Poll, PollTraits>::unregister_cbs()
 {
@@ -140,12 +229,15 @@ void client_t<Proto, Poll, PollTraits>::unregister_cbs()
 template <typename Proto, typename Poll, typename PollTraits>
 void client_t<Proto, Poll, PollTraits>::register_cbs()
 {
-    auto erase = [this](int fd)
+    auto erase = [this](int fd, metrics::disconnect_t reason)
     {
         std::lock_guard lock{m_mutex};
         if (fd == this->get_fd())
         {
-            PollTraits::del_socket(this->poll, fd);
+            if (PollTraits::del_socket(this->poll, fd))
+            {
+                this->m_metrics->disconnected(reason);
+            }
             if (this->m_on_disconnect)
             {
                 this->m_on_disconnect();
@@ -153,14 +245,29 @@ void client_t<Proto, Poll, PollTraits>::register_cbs()
             }
         }
     };
-    this->add(poll_event::event_type::PEER_CLOSED, erase);
-    this->add(poll_event::event_type::ERROR, erase);
-    this->add(poll_event::event_type::HANGUP, erase);
-    this->add(poll_event::event_type::EXCEPTION, erase);
+    this->add(poll_event::event_type::PEER_CLOSED, [erase](int fd) { erase(fd, metrics::disconnect_t::PEER_CLOSED); });
+    this->add(poll_event::event_type::ERROR, [this, erase](int fd)
+    {
+        if (failed(fd))
+        {
+            erase(fd, metrics::disconnect_t::ERROR);
+        }
+    });
+    this->add(poll_event::event_type::HANGUP, [erase](int fd) { erase(fd, metrics::disconnect_t::HANGUP); });
+    this->add(poll_event::event_type::EXCEPTION, [erase](int fd) { erase(fd, metrics::disconnect_t::EXCEPTION); });
     this->add(poll_event::event_type::READ_READY, [this](int fd)
     {
         std::lock_guard lock{m_mutex};
-        if (fd == this->get_fd())
+        if (m_fixed_io && fd == m_fixed_io->native_handle())
+        {
+            // socket's data is taken by slot's receive, so its completion is reported instead of socket readiness
+            m_fixed_io->reap();
+            if (m_fixed && m_fixed->readable())
+            {
+                this->m_on_read_ready();
+            }
+        }
+        else if (fd == this->get_fd() && !m_fixed)
         {
             this->m_on_read_ready();
         }
@@ -210,7 +317,14 @@ bool client_t<Proto, Poll, PollTraits>::finished_send_impl() const
 
 
 template <typename Proto, typename Poll, typename PollTraits>
-std::optional<std::pair<sock::in_address_port_t, std::size_t>>
+int client_t<Proto, Poll, PollTraits>::trace_fd() const noexcept
+{
+    return this->get_fd();
+}
+
+
+template <typename Proto, typename Poll, typename PollTraits>
+std::optional<std::pair<sock::proto_address_t<Proto>, std::size_t>>
 client_t<Proto, Poll, PollTraits>::recv_impl(void* buffer, std::size_t n)
 {
     auto* sock = std::get_if<sock::active_socket_t<Proto>>(&this->state);
@@ -218,12 +332,13 @@ client_t<Proto, Poll, PollTraits>::recv_impl(void* buffer, std::size_t n)
     {
         if constexpr (Proto::is_connectionless)
         {
-            return sock->receive(buffer, n, 0);
+            return m_account.received(sock->receive(buffer, n, 0), *sock);
         }
         else
         {
-            return utils::mbind(sock->receive(buffer, n, 0)
-                    , [this](std::size_t recv) -> std::optional<std::pair<sock::in_address_port_t, std::size_t>>
+            auto received = m_fixed ? m_fixed->recv(buffer, n) : sock->receive(buffer, n, 0);
+            return utils::mbind(m_account.received(std::move(received), *sock)
+                    , [this](std::size_t recv) -> std::optional<std::pair<sock::proto_address_t<Proto>, std::size_t>>
                     {
                         return std::pair{ *m_remote, recv };
                     });
@@ -236,20 +351,63 @@ client_t<Proto, Poll, PollTraits>::recv_impl(void* buffer, std::size_t n)
 }
 
 
+template <typename Proto, typename Poll, typename PollTraits>
+std::optional<std::pair<sock::proto_address_t<Proto>, std::size_t>>
+client_t<Proto, Poll, PollTraits>::recv_timestamped_impl(
+        void* buffer, std::size_t n, std::optional<sock::timestamp_t>& ts)
+{
+    ts.reset();
+    auto* sock = std::get_if<sock::active_socket_t<Proto>>(&this->state);
+    if constexpr (sock::is_local_v<Proto>)
+    {
+        return recv_impl(buffer, n);
+    }
+    else if (!sock)
+    {
+        return std::nullopt;
+    }
+    else if constexpr (Proto::is_connectionless)
+    {
+        return m_account.received(sock->receive_timestamped(buffer, n, 0, ts), *sock);
+    }
+    else if (m_fixed)
+    {
+        // slot receives without ancillary data
+        return recv_impl(buffer, n);
+    }
+    else
+    {
+        return utils::mbind(m_account.received(sock->receive_timestamped(buffer, n, 0, ts), *sock)
+                , [this](std::size_t recv) -> std::optional<std::pair<sock::proto_address_t<Proto>, std::size_t>>
+                {
+                    return std::pair{ *m_remote, recv };
+                });
+    }
+}
+
+
 template <typename Proto, typename Poll, typename PollTraits>
 std::optional<std::size_t> client_t<Proto, Poll, PollTraits>::send_impl(void* buffer, std::size_t n)
 {
     auto* sock = std::get_if<sock::active_socket_t<Proto>>(&this->state);
     if (sock && m_remote)
     {
-        if constexpr (Proto::is_connectionless)
-        {
-            return sock->send(*m_remote, buffer, n, 0);
-        }
-        else
-        {
-            return sock->send(buffer, n, 0);
-        }
+        return m_account.sent(m_fixed ? m_fixed->send(buffer, n) : sock->send(buffer, n, 0), *sock);
+    }
+    else
+    {
+        return std::nullopt;
+    }
+}
+
+
+template <typename Proto, typename Poll, typename PollTraits>
+std::optional<std::size_t> client_t<Proto, Poll, PollTraits>::send_chain_impl(buffer::iobuf const& buf)
+{
+    auto* sock = std::get_if<sock::active_socket_t<Proto>>(&this->state);
+    if (sock && m_remote)
+    {
+        return m_account.sent(m_fixed ? m_fixed->send(buf) : sock->send(buf, 0), *sock);
     }
     else
     {
@@ -261,10 +419,22 @@ std::optional<std::size_t> client_t<Proto, Poll, PollTraits>::send_impl(void* bu
 template <typename Proto, typename Poll, typename PollTraits>
 bool client_t<Proto, Poll, PollTraits>::proceed(std::chrono::milliseconds timeout)
 {
+    // operations queued since last proceed are submitted in one batch
+    if (m_fixed_io)
+    {
+        m_fixed_io->submit();
+    }
     return endpoint_t<sum_of_client_states_t, Proto, Poll, PollTraits>::proceed(timeout);
 }
 
 
+template <typename Proto, typename Poll, typename PollTraits>
+metrics::metrics_snapshot client_t<Proto, Poll, PollTraits>::metrics() const noexcept
+{
+    return this->m_metrics->snapshot();
+}
+
+
 template <typename Proto, typename Poll, typename PollTraits>
 client_t<Proto, Poll, PollTraits>::~client_t()
 {
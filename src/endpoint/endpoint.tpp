@@ -8,7 +8,7 @@ endpoint_t<States, Proto, Poll, PollTraits>::endpoint_t(
         , AF arg_af
         , typename event_observer_t<Poll*>::on_unhandled_t unhandled)
         noexcept(std::is_nothrow_move_constructible_v<Poll>)
-    : poll_holder_t<Poll>{std::move(arg_poll)}
+    : detail::poll_holder_t<Poll>{std::move(arg_poll)}
     , event_observer_t<Poll*>{&this->poll, std::move(unhandled)}
     , af{static_cast<int>(arg_af)}
     , state{std::nullopt}
@@ -30,8 +30,23 @@ bool event_observer_t<Poll, PollTraits>::remove(poll_event::event_type event)
 template <typename Poll, typename PollTraits>
 bool event_observer_t<Poll, PollTraits>::proceed(std::chrono::milliseconds timeout)
 {
+    // capacity is reused by next proceed of thread, so steady state event loop doesn't allocate. Nested proceed from
+    // handler takes empty vector
+    static thread_local std::vector<poll_event::event> cached;
+    std::vector<poll_event::event> events = std::move(cached);
+    events.clear();
+    // timings aren't taken at all when metrics are compiled out
+    metrics::endpoint_metrics::clock_t::rep handling{};
+    if constexpr (metrics::enabled)
+    {
+        m_metrics->loop_entered();
+    }
+    PollTraits::proceed(m_poll, timeout, events);
+    if constexpr (metrics::enabled)
+    {
+        handling = m_metrics->polled(events.size());
+    }
     std::vector<poll_event::event> unhandled;
-    std::vector<poll_event::event> events = PollTraits::proceed(m_poll, timeout);
     std::vector<std::exception_ptr> exceptions;
     {
         // throws only in case of deadlock or invalid mutex, so safely proceed before
@@ -39,8 +54,12 @@ bool event_observer_t<Poll, PollTraits>::proceed(std::chrono::milliseconds timeo
         for (auto event: events)
         {
             auto result = handle_event(event);
+            if constexpr (metrics::enabled)
+            {
+                handling = m_metrics->handled(handling);
+            }
             add_exception(std::move(result.second), exceptions);
-            if (!result.first)
+            if (!result.first && m_unhandled)
             {
                 unhandled.push_back(event);
             }
@@ -48,12 +67,18 @@ bool event_observer_t<Poll, PollTraits>::proceed(std::chrono::milliseconds timeo
     }
 
     add_exception(handle_unhandled(unhandled), exceptions);
+    bool proceeded = !events.empty();
+    cached = std::move(events);
+    if constexpr (metrics::enabled)
+    {
+        m_metrics->loop_left(handling);
+    }
     if (!exceptions.empty())
     {
         throw proceed_exception{std::move(exceptions)};
     }
 
-    return !events.empty();
+    return proceeded;
 }
 
 
@@ -84,8 +109,9 @@ std::pair<bool, std::exception_ptr> event_observer_t<Poll, PollTraits>::handle_e
         ret.first |= handle_event(event, poll_event::event_type::READ_READY);
         ret.first |= handle_event(event, poll_event::event_type::WRITE_READY);
         ret.first |= handle_event(event, poll_event::event_type::EXCEPTION);
-        ret.first |= handle_event(event, poll_event::event_type::HANGUP);
+        // most specific termination reason is dispatched first: reset reports error and hang up together
         ret.first |= handle_event(event, poll_event::event_type::ERROR);
+        ret.first |= handle_event(event, poll_event::event_type::HANGUP);
         ret.first |= handle_event(event, poll_event::event_type::PEER_CLOSED);
     }
     catch (...)
@@ -0,0 +1,180 @@
+#include <endpoint/handoff.h>
+#include <socket/socket.h>
+#include <socket/af_unix.h>
+#include <socket/unix_address.h>
+#include <utils/mbind.h>
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+namespace protei::endpoint
+{
+
+using clock_t = std::chrono::steady_clock;
+
+/**
+ * @brief Handoff chunk header. Each chunk carries up to socket_impl::MAX_PASSED_FDS descriptors, first descriptor
+ * of the first chunk is listening socket
+ */
+struct chunk_header
+{
+    std::uint32_t fds_count;
+    std::uint32_t remaining;
+};
+
+static constexpr char ACK = 'A';
+
+static bool wait_for(int fd, short events, clock_t::time_point deadline) noexcept
+{
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock_t::now());
+    pollfd pfd{fd, events, 0};
+    return left.count() > 0 && 1 == ::poll(&pfd, 1, static_cast<int>(left.count())) && (pfd.revents & events);
+}
+
+
+bool send_handoff(
+        std::string const& address
+        , int listening_fd
+        , std::vector<int> const& accepted_fds
+        , std::chrono::milliseconds timeout) noexcept
+{
+    using sock::unix_stream;
+    auto addr = sock::unix_address_t::create(address);
+    if (!addr)
+    {
+        return false;
+    }
+
+    // new process may not listen yet
+    auto deadline = clock_t::now() + timeout;
+    std::optional<sock::active_socket_t<unix_stream>> conn;
+    while (!(conn = utils::mbind(
+            sock::socket_t<unix_stream>::create(sock::local{})
+            , [&addr](sock::socket_t<unix_stream>&& sock) { return sock.connect(*addr); })))
+    {
+        if (clock_t::now() >= deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    std::vector<int> fds;
+    fds.reserve(accepted_fds.size() + 1);
+    fds.push_back(listening_fd);
+    fds.insert(fds.end(), accepted_fds.begin(), accepted_fds.end());
+    for (std::size_t sent = 0; sent < fds.size(); )
+    {
+        auto count = std::min(fds.size() - sent, sock::impl::socket_impl::MAX_PASSED_FDS);
+        chunk_header header{
+                static_cast<std::uint32_t>(count)
+                , static_cast<std::uint32_t>(fds.size() - sent - count)};
+        auto res = conn->send_fds(&header, sizeof(header), fds.data() + sent, count);
+        if (res && *res == sizeof(header))
+        {
+            sent += count;
+        }
+        else if (!res && (conn->again() || conn->would_block()) && wait_for(conn->native_handle(), POLLOUT, deadline))
+        {
+            continue;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    char ack = 0;
+    while (wait_for(conn->native_handle(), POLLIN, deadline))
+    {
+        if (auto res = conn->receive(&ack, sizeof(ack), 0))
+        {
+            return *res == sizeof(ack) && ack == ACK;
+        }
+        else if (!conn->again() && !conn->would_block())
+        {
+            break;
+        }
+    }
+    return false;
+}
+
+
+std::optional<handoff_fds> receive_handoff(std::string const& address, std::chrono::milliseconds timeout) noexcept
+{
+    using sock::unix_stream;
+    auto addr = sock::unix_address_t::create(address);
+    // handoff socket file is never shared, so stale one of crashed process is removed
+    auto unlink = [&addr]()
+    {
+        if (addr && !addr->is_abstract())
+        {
+            ::unlink(addr->name().c_str());
+        }
+    };
+    unlink();
+    auto listener = utils::mbind(
+            addr ? sock::socket_t<unix_stream>::create(sock::local{}) : std::nullopt
+            , [&addr](sock::socket_t<unix_stream>&& sock) { return sock.bind(*addr); }
+            , [](sock::binded_socket_t<unix_stream>&& sock) { return sock.listen(1); });
+    auto deadline = clock_t::now() + timeout;
+    if (!listener || !wait_for(listener->native_handle(), POLLIN, deadline))
+    {
+        unlink();
+        return std::nullopt;
+    }
+
+    auto conn = listener->accept();
+    unlink();
+    if (!conn)
+    {
+        return std::nullopt;
+    }
+
+    std::vector<int> fds;
+    auto close_all = [&fds]()
+    {
+        std::for_each(fds.begin(), fds.end(), [](int fd) { ::close(fd); });
+        return std::nullopt;
+    };
+
+    bool completed = false;
+    while (!completed && wait_for(conn->native_handle(), POLLIN, deadline))
+    {
+        chunk_header header{};
+        int chunk[sock::impl::socket_impl::MAX_PASSED_FDS];
+        std::size_t count = sock::impl::socket_impl::MAX_PASSED_FDS;
+        auto res = conn->receive_fds(&header, sizeof(header), chunk, count);
+        fds.insert(fds.end(), chunk, chunk + count);
+        if (res && *res == sizeof(header) && header.fds_count == count)
+        {
+            completed = header.remaining == 0;
+        }
+        else if (res || (!conn->again() && !conn->would_block()))
+        {
+            return close_all();
+        }
+    }
+
+    char ack = ACK;
+    if (!completed || fds.empty() || !conn->send(&ack, sizeof(ack), 0))
+    {
+        return close_all();
+    }
+
+    return handoff_fds{fds.front(), std::vector<int>(fds.begin() + 1, fds.end())};
+}
+
+
+
+void close_handoff(handoff_fds const& fds) noexcept
+{
+    ::close(fds.listening);
+    std::for_each(fds.accepted.begin(), fds.accepted.end(), [](int fd) { ::close(fd); });
+}
+
+}
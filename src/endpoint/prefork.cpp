@@ -0,0 +1,81 @@
+#include <endpoint/prefork.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+namespace protei::endpoint
+{
+
+std::optional<prefork_t> prefork_t::start(
+        int listening_fd
+        , unsigned workers
+        , worker_main_t const& worker_main) noexcept
+{
+    prefork_t prefork;
+    prefork.m_workers.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i)
+    {
+        auto pid = ::fork();
+        if (pid == 0)
+        {
+            int code = 1;
+            try
+            {
+                code = worker_main(listening_fd, i);
+            }
+            catch (...)
+            {}
+            // skip master's atexit handlers and static destructors
+            ::_exit(code);
+        }
+        else if (pid == -1)
+        {
+            return std::nullopt;
+        }
+        prefork.m_workers.push_back(pid);
+    }
+
+    return prefork;
+}
+
+
+prefork_t::~prefork_t()
+{
+    stop(SIGKILL);
+    wait();
+}
+
+
+bool prefork_t::stop(int signal) noexcept
+{
+    bool sent = true;
+    for (int pid: m_workers)
+    {
+        sent = 0 == ::kill(pid, signal) && sent;
+    }
+    return sent;
+}
+
+
+bool prefork_t::wait() noexcept
+{
+    bool succeed = true;
+    for (int pid: m_workers)
+    {
+        int status = -1;
+        while (-1 == ::waitpid(pid, &status, 0) && errno == EINTR);
+        succeed = WIFEXITED(status) && WEXITSTATUS(status) == 0 && succeed;
+    }
+    m_workers.clear();
+    return succeed;
+}
+
+
+std::vector<int> const& prefork_t::workers() const noexcept
+{
+    return m_workers;
+}
+
+}
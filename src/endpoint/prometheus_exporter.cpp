@@ -0,0 +1,423 @@
+#include <endpoint/prometheus_exporter.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+
+namespace protei::endpoint
+{
+
+namespace
+{
+
+constexpr std::string_view CONTENT_TYPE = "text/plain; version=0.0.4; charset=utf-8";
+/// inclusive bounds of events per proceed buckets, 2^k - 1 are exact on log-linear grid
+constexpr std::size_t EVENT_BUCKETS = 11;
+constexpr std::array<double, 3> QUANTILES{0.5, 0.9, 0.99};
+
+void append(std::vector<char>& to, std::string_view str)
+{
+    to.insert(to.end(), str.begin(), str.end());
+}
+
+
+void append(std::vector<char>& to, std::uint64_t value)
+{
+    char buff[24];
+    auto res = std::to_chars(std::begin(buff), std::end(buff), value);
+    to.insert(to.end(), std::begin(buff), res.ptr);
+}
+
+
+void append(std::vector<char>& to, double value)
+{
+    char buff[32];
+    auto res = std::to_chars(std::begin(buff), std::end(buff), value);
+    to.insert(to.end(), std::begin(buff), res.ptr);
+}
+
+
+double seconds(std::uint64_t ns)
+{
+    return static_cast<double>(ns) / 1e9;
+}
+
+
+bool iequals(std::string_view lhs, std::string_view rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](char l, char r)
+    {
+        return std::tolower(static_cast<unsigned char>(l)) == std::tolower(static_cast<unsigned char>(r));
+    });
+}
+
+
+std::string_view trim(std::string_view str)
+{
+    auto first = str.find_first_not_of(" \t");
+    if (first == std::string_view::npos)
+    {
+        return {};
+    }
+    return str.substr(first, str.find_last_not_of(" \t") - first + 1);
+}
+
+
+/**
+ * @param head - request line and headers
+ * @return true if request has "Connection: close" header
+ */
+bool connection_close(std::string_view head)
+{
+    while (!head.empty())
+    {
+        auto end = head.find("\r\n");
+        auto line = head.substr(0, end);
+        auto colon = line.find(':');
+        if (colon != std::string_view::npos
+            && iequals(trim(line.substr(0, colon)), "connection")
+            && iequals(trim(line.substr(colon + 1)), "close"))
+        {
+            return true;
+        }
+        head.remove_prefix(end == std::string_view::npos ? head.size() : end + 2);
+    }
+    return false;
+}
+
+
+/**
+ * @return label value with backslash, double quote and line feed escaped
+ */
+std::string escape_label(std::string_view value)
+{
+    std::string ret;
+    for (char c: value)
+    {
+        if (c == '\\' || c == '"')
+        {
+            ret += '\\';
+            ret += c;
+        }
+        else if (c == '\n')
+        {
+            ret += "\\n";
+        }
+        else
+        {
+            ret += c;
+        }
+    }
+    return ret;
+}
+
+}
+
+
+prometheus_exporter::prometheus_exporter(std::size_t max_conns)
+    : m_server{epoll::epoll_t{static_cast<int>(max_conns) + 1, static_cast<unsigned>(max_conns) + 1}, sock::ipv4{}}
+{
+    m_conns.reserve(max_conns);
+}
+
+
+void prometheus_exporter::add_source(std::string name, source_t source)
+{
+    m_sources.emplace_back(escape_label(name), std::move(source));
+    m_snapshots.resize(m_sources.size());
+}
+
+
+bool prometheus_exporter::start(std::string const& address, std::uint_fast16_t port) noexcept
+{
+    return m_server.start(
+            address
+            , port
+            , static_cast<unsigned>(m_conns.capacity())
+            , [this](accepted_sock<sock::tcp>&& sock) { m_conns.push_back(connection{std::move(sock)}); }
+            , [this](int fd)
+            {
+                auto fnd = std::find_if(m_conns.begin(), m_conns.end(), [fd](connection const& conn)
+                {
+                    return conn.sock.native_handle() == fd;
+                });
+                if (fnd != m_conns.end())
+                {
+                    std::swap(*fnd, m_conns.back());
+                    m_conns.pop_back();
+                }
+            }
+            // exporter closes scrapers' connections, so its port is left in TIME_WAIT on restart
+            , true);
+}
+
+
+void prometheus_exporter::stop() noexcept
+{
+    m_server.stop();
+    while (!m_conns.empty())
+    {
+        close(m_conns.size() - 1);
+    }
+}
+
+
+bool prometheus_exporter::proceed(std::chrono::milliseconds timeout)
+{
+    bool proceeded = m_server.proceed(timeout);
+    // edge triggered: requests are read only after poll reported something, each connection is drained
+    if (proceeded)
+    {
+        for (std::size_t i = 0; i < m_conns.size();)
+        {
+            if (serve(m_conns[i]))
+            {
+                ++i;
+            }
+            else
+            {
+                close(i);
+            }
+        }
+    }
+    return proceeded;
+}
+
+
+bool prometheus_exporter::serve(connection& conn)
+{
+    while (true)
+    {
+        auto space = conn.request.size() - conn.size;
+        if (space == 0)
+        {
+            send_response(conn, "431 Request Header Fields Too Large", {}, false);
+            return false;
+        }
+
+        auto rec = conn.sock.recv(conn.request.data() + conn.size, space);
+        if (!rec)
+        {
+            return conn.sock.finished_recv();
+        }
+        else if (rec->second == 0)
+        {
+            return false;
+        }
+
+        conn.size += rec->second;
+        std::string_view buffered{conn.request.data(), conn.size};
+        for (auto end = buffered.find("\r\n\r\n"); end != std::string_view::npos; end = buffered.find("\r\n\r\n"))
+        {
+            if (!respond(conn, buffered.substr(0, end)))
+            {
+                return false;
+            }
+            buffered.remove_prefix(end + 4);
+        }
+        std::memmove(conn.request.data(), buffered.data(), buffered.size());
+        conn.size = buffered.size();
+
+        // short read drained socket
+        if (rec->second < space)
+        {
+            return true;
+        }
+    }
+}
+
+
+bool prometheus_exporter::respond(connection& conn, std::string_view head)
+{
+    auto line = head.substr(0, head.find("\r\n"));
+    auto method_end = line.find(' ');
+    auto target_end = line.rfind(' ');
+    if (method_end == std::string_view::npos || target_end == method_end)
+    {
+        return send_response(conn, "400 Bad Request", {}, false);
+    }
+
+    auto method = line.substr(0, method_end);
+    auto target = line.substr(method_end + 1, target_end - method_end - 1);
+    target = target.substr(0, target.find('?'));
+    bool keep_alive = line.substr(target_end + 1) == "HTTP/1.1" && !connection_close(head);
+    if (method != "GET")
+    {
+        return send_response(conn, "405 Method Not Allowed", {}, keep_alive);
+    }
+    else if (target != "/metrics")
+    {
+        return send_response(conn, "404 Not Found", {}, keep_alive);
+    }
+    else
+    {
+        return send_response(conn, "200 OK", render(), keep_alive);
+    }
+}
+
+
+bool prometheus_exporter::send_response(
+        connection& conn
+        , std::string_view status
+        , std::string_view body
+        , bool keep_alive)
+{
+    m_response.clear();
+    append(m_response, "HTTP/1.1 ");
+    append(m_response, status);
+    append(m_response, "\r\nContent-Type: ");
+    append(m_response, CONTENT_TYPE);
+    append(m_response, "\r\nContent-Length: ");
+    append(m_response, std::uint64_t{body.size()});
+    append(m_response, keep_alive ? "\r\n\r\n" : "\r\nConnection: close\r\n\r\n");
+    append(m_response, body);
+
+    // response fits socket buffer unless scraper doesn't read, such connection is closed
+    auto sent = conn.sock.send(m_response.data(), m_response.size());
+    return keep_alive && sent && *sent == m_response.size();
+}
+
+
+void prometheus_exporter::close(std::size_t index) noexcept
+{
+    m_server.detach(m_conns[index].sock.native_handle());
+    std::swap(m_conns[index], m_conns.back());
+    m_conns.pop_back();
+}
+
+
+std::string_view prometheus_exporter::render()
+{
+    using metrics::disconnect_t;
+    using snapshot_t = metrics::metrics_snapshot;
+    m_body.clear();
+    for (std::size_t i = 0; i < m_sources.size(); ++i)
+    {
+        m_snapshots[i] = m_sources[i].second();
+    }
+
+    auto counter = [this](std::string_view name, std::string_view help, std::uint64_t snapshot_t::* field)
+    {
+        family(name, "counter", help);
+        for (std::size_t i = 0; i < m_snapshots.size(); ++i)
+        {
+            series(name, {}, i);
+            end(m_snapshots[i].*field);
+        }
+    };
+    counter("transport_accepts_total", "Accepted connections.", &snapshot_t::accepts);
+    counter("transport_bytes_in_total", "Received bytes.", &snapshot_t::bytes_in);
+    counter("transport_bytes_out_total", "Sent bytes.", &snapshot_t::bytes_out);
+    counter("transport_messages_in_total", "Successful receive calls.", &snapshot_t::messages_in);
+    counter("transport_messages_out_total", "Successful send calls.", &snapshot_t::messages_out);
+    counter("transport_eagain_total", "Send and receive calls failed with EAGAIN.", &snapshot_t::eagain);
+    counter("transport_proceeds_total", "Event loop iterations.", &snapshot_t::proceeds);
+    counter("transport_events_total", "Polled events.", &snapshot_t::events);
+
+    constexpr std::array<std::pair<disconnect_t, std::string_view>, 4> reasons{{
+            {disconnect_t::PEER_CLOSED, "peer_closed"}
+            , {disconnect_t::HANGUP, "hangup"}
+            , {disconnect_t::ERROR, "error"}
+            , {disconnect_t::EXCEPTION, "exception"}}};
+    family("transport_disconnects_total", "counter", "Terminated connections by first termination event.");
+    for (std::size_t i = 0; i < m_snapshots.size(); ++i)
+    {
+        for (auto [reason, label]: reasons)
+        {
+            series("transport_disconnects_total", {}, i);
+            append(m_body, ",reason=\"");
+            append(m_body, label);
+            append(m_body, "\"");
+            end(m_snapshots[i].disconnected(reason));
+        }
+    }
+
+    family("transport_events_per_proceed", "histogram", "Events polled by one event loop iteration.");
+    for (std::size_t i = 0; i < m_snapshots.size(); ++i)
+    {
+        auto const& hist = m_snapshots[i].events_per_proceed;
+        for (std::size_t k = 0; k < EVENT_BUCKETS; ++k)
+        {
+            std::uint64_t bound = std::uint64_t{1} << k;
+            series("transport_events_per_proceed", "_bucket", i);
+            append(m_body, ",le=\"");
+            append(m_body, bound - 1);
+            append(m_body, "\"");
+            end(hist.count_below(bound));
+        }
+        series("transport_events_per_proceed", "_bucket", i);
+        append(m_body, ",le=\"+Inf\"");
+        end(hist.count);
+        series("transport_events_per_proceed", "_sum", i);
+        end(hist.sum);
+        series("transport_events_per_proceed", "_count", i);
+        end(hist.count);
+    }
+
+    auto summary = [this](std::string_view name, std::string_view help, metrics::histogram_snapshot snapshot_t::* field)
+    {
+        family(name, "summary", help);
+        for (std::size_t i = 0; i < m_snapshots.size(); ++i)
+        {
+            auto const& hist = m_snapshots[i].*field;
+            for (auto quantile: QUANTILES)
+            {
+                series(name, {}, i);
+                append(m_body, ",quantile=\"");
+                append(m_body, quantile);
+                append(m_body, "\"");
+                end(seconds(hist.percentile(quantile)));
+            }
+            series(name, "_sum", i);
+            end(seconds(hist.sum));
+            series(name, "_count", i);
+            end(hist.count);
+        }
+    };
+    summary("transport_handler_seconds", "Handlers execution time of polled event.", &snapshot_t::handler_ns);
+    summary("transport_loop_lag_seconds", "Time between event loop iterations.", &snapshot_t::loop_lag_ns);
+    return {m_body.data(), m_body.size()};
+}
+
+
+void prometheus_exporter::family(std::string_view name, std::string_view type, std::string_view help)
+{
+    append(m_body, "# HELP ");
+    append(m_body, name);
+    append(m_body, " ");
+    append(m_body, help);
+    append(m_body, "\n# TYPE ");
+    append(m_body, name);
+    append(m_body, " ");
+    append(m_body, type);
+    append(m_body, "\n");
+}
+
+
+void prometheus_exporter::series(std::string_view name, std::string_view suffix, std::size_t source)
+{
+    append(m_body, name);
+    append(m_body, suffix);
+    append(m_body, "{endpoint=\"");
+    append(m_body, m_sources[source].first);
+    append(m_body, "\"");
+}
+
+
+void prometheus_exporter::end(std::uint64_t value)
+{
+    append(m_body, "} ");
+    append(m_body, value);
+    append(m_body, "\n");
+}
+
+
+void prometheus_exporter::end(double value)
+{
+    append(m_body, "} ");
+    append(m_body, value);
+    append(m_body, "\n");
+}
+
+}
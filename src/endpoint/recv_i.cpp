@@ -1,20 +1,40 @@
 #include <endpoint/recv_i.h>
 #include <socket/in_address.h>
+#include <socket/unix_address.h>
+#include <trace/trace.h>
 
 namespace protei::endpoint
 {
 
-std::optional<std::pair<sock::in_address_port_t, std::size_t>> recv_i::recv(void* buffer, std::size_t buff_size)
+template <typename Address>
+std::optional<std::pair<Address, std::size_t>> basic_recv_i<Address>::recv(void* buffer, std::size_t buff_size)
 {
-    // insert debug ext log here
-    return recv_impl(buffer, buff_size);
+    auto ret = recv_impl(buffer, buff_size);
+    PROTEI_TRACE_IO(trace::op_t::RECV, trace_fd(), buff_size, ret);
+    return ret;
 }
 
 
-bool recv_i::finished_recv() const
+template <typename Address>
+std::optional<std::pair<Address, std::size_t>> basic_recv_i<Address>::recv_timestamped(
+        void* buffer, std::size_t buff_size, std::optional<sock::timestamp_t>& ts)
 {
-    // insert debug ext log here
-    return finished_recv_impl();
+    auto ret = recv_timestamped_impl(buffer, buff_size, ts);
+    PROTEI_TRACE_IO(trace::op_t::RECV, trace_fd(), buff_size, ret);
+    return ret;
 }
 
+
+template <typename Address>
+bool basic_recv_i<Address>::finished_recv() const
+{
+    auto ret = finished_recv_impl();
+    PROTEI_TRACE_IO(trace::op_t::FINISHED_RECV, trace_fd(), 0, ret);
+    return ret;
+}
+
+
+template class basic_recv_i<sock::in_address_port_t>;
+template class basic_recv_i<sock::unix_address_t>;
+
 }
@@ -1,18 +1,41 @@
 #include <endpoint/send_i.h>
+#include <trace/trace.h>
+
+#include <vector>
 
 namespace protei::endpoint
 {
 
 std::optional<std::size_t> send_i::send(void* buffer, std::size_t buff_size)
 {
-    // insert debug ext log here
-    return send_impl(buffer, buff_size);
+    auto ret = send_impl(buffer, buff_size);
+    PROTEI_TRACE_IO(trace::op_t::SEND, trace_fd(), buff_size, ret);
+    return ret;
+}
+
+
+std::optional<std::size_t> send_i::send(buffer::iobuf const& buf)
+{
+    auto ret = send_chain_impl(buf);
+    PROTEI_TRACE_IO(trace::op_t::SEND_CHAIN, trace_fd(), buf.size(), ret);
+    return ret;
 }
 
   
 bool send_i::finished_send() const
 {
-    return finished_send_impl();
+    auto ret = finished_send_impl();
+    PROTEI_TRACE_IO(trace::op_t::FINISHED_SEND, trace_fd(), 0, ret);
+    return ret;
+}
+
+
+std::optional<std::size_t> send_i::send_chain_impl(buffer::iobuf const& buf)
+{
+    static thread_local std::vector<char> linear;
+    linear.resize(buf.size());
+    buf.copy_to(linear.data());
+    return send_impl(linear.data(), linear.size());
 }
 
 }
@@ -7,17 +7,22 @@ bool interface_proxy<Proto, D, PollTraits, V>::start(
         , std::uint_fast16_t port
         , unsigned int max_conns
         , std::function<void(accepted_sock<Proto>&&)> on_conn
-        , std::function<void(int)> erase_active_socket) noexcept
+        , std::function<void(int)> erase_active_socket
+        , bool reuse_address) noexcept
 {
     using utils::mbind;
     auto& derived = static_cast<D&>(*this);
     std::lock_guard lock{derived.m_mutex};
-    std::optional<sock::in_address_port_t> addr;
-    if (derived.idle() && (addr = utils::from_string_and_port(address, port)))
+    std::optional<sock::proto_address_t<Proto>> addr;
+    if (derived.idle() && (addr = utils::address_from_string<sock::proto_address_t<Proto>>(address, port)))
     {
         auto listener = mbind(sock::socket_t<Proto>::create(derived.af)
-                , [&](sock::socket_t<Proto>&& sock)
+                , [&](sock::socket_t<Proto>&& sock) -> std::optional<sock::binded_socket_t<Proto>>
                 {
+                    if (reuse_address && !sock.set_reuse_address(true))
+                    {
+                        return std::nullopt;
+                    }
                     return sock.bind(*addr);
                 }, [this, max_conns](sock::binded_socket_t<Proto>&& sock) -> std::optional<sock::listening_socket_t<Proto>>
                 {
@@ -25,15 +30,7 @@ bool interface_proxy<Proto, D, PollTraits, V>::start(
                 });
         if (listener)
         {
-            derived.register_cbs();
-            PollTraits::add_socket(derived.poll, listener->native_handle(), sock::sock_op::READ);
-            derived.state = std::move(*listener);
-            // Type erasure
-            derived.m_on_conn = [on_conn = std::move(on_conn)](send_recv_i&& sock)
-            {
-                on_conn(static_cast<accepted_sock<Proto>&&>(sock));
-            };
-            derived.m_erase_active_socket = std::move(erase_active_socket);
+            start_impl(std::move(*listener), std::move(on_conn), std::move(erase_active_socket));
             return true;
         }
     }
@@ -42,36 +39,347 @@ bool interface_proxy<Proto, D, PollTraits, V>::start(
 }
 
 
+template <typename Proto, typename D, typename PollTraits, typename V>
+bool interface_proxy<Proto, D, PollTraits, V>::start(
+        int listening_fd
+        , unsigned max_conns
+        , std::function<void(accepted_sock<Proto>&&)> on_conn
+        , std::function<void(int fd)> erase_active_socket
+        , bool exclusive) noexcept
+{
+    auto& derived = static_cast<D&>(*this);
+    std::lock_guard lock{derived.m_mutex};
+    if (!derived.idle())
+    {
+        return false;
+    }
+
+    auto listener = sock::listening_socket_t<Proto>::adopt(listening_fd, max_conns);
+    if (listener)
+    {
+        start_impl(std::move(*listener), std::move(on_conn), std::move(erase_active_socket), exclusive);
+    }
+    return listener.has_value();
+}
+
+
+template <typename Proto, typename D, typename PollTraits, typename V>
+bool interface_proxy<Proto, D, PollTraits, V>::adopt(
+        std::string const& handoff_address
+        , std::chrono::milliseconds timeout
+        , unsigned max_conns
+        , std::function<void(accepted_sock<Proto>&&)> on_conn
+        , std::function<void(int fd)> erase_active_socket) noexcept
+{
+    auto& derived = static_cast<D&>(*this);
+    std::lock_guard lock{derived.m_mutex};
+    if (!derived.idle())
+    {
+        return false;
+    }
+
+    auto fds = receive_handoff(handoff_address, timeout);
+    if (!fds)
+    {
+        return false;
+    }
+
+    auto listener = sock::listening_socket_t<Proto>::adopt(fds->listening, max_conns);
+    if (!listener)
+    {
+        close_handoff(*fds);
+        return false;
+    }
+
+    start_impl(std::move(*listener), std::move(on_conn), std::move(erase_active_socket));
+    for (int fd: fds->accepted)
+    {
+        if (auto sock = sock::active_socket_t<Proto>::adopt(fd, true))
+        {
+            auto remote = *sock->remote();
+            PollTraits::add_socket(derived.poll, fd, sock::sock_op::READ);
+            ++m_load;
+            metrics::metrics_ref account{derived.m_metrics};
+            accepted_sock<Proto> accepted{remote, std::move(*sock), std::move(account)};
+            serve_fixed(accepted);
+            derived.m_on_conn(std::move(accepted));
+        }
+        else
+        {
+            close_handoff(handoff_fds{fd, {}});
+        }
+    }
+    return true;
+}
+
+
+template <typename Proto, typename D, typename PollTraits, typename V>
+void interface_proxy<Proto, D, PollTraits, V>::start_impl(
+        sock::listening_socket_t<Proto>&& listener
+        , std::function<void(accepted_sock<Proto>&&)> on_conn
+        , std::function<void(int fd)> erase_active_socket
+        , bool exclusive) noexcept
+{
+    auto& derived = static_cast<D&>(*this);
+    derived.register_cbs();
+    if (exclusive)
+    {
+        PollTraits::add_socket(derived.poll, listener.native_handle(), sock::sock_op::READ, true);
+    }
+    else
+    {
+        PollTraits::add_socket(derived.poll, listener.native_handle(), sock::sock_op::READ);
+    }
+    derived.state = std::move(listener);
+    if (m_attach_event == -1)
+    {
+        m_attach_event = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    }
+    PollTraits::add_socket(derived.poll, m_attach_event, sock::sock_op::READ);
+    // Type erasure
+    derived.m_on_conn = [on_conn = std::move(on_conn)](basic_send_recv_i<sock::proto_address_t<Proto>>&& sock)
+    {
+        on_conn(static_cast<accepted_sock<Proto>&&>(sock));
+    };
+    derived.m_erase_active_socket = std::move(erase_active_socket);
+}
+
+
+template <typename Proto, typename D, typename PollTraits, typename V>
+bool interface_proxy<Proto, D, PollTraits, V>::handoff(
+        std::string const& handoff_address
+        , std::vector<int> const& accepted_fds
+        , std::chrono::milliseconds timeout) noexcept
+{
+    auto& derived = static_cast<D&>(*this);
+    std::unique_lock lock{derived.m_mutex};
+    if (!std::holds_alternative<sock::listening_socket_t<Proto>>(derived.state)
+            || !send_handoff(handoff_address, derived.get_fd(), accepted_fds, timeout))
+    {
+        return false;
+    }
+
+    // descriptors are shared with new process now, so they are removed from poll explicitly:
+    // closing own copy doesn't unregister shared file
+    PollTraits::del_socket(derived.poll, derived.get_fd());
+    derived.state = std::optional<sock::socket_t<Proto>>{};
+    for (int fd: accepted_fds)
+    {
+        if (PollTraits::del_socket(derived.poll, fd))
+        {
+            --m_load;
+        }
+        if (derived.m_erase_active_socket)
+        {
+            derived.m_erase_active_socket(fd);
+        }
+    }
+    return true;
+}
+
+
+template <typename Proto, typename D, typename PollTraits, typename V>
+bool interface_proxy<Proto, D, PollTraits, V>::detach(int fd) noexcept
+{
+    auto& derived = static_cast<D&>(*this);
+    std::lock_guard lock{derived.m_mutex};
+    if (fd == derived.get_fd() || (m_fixed_io && m_fixed_io->serves(fd)) || !PollTraits::del_socket(derived.poll, fd))
+    {
+        return false;
+    }
+    --m_load;
+    return true;
+}
+
+
+template <typename Proto, typename D, typename PollTraits, typename V>
+void interface_proxy<Proto, D, PollTraits, V>::attach(
+        accepted_sock<Proto>&& sock
+        , std::function<void(accepted_sock<Proto>&&)> on_attached)
+{
+    {
+        std::lock_guard lock{m_attach_mutex};
+        m_attached.emplace_back(std::move(sock), std::move(on_attached));
+        ++m_load;
+    }
+    ::eventfd_write(m_attach_event, 1);
+}
+
+
+template <typename Proto, typename D, typename PollTraits, typename V>
+std::size_t interface_proxy<Proto, D, PollTraits, V>::load() const noexcept
+{
+    return m_load;
+}
+
+
+template <typename Proto, typename D, typename PollTraits, typename V>
+bool interface_proxy<Proto, D, PollTraits, V>::set_fixed_io(
+        unsigned slots
+        , std::size_t buffer_size
+        , bool fixed_buffers) noexcept
+{
+    auto& derived = static_cast<D&>(*this);
+    std::lock_guard lock{derived.m_mutex};
+    auto io = m_fixed_io ? std::nullopt : uring::fixed_io::create(slots, buffer_size, fixed_buffers);
+    if (!io)
+    {
+        return false;
+    }
+
+    m_fixed_io = std::make_unique<uring::fixed_io>(std::move(*io));
+    PollTraits::add_socket(derived.poll, m_fixed_io->native_handle(), sock::sock_op::READ);
+    return true;
+}
+
+
+template <typename Proto, typename D, typename PollTraits, typename V>
+void interface_proxy<Proto, D, PollTraits, V>::serve_fixed(accepted_sock<Proto>& sock) noexcept
+{
+    if (!m_fixed_io)
+    {
+        return;
+    }
+    if (auto slot = m_fixed_io->attach(sock.native_handle()))
+    {
+        sock.set_fixed_slot(std::move(*slot));
+    }
+}
+
+
+template <typename Proto, typename D, typename PollTraits, typename V>
+interface_proxy<Proto, D, PollTraits, V>::~interface_proxy()
+{
+    if (m_attach_event != -1)
+    {
+        ::close(m_attach_event);
+    }
+}
+
+
+template <typename Proto, typename D, typename PollTraits, typename V>
+void interface_proxy<Proto, D, PollTraits, V>::attach_queued()
+{
+    // reset wakeup counter before taking the queue, so attach after it signals again
+    eventfd_t value;
+    ::eventfd_read(m_attach_event, &value);
+    decltype(m_attached) attached;
+    {
+        std::lock_guard lock{m_attach_mutex};
+        if (m_attached.empty())
+        {
+            return;
+        }
+        attached.swap(m_attached);
+    }
+
+    auto& derived = static_cast<D&>(*this);
+    std::lock_guard lock{derived.m_mutex};
+    for (auto& [sock, on_attached]: attached)
+    {
+        // readiness, that came while connection was queued, is reported by poll on addition
+        PollTraits::add_socket(derived.poll, sock.native_handle(), sock::sock_op::READ);
+        sock.set_metrics(metrics::metrics_ref{derived.m_metrics});
+        if (on_attached)
+        {
+            on_attached(std::move(sock));
+        }
+        else if (derived.m_on_conn)
+        {
+            derived.m_on_conn(std::move(sock));
+        }
+    }
+}
+
+
 template <typename Proto, typename D, typename PollTraits>
 bool interface_proxy<Proto, D, PollTraits, sock::is_connectionless_t<Proto>>::start(
         std::string const& address
         , std::uint_fast16_t port
         , std::function<void(accepted_sock_ref<Proto>&&)> on_conn
         , std::function<void()> on_close)
+{
+    // Type erasure
+    bool started = start_impl(
+            address
+            , port
+            , [on_conn = std::move(on_conn)](basic_send_recv_i<sock::proto_address_t<Proto>>&& sock)
+            {
+                on_conn(static_cast<accepted_sock_ref<Proto>&&>(sock));
+            }
+            , [on_close = std::move(on_close)](int) { on_close(); });
+    if (started)
+    {
+        m_sessions.reset();
+    }
+    return started;
+}
+
+
+template <typename Proto, typename D, typename PollTraits>
+bool interface_proxy<Proto, D, PollTraits, sock::is_connectionless_t<Proto>>::start(
+        std::string const& address
+        , std::uint_fast16_t port
+        , session_options const& options
+        , typename session_table<Proto>::on_session_t on_session
+        , typename session_table<Proto>::on_datagram_t on_datagram
+        , typename session_table<Proto>::on_session_t on_expire)
+{
+    auto& derived = static_cast<D&>(*this);
+    auto sessions = std::make_unique<session_table<Proto>>(
+            options
+            , std::move(on_session)
+            , std::move(on_datagram)
+            , std::move(on_expire));
+    auto* table = sessions.get();
+    bool started = start_impl(
+            address
+            , port
+            , [&derived, table](basic_send_recv_i<sock::proto_address_t<Proto>>&&)
+            {
+                table->demultiplex(std::get<sock::active_socket_t<Proto>>(derived.state));
+            }
+            , [table](int) { table->clear(); });
+    if (started)
+    {
+        m_sessions = std::move(sessions);
+    }
+    return started;
+}
+
+
+template <typename Proto, typename D, typename PollTraits>
+bool interface_proxy<Proto, D, PollTraits, sock::is_connectionless_t<Proto>>::start_impl(
+        std::string const& address
+        , std::uint_fast16_t port
+        , std::function<void(basic_send_recv_i<sock::proto_address_t<Proto>>&&)> on_conn
+        , std::function<void(int fd)> on_close
+        , bool reuse_address)
 {
     using utils::mbind;
     auto& derived = static_cast<D&>(*this);
     std::lock_guard lock{derived.m_mutex};
-    std::optional<sock::in_address_port_t> local_addr;
+    std::optional<sock::proto_address_t<Proto>> local_addr;
     if (derived.idle()
-        && (local_addr = utils::from_string_and_port(address, port)))
+        && (local_addr = utils::address_from_string<sock::proto_address_t<Proto>>(address, port)))
     {
         auto active = mbind(sock::socket_t<Proto>::create(derived.af)
-                , [&](sock::socket_t<Proto>&& sock)
+                , [&](sock::socket_t<Proto>&& sock) -> std::optional<sock::active_socket_t<Proto>>
                 {
+                    if (reuse_address && !sock.set_reuse_address(true))
+                    {
+                        return std::nullopt;
+                    }
                     return sock.bind(*local_addr);
                 });
         if (active)
         {
             derived.register_cbs();
+            derived.apply_timestamping(*active);
             PollTraits::add_socket(derived.poll, active->native_handle(), sock::sock_op::READ);
             derived.state = std::move(*active);
-            // Type erasure
-            derived.m_on_conn = [on_conn = std::move(on_conn)](send_recv_i&& sock)
-            {
-                on_conn(static_cast<accepted_sock_ref<Proto>&&>(sock));
-            };
-            derived.m_erase_active_socket = [on_close = std::move(on_close)](int) { on_close(); };
+            derived.m_on_conn = std::move(on_conn);
+            derived.m_erase_active_socket = std::move(on_close);
             return true;
         }
     }
@@ -80,13 +388,93 @@ bool interface_proxy<Proto, D, PollTraits, sock::is_connectionless_t<Proto>>::st
 }
 
 
+template <typename Proto, typename D, typename PollTraits>
+std::string interface_proxy<Proto, D, PollTraits, sock::is_connectionless_t<Proto>>::any_address() const
+{
+    return static_cast<D const&>(*this).af == sock::ipv6{} ? "::" : "0.0.0.0";
+}
+
+
+template <typename Proto, typename D, typename PollTraits>
+session_table<Proto>* interface_proxy<Proto, D, PollTraits, sock::is_connectionless_t<Proto>>::sessions() noexcept
+{
+    return m_sessions.get();
+}
+
+
+template <typename Proto, typename D, typename PollTraits>
+bool interface_proxy<Proto, D, PollTraits, sock::is_connectionless_t<Proto>>::join_group(
+        std::string const& group
+        , std::string const& iface) noexcept
+{
+    return multicast_membership(group, iface, true);
+}
+
+
+template <typename Proto, typename D, typename PollTraits>
+bool interface_proxy<Proto, D, PollTraits, sock::is_connectionless_t<Proto>>::leave_group(
+        std::string const& group
+        , std::string const& iface) noexcept
+{
+    return multicast_membership(group, iface, false);
+}
+
+
+template <typename Proto, typename D, typename PollTraits>
+bool interface_proxy<Proto, D, PollTraits, sock::is_connectionless_t<Proto>>::multicast_membership(
+        std::string const& group
+        , std::string const& iface
+        , bool join) noexcept
+{
+    auto& derived = static_cast<D&>(*this);
+    std::lock_guard lock{derived.m_mutex};
+    auto* sock = std::get_if<sock::active_socket_t<Proto>>(&derived.state);
+    auto group_addr = sock::in_address_t::create(group);
+    if (!sock || !group_addr)
+    {
+        return false;
+    }
+    else if (iface.empty())
+    {
+        return join ? sock->join_group(*group_addr) : sock->leave_group(*group_addr);
+    }
+    else if (auto iface_addr = sock::in_address_t::create(iface))
+    {
+        return join ? sock->join_group(*group_addr, *iface_addr) : sock->leave_group(*group_addr, *iface_addr);
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
+template <typename Proto, typename D, typename PollTraits>
+void interface_proxy<Proto, D, PollTraits, sock::is_connectionless_t<Proto>>::expire_sessions()
+{
+    if (m_sessions)
+    {
+        auto& derived = static_cast<D&>(*this);
+        std::lock_guard lock{derived.m_mutex};
+        m_sessions->expire(session_table<Proto>::session_t::clock_t::now());
+    }
+}
+
+
 template <typename Proto, typename Poll, typename PollTraits>
 void server_t<Proto, Poll, PollTraits>::stop() noexcept
 {
     std::lock_guard lock{m_mutex};
-    m_erase_active_socket(this->get_fd());
-    this->state = sock::socket_t<Proto>{this->af};
+    if (m_erase_active_socket)
+    {
+        m_erase_active_socket(this->get_fd());
+    }
     PollTraits::del_socket(this->poll, this->get_fd());
+    if constexpr (!Proto::is_connectionless)
+    {
+        PollTraits::del_socket(this->poll, this->m_attach_event);
+    }
+    this->state = std::optional<sock::socket_t<Proto>>{};
     unregister_cbs();
     m_on_conn = nullptr;
     m_erase_active_socket = nullptr;
@@ -96,34 +484,71 @@ void server_t<Proto, Poll, PollTraits>::stop() noexcept
 template <typename Proto, typename Poll, typename PollTraits>
 void server_t<Proto, Poll, PollTraits>::register_cbs()
 {
-    auto erase = [this](int fd)
+    auto erase = [this](int fd, metrics::disconnect_t reason)
     {
         std::lock_guard lock{m_mutex};
-        PollTraits::del_socket(this->poll, fd);
+        bool registered = PollTraits::del_socket(this->poll, fd);
+        // several termination events may be reported for one connection
+        if (registered && (Proto::is_connectionless || fd != this->get_fd()))
+        {
+            if constexpr (!Proto::is_connectionless)
+            {
+                --this->m_load;
+            }
+            this->m_metrics->disconnected(reason);
+        }
         this->m_erase_active_socket(fd);
     };
-    this->add(poll_event::event_type::PEER_CLOSED, erase);
-    this->add(poll_event::event_type::ERROR, erase);
-    this->add(poll_event::event_type::HANGUP, erase);
-    this->add(poll_event::event_type::EXCEPTION, erase);
+    this->add(poll_event::event_type::PEER_CLOSED, [erase](int fd) { erase(fd, metrics::disconnect_t::PEER_CLOSED); });
+    this->add(poll_event::event_type::ERROR, [this, erase](int fd)
+    {
+        if (failed(fd))
+        {
+            erase(fd, metrics::disconnect_t::ERROR);
+        }
+    });
+    this->add(poll_event::event_type::HANGUP, [erase](int fd) { erase(fd, metrics::disconnect_t::HANGUP); });
+    this->add(poll_event::event_type::EXCEPTION, [erase](int fd) { erase(fd, metrics::disconnect_t::EXCEPTION); });
     this->add(poll_event::event_type::READ_READY, [this](int fd)
     {
+        if constexpr (!Proto::is_connectionless)
+        {
+            // takes server's mutex itself
+            if (fd == this->m_attach_event)
+            {
+                this->attach_queued();
+                return;
+            }
+            // completions of connections served through fixed io
+            if (this->m_fixed_io && fd == this->m_fixed_io->native_handle())
+            {
+                this->m_fixed_io->reap();
+                return;
+            }
+        }
         std::lock_guard lock{m_mutex};
         if (fd == this->get_fd())
         {
             if constexpr (Proto::is_connectionless)
             {
-                this->m_on_conn(accepted_sock_ref<Proto>{this->state});
+                this->m_on_conn(accepted_sock_ref<Proto>{this->state, metrics::metrics_ref{this->m_metrics}});
             }
             else
             {
-                auto accepted = std::get<sock::listening_socket_t<Proto>>(this->state).accept();
-                if (accepted)
+                // edge triggered: drain accept queue, with exclusive wake up other processes won't do it
+                auto& listener = std::get<sock::listening_socket_t<Proto>>(this->state);
+                while (auto accepted = listener.accept())
                 {
+                    apply_timestamping(*accepted);
                     PollTraits::add_socket(this->poll, accepted->native_handle(), sock::sock_op::READ);
+                    ++this->m_load;
+                    this->m_metrics->accepted();
                     auto remote = accepted->remote();
                     assert(remote);
-                    this->m_on_conn(accepted_sock{*remote, std::move(*accepted)});
+                    metrics::metrics_ref account{this->m_metrics};
+                    accepted_sock conn{*remote, std::move(*accepted), std::move(account)};
+                    this->serve_fixed(conn);
+                    this->m_on_conn(std::move(conn));
                 }
             }
         }
@@ -142,10 +567,71 @@ void server_t<Proto, Poll, PollTraits>::unregister_cbs()
 }
 
 
+template <typename Proto, typename Poll, typename PollTraits>
+bool server_t<Proto, Poll, PollTraits>::set_timestamping(bool rx, on_tx_timestamp_t on_tx) noexcept
+{
+    static_assert(!sock::is_local_v<Proto>, "SO_TIMESTAMPING is supported by internet protocols only");
+    std::lock_guard lock{m_mutex};
+    m_timestamping = {rx, std::move(on_tx)};
+    if constexpr (Proto::is_connectionless)
+    {
+        auto* sock = std::get_if<sock::active_socket_t<Proto>>(&this->state);
+        return !sock || sock->set_timestamping(m_timestamping.rx, bool(m_timestamping.on_tx));
+    }
+    else
+    {
+        return true;
+    }
+}
+
+
+template <typename Proto, typename Poll, typename PollTraits>
+bool server_t<Proto, Poll, PollTraits>::apply_timestamping(sock::active_socket_t<Proto>& sock) noexcept
+{
+    if constexpr (sock::is_local_v<Proto>)
+    {
+        return true;
+    }
+    else
+    {
+        return !m_timestamping.enabled() || sock.set_timestamping(m_timestamping.rx, bool(m_timestamping.on_tx));
+    }
+}
+
+
+template <typename Proto, typename Poll, typename PollTraits>
+bool server_t<Proto, Poll, PollTraits>::failed(int fd) noexcept
+{
+    std::lock_guard lock{m_mutex};
+    // TX timestamps are queued to error queue, so they are reported as error readiness too
+    return !m_timestamping.on_tx || drain_error_queue(fd, this->af, m_timestamping.on_tx);
+}
+
+
 template <typename Proto, typename Poll, typename PollTraits>
 bool server_t<Proto, Poll, PollTraits>::proceed(std::chrono::milliseconds timeout)
 {
-    return endpoint_t<sum_of_server_states_t, Proto, Poll, PollTraits>::proceed(timeout);
+    if constexpr (!Proto::is_connectionless)
+    {
+        // operations queued by connections since last proceed are submitted in one batch
+        if (this->m_fixed_io)
+        {
+            this->m_fixed_io->submit();
+        }
+    }
+    auto proceeded = endpoint_t<sum_of_server_states_t, Proto, Poll, PollTraits>::proceed(timeout);
+    if constexpr (Proto::is_connectionless)
+    {
+        this->expire_sessions();
+    }
+    return proceeded;
+}
+
+
+template <typename Proto, typename Poll, typename PollTraits>
+metrics::metrics_snapshot server_t<Proto, Poll, PollTraits>::metrics() const noexcept
+{
+    return this->m_metrics->snapshot();
 }
 
 
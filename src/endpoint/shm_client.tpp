@@ -0,0 +1,228 @@
+namespace protei::endpoint
+{
+
+template <typename Poll, typename PollTraits>
+shm_client_t<Poll, PollTraits>::shm_client_t(Poll poller)
+    : endpoint_t<sum_of_client_states_t, sock::unix_stream, Poll, PollTraits>{std::move(poller), sock::local{}}
+{}
+
+
+template <typename Poll, typename PollTraits>
+bool shm_client_t<Poll, PollTraits>::start() noexcept
+{
+    using utils::mbind;
+    std::lock_guard lock{m_mutex};
+    return this->idle()
+           && mbind(sock::socket_t<sock::unix_stream>::create(this->af)
+            , [this](sock::socket_t<sock::unix_stream>&& sock) -> std::optional<bool>
+                    {
+                        this->register_cbs();
+                        PollTraits::add_socket(this->poll, sock.native_handle(), sock::sock_op::READ);
+                        this->state = std::move(sock);
+                        return true;
+                    });
+}
+
+
+template <typename Poll, typename PollTraits>
+void shm_client_t<Poll, PollTraits>::stop() noexcept
+{
+    std::lock_guard lock{m_mutex};
+    if (m_channel)
+    {
+        PollTraits::del_socket(this->poll, m_channel->event_fd());
+        m_channel.reset();
+    }
+    PollTraits::del_socket(this->poll, this->get_fd());
+    this->state = std::optional<sock::socket_t<sock::unix_stream>>{};
+    m_remote.reset();
+    unregister_cbs();
+}
+
+
+template <typename Poll, typename PollTraits>
+bool shm_client_t<Poll, PollTraits>::connect(
+        std::string const& remote_address
+        , std::function<void()> on_connect
+        , std::function<void()> on_read_ready
+        , std::function<void()> on_disconnect) noexcept
+{
+    std::lock_guard lock{m_mutex};
+    auto* sock = std::get_if<std::optional<sock::socket_t<sock::unix_stream>>>(&this->state);
+    auto parsed = sock::unix_address_t::create(remote_address);
+    if (!sock || !*sock || !parsed)
+    {
+        return false;
+    }
+
+    auto connected = (*sock)->connect(*parsed);
+    if (!connected)
+    {
+        return false;
+    }
+
+    m_remote = *parsed;
+    m_on_connect = std::move(on_connect);
+    m_on_read_ready = std::move(on_read_ready);
+    m_on_disconnect = std::move(on_disconnect);
+    this->state = std::move(*connected);
+    return true;
+}
+
+
+template <typename Poll, typename PollTraits>
+bool shm_client_t<Poll, PollTraits>::connected() const noexcept
+{
+    std::lock_guard lock{m_mutex};
+    return m_channel.has_value();
+}
+
+
+template <typename Poll, typename PollTraits>
+int shm_client_t<Poll, PollTraits>::writable_fd() const noexcept
+{
+    std::lock_guard lock{m_mutex};
+    return m_channel ? m_channel->writable_fd() : -1;
+}
+
+
+template <typename Poll, typename PollTraits>
+void shm_client_t<Poll, PollTraits>::handshake()
+{
+    auto* sock = std::get_if<sock::active_socket_t<sock::unix_stream>>(&this->state);
+    if (!sock || m_channel)
+    {
+        return;
+    }
+
+    char hello;
+    shm::shm_channel::fds_t fds{};
+    std::size_t fds_count = fds.size();
+    auto received = sock->receive_fds(&hello, sizeof(hello), fds.data(), fds_count);
+    if (received && (m_channel = shm::shm_channel::adopt(fds.data(), fds_count)))
+    {
+        PollTraits::add_socket(this->poll, m_channel->event_fd(), sock::sock_op::READ);
+        if (m_on_connect)
+        {
+            m_on_connect();
+            m_on_connect = nullptr;
+        }
+    }
+}
+
+
+template <typename Poll, typename PollTraits>
+void shm_client_t<Poll, PollTraits>::disconnect(int fd)
+{
+    std::lock_guard lock{m_mutex};
+    if (fd == this->get_fd())
+    {
+        PollTraits::del_socket(this->poll, fd);
+        if (m_channel)
+        {
+            PollTraits::del_socket(this->poll, m_channel->event_fd());
+        }
+        if (m_on_disconnect)
+        {
+            m_on_disconnect();
+            m_on_disconnect = nullptr;
+        }
+    }
+}
+
+
+template <typename Poll, typename PollTraits>
+void shm_client_t<Poll, PollTraits>::unregister_cbs()
+{
+    this->remove(poll_event::event_type::PEER_CLOSED);
+    this->remove(poll_event::event_type::ERROR);
+    this->remove(poll_event::event_type::HANGUP);
+    this->remove(poll_event::event_type::EXCEPTION);
+    this->remove(poll_event::event_type::READ_READY);
+}
+
+
+template <typename Poll, typename PollTraits>
+void shm_client_t<Poll, PollTraits>::register_cbs()
+{
+    auto erase = [this](int fd) { disconnect(fd); };
+    this->add(poll_event::event_type::PEER_CLOSED, erase);
+    this->add(poll_event::event_type::ERROR, erase);
+    this->add(poll_event::event_type::HANGUP, erase);
+    this->add(poll_event::event_type::EXCEPTION, erase);
+    this->add(poll_event::event_type::READ_READY, [this](int fd)
+    {
+        std::lock_guard lock{m_mutex};
+        if (fd == this->get_fd())
+        {
+            handshake();
+        }
+        else if (m_channel && fd == m_channel->event_fd() && m_on_read_ready)
+        {
+            m_on_read_ready();
+        }
+    });
+}
+
+
+template <typename Poll, typename PollTraits>
+bool shm_client_t<Poll, PollTraits>::finished_recv_impl() const
+{
+    return !m_channel || m_channel->finished_recv();
+}
+
+
+template <typename Poll, typename PollTraits>
+bool shm_client_t<Poll, PollTraits>::finished_send_impl() const
+{
+    return !m_channel || m_channel->finished_send();
+}
+
+
+template <typename Poll, typename PollTraits>
+int shm_client_t<Poll, PollTraits>::trace_fd() const noexcept
+{
+    return this->get_fd();
+}
+
+
+template <typename Poll, typename PollTraits>
+std::optional<std::pair<sock::unix_address_t, std::size_t>>
+shm_client_t<Poll, PollTraits>::recv_impl(void* buffer, std::size_t n)
+{
+    if (m_channel)
+    {
+        return utils::mbind(m_channel->receive(buffer, n)
+                , [this](std::size_t recv) -> std::optional<std::pair<sock::unix_address_t, std::size_t>>
+                {
+                    return std::pair{ *m_remote, recv };
+                });
+    }
+    else
+    {
+        return std::nullopt;
+    }
+}
+
+
+template <typename Poll, typename PollTraits>
+std::optional<std::size_t> shm_client_t<Poll, PollTraits>::send_impl(void* buffer, std::size_t n)
+{
+    return m_channel ? m_channel->send(buffer, n) : std::nullopt;
+}
+
+
+template <typename Poll, typename PollTraits>
+bool shm_client_t<Poll, PollTraits>::proceed(std::chrono::milliseconds timeout)
+{
+    return endpoint_t<sum_of_client_states_t, sock::unix_stream, Poll, PollTraits>::proceed(timeout);
+}
+
+
+template <typename Poll, typename PollTraits>
+shm_client_t<Poll, PollTraits>::~shm_client_t()
+{
+    unregister_cbs();
+}
+
+}
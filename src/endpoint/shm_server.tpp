@@ -0,0 +1,139 @@
+namespace protei::endpoint
+{
+
+template <typename Poll, typename PollTraits>
+shm_server_t<Poll, PollTraits>::shm_server_t(Poll poller, std::size_t ring_capacity)
+    : endpoint_t<sum_of_server_states_t, sock::unix_stream, Poll, PollTraits>{std::move(poller), sock::local{}}
+    , m_ring_capacity{ring_capacity}
+{}
+
+
+template <typename Poll, typename PollTraits>
+bool shm_server_t<Poll, PollTraits>::start(
+        std::string const& address
+        , unsigned max_conns
+        , std::function<void(shm_accepted_sock&&)> on_conn
+        , std::function<void(int fd)> erase_active_socket) noexcept
+{
+    using utils::mbind;
+    std::lock_guard lock{m_mutex};
+    std::optional<sock::unix_address_t> addr;
+    if (this->idle() && (addr = sock::unix_address_t::create(address)))
+    {
+        auto listener = mbind(sock::socket_t<sock::unix_stream>::create(this->af)
+                , [&](sock::socket_t<sock::unix_stream>&& sock)
+                {
+                    return sock.bind(*addr);
+                }, [max_conns](sock::binded_socket_t<sock::unix_stream>&& sock)
+                {
+                    return sock.listen(max_conns);
+                });
+        if (listener)
+        {
+            register_cbs();
+            PollTraits::add_socket(this->poll, listener->native_handle(), sock::sock_op::READ);
+            this->state = std::move(*listener);
+            m_on_conn = std::move(on_conn);
+            m_erase_active_socket = std::move(erase_active_socket);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+template <typename Poll, typename PollTraits>
+void shm_server_t<Poll, PollTraits>::stop() noexcept
+{
+    std::lock_guard lock{m_mutex};
+    if (m_erase_active_socket)
+    {
+        m_erase_active_socket(this->get_fd());
+    }
+    PollTraits::del_socket(this->poll, this->get_fd());
+    this->state = std::optional<sock::socket_t<sock::unix_stream>>{};
+    unregister_cbs();
+    m_on_conn = nullptr;
+    m_erase_active_socket = nullptr;
+}
+
+
+template <typename Poll, typename PollTraits>
+void shm_server_t<Poll, PollTraits>::accept_all()
+{
+    auto& listener = std::get<sock::listening_socket_t<sock::unix_stream>>(this->state);
+    while (auto accepted = listener.accept())
+    {
+        auto channel = shm::shm_channel::create(m_ring_capacity);
+        if (!channel)
+        {
+            continue;
+        }
+
+        // socket buffer of just accepted connection is empty, so handshake is sent at once
+        char hello = 'S';
+        auto fds = channel->peer_fds();
+        if (accepted->send_fds(&hello, sizeof(hello), fds.data(), fds.size()))
+        {
+            PollTraits::add_socket(this->poll, accepted->native_handle(), sock::sock_op::READ);
+            PollTraits::add_socket(this->poll, channel->event_fd(), sock::sock_op::READ);
+            m_on_conn(shm_accepted_sock{std::move(*accepted), std::move(*channel)});
+        }
+    }
+}
+
+
+template <typename Poll, typename PollTraits>
+void shm_server_t<Poll, PollTraits>::register_cbs()
+{
+    auto erase = [this](int fd)
+    {
+        std::lock_guard lock{m_mutex};
+        PollTraits::del_socket(this->poll, fd);
+        this->m_erase_active_socket(fd);
+    };
+    this->add(poll_event::event_type::PEER_CLOSED, erase);
+    this->add(poll_event::event_type::ERROR, erase);
+    this->add(poll_event::event_type::HANGUP, erase);
+    this->add(poll_event::event_type::EXCEPTION, erase);
+    this->add(poll_event::event_type::READ_READY, [this](int fd)
+    {
+        std::lock_guard lock{m_mutex};
+        if (fd == this->get_fd())
+        {
+            accept_all();
+        }
+    });
+}
+
+
+template <typename Poll, typename PollTraits>
+void shm_server_t<Poll, PollTraits>::unregister_cbs()
+{
+    this->remove(poll_event::event_type::PEER_CLOSED);
+    this->remove(poll_event::event_type::ERROR);
+    this->remove(poll_event::event_type::HANGUP);
+    this->remove(poll_event::event_type::EXCEPTION);
+    this->remove(poll_event::event_type::READ_READY);
+}
+
+
+template <typename Poll, typename PollTraits>
+bool shm_server_t<Poll, PollTraits>::proceed(std::chrono::milliseconds timeout)
+{
+    return endpoint_t<sum_of_server_states_t, sock::unix_stream, Poll, PollTraits>::proceed(timeout);
+}
+
+
+template <typename Poll, typename PollTraits>
+shm_server_t<Poll, PollTraits>::~shm_server_t()
+{
+    if (m_erase_active_socket)
+    {
+        this->m_erase_active_socket(-1);
+    }
+    unregister_cbs();
+}
+
+}
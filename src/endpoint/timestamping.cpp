@@ -0,0 +1,19 @@
+#include <endpoint/timestamping.h>
+#include <socket/socket_impl.h>
+
+namespace protei::endpoint
+{
+
+bool drain_error_queue(int fd, int af, on_tx_timestamp_t const& on_tx) noexcept
+{
+    // socket_impl doesn't close descriptor on destruction, so it is used as view of endpoint's socket
+    sock::impl::socket_impl sock{fd, af};
+    while (auto ts = sock.receive_tx_timestamp())
+    {
+        on_tx(fd, *ts);
+    }
+    auto error = sock.pending_error();
+    return !error || *error != 0;
+}
+
+}
@@ -0,0 +1,253 @@
+namespace protei::endpoint
+{
+
+template <typename Proto, typename PollTraits>
+template <typename AF>
+server_t<Proto, uring::uring_t, PollTraits>::server_t(uring::uring_t ring, AF af, uring_options const& options) noexcept
+    : m_ring{std::move(ring)}
+    , m_af{static_cast<int>(af)}
+    , m_options{options}
+{}
+
+
+template <typename Proto, typename PollTraits>
+bool server_t<Proto, uring::uring_t, PollTraits>::start(
+        std::string const& address
+        , std::uint_fast16_t port
+        , unsigned max_conns
+        , std::function<void(accepted_sock<Proto>&&)> on_conn
+        , on_data_t on_data
+        , std::function<void(int fd)> erase_active_socket) noexcept
+{
+    using utils::mbind;
+    auto addr = utils::address_from_string<sock::proto_address_t<Proto>>(address, port);
+    if (m_listener || !addr)
+    {
+        return false;
+    }
+
+    auto listener = mbind(sock::socket_t<Proto>::create(m_af)
+            , [&](sock::socket_t<Proto>&& sock)
+            {
+                return sock.bind(*addr);
+            }
+            , [max_conns](sock::binded_socket_t<Proto>&& sock)
+            {
+                return sock.listen(max_conns);
+            });
+    return listener && start_impl(
+            std::move(*listener)
+            , std::move(on_conn)
+            , std::move(on_data)
+            , std::move(erase_active_socket));
+}
+
+
+template <typename Proto, typename PollTraits>
+bool server_t<Proto, uring::uring_t, PollTraits>::start(
+        int listening_fd
+        , unsigned max_conns
+        , std::function<void(accepted_sock<Proto>&&)> on_conn
+        , on_data_t on_data
+        , std::function<void(int fd)> erase_active_socket) noexcept
+{
+    if (m_listener)
+    {
+        return false;
+    }
+
+    auto listener = sock::listening_socket_t<Proto>::adopt(listening_fd, max_conns);
+    return listener && start_impl(
+            std::move(*listener)
+            , std::move(on_conn)
+            , std::move(on_data)
+            , std::move(erase_active_socket));
+}
+
+
+template <typename Proto, typename PollTraits>
+bool server_t<Proto, uring::uring_t, PollTraits>::start_impl(
+        sock::listening_socket_t<Proto>&& listener
+        , std::function<void(accepted_sock<Proto>&&)> on_conn
+        , on_data_t on_data
+        , std::function<void(int fd)> erase_active_socket) noexcept
+{
+    if (!m_buffers)
+    {
+        m_buffers = uring::provided_buffers::create(m_ring, 0, m_options.buffers, m_options.buffer_size);
+    }
+    if (!m_buffers
+        || !m_ring.accept_multishot(listener.native_handle(), user_data(ACCEPT_GENERATION, listener.native_handle()))
+        || !m_ring.submit())
+    {
+        return false;
+    }
+
+    m_listener = std::move(listener);
+    m_on_conn = std::move(on_conn);
+    m_on_data = std::move(on_data);
+    m_erase_active_socket = std::move(erase_active_socket);
+    return true;
+}
+
+
+template <typename Proto, typename PollTraits>
+bool server_t<Proto, uring::uring_t, PollTraits>::close(int fd) noexcept
+{
+    auto it = m_conns.find(fd);
+    if (it == m_conns.end())
+    {
+        return false;
+    }
+
+    // cancellation is submitted at once, so socket can be closed right after
+    m_ring.cancel(user_data(it->second, fd), user_data(CANCEL_GENERATION, fd));
+    m_ring.submit();
+    m_conns.erase(it);
+    return true;
+}
+
+
+template <typename Proto, typename PollTraits>
+bool server_t<Proto, uring::uring_t, PollTraits>::proceed(std::chrono::milliseconds timeout)
+{
+    m_completions.clear();
+    m_ring.proceed(timeout, m_completions);
+    for (auto const& completion: m_completions)
+    {
+        auto fd = static_cast<int>(completion.user_data & 0xffffffff);
+        auto generation = static_cast<std::uint32_t>(completion.user_data >> 32);
+        if (generation == ACCEPT_GENERATION)
+        {
+            on_accept(completion);
+        }
+        else if (generation != CANCEL_GENERATION)
+        {
+            on_recv(fd, generation, completion);
+        }
+    }
+    m_ring.submit();
+    return !m_completions.empty();
+}
+
+
+template <typename Proto, typename PollTraits>
+void server_t<Proto, uring::uring_t, PollTraits>::on_accept(uring::completion const& completion)
+{
+    if (!m_listener)
+    {
+        if (completion.result >= 0)
+        {
+            // accepted before stop was proceeded
+            ::close(completion.result);
+        }
+        return;
+    }
+
+    if (completion.result >= 0)
+    {
+        // closes descriptor if peer has already reset connection
+        auto sock = m_listener->accepted(completion.result);
+        if (sock && ++m_generation == CANCEL_GENERATION)
+        {
+            m_generation = ACCEPT_GENERATION + 1;
+        }
+        if (sock && m_ring.recv_multishot(sock->native_handle(), m_buffers->group(), user_data(m_generation, sock->native_handle())))
+        {
+            m_conns[sock->native_handle()] = m_generation;
+            auto remote = *sock->remote();
+            m_on_conn(accepted_sock<Proto>{remote, std::move(*sock)});
+        }
+    }
+
+    if (!completion.more)
+    {
+        // multishot accept is terminated by kernel, e.g. on error
+        m_ring.accept_multishot(m_listener->native_handle(), user_data(ACCEPT_GENERATION, m_listener->native_handle()));
+    }
+}
+
+
+template <typename Proto, typename PollTraits>
+void server_t<Proto, uring::uring_t, PollTraits>::on_recv(
+        int fd
+        , std::uint32_t generation
+        , uring::completion const& completion)
+{
+    auto it = m_conns.find(fd);
+    bool served = it != m_conns.end() && it->second == generation;
+    if (completion.buffer)
+    {
+        if (served && completion.result > 0)
+        {
+            m_on_data(fd, std::string_view{
+                    m_buffers->data(*completion.buffer)
+                    , static_cast<std::size_t>(completion.result)});
+        }
+        m_buffers->recycle(*completion.buffer);
+    }
+
+    // connection may be closed by on_data
+    it = m_conns.find(fd);
+    if (it == m_conns.end() || it->second != generation || completion.more)
+    {
+        return;
+    }
+
+    if (completion.result > 0 || completion.result == -ENOBUFS)
+    {
+        // multishot recv is terminated by kernel, e.g. when provided buffers are exhausted
+        m_ring.recv_multishot(fd, m_buffers->group(), user_data(generation, fd));
+    }
+    else
+    {
+        m_conns.erase(it);
+        m_erase_active_socket(fd);
+    }
+}
+
+
+template <typename Proto, typename PollTraits>
+void server_t<Proto, uring::uring_t, PollTraits>::stop() noexcept
+{
+    if (!m_listener)
+    {
+        return;
+    }
+
+    auto fd = m_listener->native_handle();
+    m_ring.cancel(user_data(ACCEPT_GENERATION, fd), user_data(CANCEL_GENERATION, fd));
+    m_ring.submit();
+    if (m_erase_active_socket)
+    {
+        m_erase_active_socket(fd);
+    }
+    m_listener.reset();
+    m_on_conn = nullptr;
+}
+
+
+template <typename Proto, typename PollTraits>
+std::size_t server_t<Proto, uring::uring_t, PollTraits>::load() const noexcept
+{
+    return m_conns.size();
+}
+
+
+template <typename Proto, typename PollTraits>
+std::uint64_t server_t<Proto, uring::uring_t, PollTraits>::user_data(std::uint32_t generation, int fd) noexcept
+{
+    return std::uint64_t{generation} << 32 | static_cast<std::uint32_t>(fd);
+}
+
+
+template <typename Proto, typename PollTraits>
+server_t<Proto, uring::uring_t, PollTraits>::~server_t()
+{
+    if (m_erase_active_socket)
+    {
+        m_erase_active_socket(-1);
+    }
+}
+
+}
@@ -57,15 +57,18 @@ std::optional<epoll::epoll_t> epoll_t::create(int queue_size, unsigned max_event
 }
 
 
-bool epoll_t::add_socket(int sock_fd, sock::sock_op op) noexcept
+bool epoll_t::add_socket(int sock_fd, sock::sock_op op, bool exclusive) noexcept
 {
-    return epoll_ctl(sock_fd, EPOLL_CTL_ADD, op);
+    return epoll_ctl(sock_fd, EPOLL_CTL_ADD, op, exclusive);
 }
 
 
-std::uint_fast32_t epoll_t::flags_from_op(sock::sock_op op) noexcept
+std::uint_fast32_t epoll_t::flags_from_op(sock::sock_op op, bool exclusive) noexcept
 {
-    std::uint_fast32_t flags = EPOLLRDHUP | EPOLLET | EPOLLPRI | EPOLLERR | EPOLLHUP;
+    // EPOLLEXCLUSIVE is rejected in combination with EPOLLRDHUP and EPOLLPRI
+    std::uint_fast32_t flags = exclusive
+            ? EPOLLEXCLUSIVE | EPOLLET | EPOLLERR | EPOLLHUP
+            : EPOLLRDHUP | EPOLLET | EPOLLPRI | EPOLLERR | EPOLLHUP;
     switch (op)
     {
         case sock::sock_op::READ:
@@ -91,13 +94,13 @@ bool epoll_t::mod_socket(int sock_fd, sock::sock_op op) noexcept
 }
 
 
-bool epoll_t::epoll_ctl(int sock_fd, int ctl_op, std::optional<sock::sock_op> op) noexcept
+bool epoll_t::epoll_ctl(int sock_fd, int ctl_op, std::optional<sock::sock_op> op, bool exclusive) noexcept
 {
     std::uint_fast32_t flags;
     epoll_event event{}, * event_ptr = nullptr;
     if (op)
     {
-        flags = flags_from_op(*op);
+        flags = flags_from_op(*op, exclusive);
         event.events = static_cast<uint32_t>(flags);
         event.data.fd = sock_fd;
         event_ptr = &event;
@@ -115,27 +118,39 @@ bool epoll_t::del_socket(int sock_fd) noexcept
 
 std::vector<poll_event::event> epoll_t::proceed(std::chrono::milliseconds timeout) noexcept
 {
-    static thread_local std::vector<epoll_event> events(m_max_events);
+    std::vector<poll_event::event> ret_events;
+    proceed(timeout, ret_events);
+    return ret_events;
+}
+
+
+std::size_t epoll_t::proceed(std::chrono::milliseconds timeout, std::vector<poll_event::event>& events) noexcept
+{
+    // shared by epolls of thread, so sized by the largest one
+    static thread_local std::vector<epoll_event> epoll_events;
+    if (epoll_events.size() < m_max_events)
+    {
+        epoll_events.resize(m_max_events);
+    }
     auto events_cnt = epoll_wait(
             m_fd
-            , events.data()
+            , epoll_events.data()
             , static_cast<int>(m_max_events)
             , static_cast<int>(timeout.count()));
 
-    std::vector<poll_event::event> ret_events;
-    if (events_cnt > 0)
+    if (events_cnt <= 0)
     {
-        std::transform(
-                events.begin()
-                , events.begin() + events_cnt
-                , std::back_inserter(ret_events)
-                , [](epoll_event const& epoll_event) noexcept
-                {
-                    return poll_event::event{epoll_event.data.fd, event_type_from_flags(epoll_event.events)};
-                });
+        return 0;
     }
-
-    return ret_events;
+    std::transform(
+            epoll_events.begin()
+            , epoll_events.begin() + events_cnt
+            , std::back_inserter(events)
+            , [](epoll_event const& epoll_event) noexcept
+            {
+                return poll_event::event{epoll_event.data.fd, event_type_from_flags(epoll_event.events)};
+            });
+    return static_cast<std::size_t>(events_cnt);
 }
 
 
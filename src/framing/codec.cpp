@@ -0,0 +1,160 @@
+#include <framing/codec.h>
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+
+namespace protei::framing
+{
+
+length_prefix_codec::length_prefix_codec(prefix_t prefix, std::size_t max_frame) noexcept
+    : m_prefix{prefix}
+    , m_max_frame{max_frame}
+{}
+
+
+frame_t length_prefix_codec::find(ring_buffer const& ring) noexcept
+{
+    frame_t frame;
+    std::size_t length = 0;
+    std::size_t header = 0;
+    if (m_prefix == prefix_t::VARINT)
+    {
+        for (unsigned shift = 0; ; shift += 7)
+        {
+            if (header == ring.size())
+            {
+                return frame;
+            }
+            if (header == MAX_HEADER_SIZE)
+            {
+                frame.status = frame_t::status_t::MALFORMED;
+                return frame;
+            }
+            auto byte = static_cast<std::uint8_t>(ring.at(header++));
+            length |= static_cast<std::size_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+            {
+                break;
+            }
+        }
+    }
+    else
+    {
+        header = m_prefix == prefix_t::U8 ? 1 : m_prefix == prefix_t::U16 ? 2 : 4;
+        if (ring.size() < header)
+        {
+            return frame;
+        }
+        for (std::size_t i = 0; i < header; ++i)
+        {
+            length = (length << 8) | static_cast<std::uint8_t>(ring.at(i));
+        }
+    }
+
+    if (length > m_max_frame)
+    {
+        frame.status = frame_t::status_t::MALFORMED;
+    }
+    else if (ring.size() - header >= length)
+    {
+        frame = {frame_t::status_t::COMPLETE, header, length, header + length};
+    }
+    return frame;
+}
+
+
+std::size_t length_prefix_codec::header(std::size_t size, char* out) const noexcept
+{
+    if (m_prefix == prefix_t::VARINT)
+    {
+        std::size_t header = 0;
+        do
+        {
+            auto byte = static_cast<std::uint8_t>(size & 0x7f);
+            size >>= 7;
+            out[header++] = static_cast<char>(size ? byte | 0x80 : byte);
+        } while (size);
+        return header;
+    }
+
+    std::size_t header = m_prefix == prefix_t::U8 ? 1 : m_prefix == prefix_t::U16 ? 2 : 4;
+    if (header < sizeof(size) && size >> (header * 8))
+    {
+        return 0;
+    }
+    for (std::size_t i = header; i > 0; --i, size >>= 8)
+    {
+        out[i - 1] = static_cast<char>(size & 0xff);
+    }
+    return header;
+}
+
+
+std::size_t length_prefix_codec::trailer(std::size_t, char*) const noexcept
+{
+    return 0;
+}
+
+
+delimiter_codec::delimiter_codec(char delimiter, std::size_t max_frame) noexcept
+    : m_delimiter{delimiter}
+    , m_max_frame{max_frame}
+{}
+
+
+frame_t delimiter_codec::find(ring_buffer const& ring) noexcept
+{
+    frame_t frame;
+    auto [first, second] = ring.readable();
+    // memchr is vectorized by libc
+    std::optional<std::size_t> found;
+    if (m_scanned < first.size())
+    {
+        if (auto* pos = std::memchr(first.data() + m_scanned, m_delimiter, first.size() - m_scanned))
+        {
+            found = static_cast<char const*>(pos) - first.data();
+        }
+    }
+    if (!found)
+    {
+        auto from = std::max(m_scanned, first.size()) - first.size();
+        if (from < second.size())
+        {
+            if (auto* pos = std::memchr(second.data() + from, m_delimiter, second.size() - from))
+            {
+                found = first.size() + (static_cast<char const*>(pos) - second.data());
+            }
+        }
+    }
+
+    if (found && *found <= m_max_frame)
+    {
+        m_scanned = 0;
+        frame = {frame_t::status_t::COMPLETE, 0, *found, *found + 1};
+    }
+    else if (found || ring.size() > m_max_frame)
+    {
+        frame.status = frame_t::status_t::MALFORMED;
+    }
+    else
+    {
+        m_scanned = ring.size();
+    }
+    return frame;
+}
+
+
+std::size_t delimiter_codec::header(std::size_t, char*) const noexcept
+{
+    return 0;
+}
+
+
+std::size_t delimiter_codec::trailer(std::size_t, char* out) const noexcept
+{
+    *out = m_delimiter;
+    return 1;
+}
+
+}
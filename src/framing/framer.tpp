@@ -0,0 +1,105 @@
+namespace protei::framing
+{
+
+template <typename Codec>
+framer_t<Codec>::framer_t(Codec codec, std::size_t capacity)
+    : m_codec{std::move(codec)}
+    , m_ring{capacity}
+{}
+
+
+template <typename Codec>
+framer_t<Codec>::framer_t(Codec codec, buffer::buffer_pool& pool, std::size_t capacity)
+    : m_codec{std::move(codec)}
+    , m_ring{pool, capacity}
+{}
+
+
+template <typename Codec>
+template <typename Sock, typename Handler>
+std::optional<std::size_t> framer_t<Codec>::read(Sock& sock, Handler&& handler)
+{
+    std::size_t frames = 0;
+    while (true)
+    {
+        auto [buffer, n] = m_ring.write_area();
+        if (n == 0)
+        {
+            // full ring without complete frame
+            return std::nullopt;
+        }
+
+        auto rec = sock.recv(buffer, n);
+        if (!rec || rec->second == 0)
+        {
+            m_ring.release();
+            return frames;
+        }
+
+        m_ring.commit(rec->second);
+        auto dispatched = dispatch(handler);
+        if (!dispatched)
+        {
+            return std::nullopt;
+        }
+        frames += *dispatched;
+        if (rec->second < n)
+        {
+            // short read drains stream socket, edge triggered poll reports next data: no EAGAIN probe
+            m_ring.release();
+            return frames;
+        }
+    }
+}
+
+
+template <typename Codec>
+template <typename Sock>
+std::optional<std::size_t> framer_t<Codec>::write(Sock& sock, std::string_view payload)
+{
+    char header[Codec::MAX_HEADER_SIZE + 1];
+    char trailer[Codec::MAX_TRAILER_SIZE + 1];
+    auto header_size = m_codec.header(payload.size(), header);
+    auto trailer_size = m_codec.trailer(payload.size(), trailer);
+    if (header_size + trailer_size == 0)
+    {
+        return std::nullopt;
+    }
+
+    m_out.clear();
+    m_out.append(header, header_size).append(payload).append(trailer, trailer_size);
+    return sock.send(m_out.data(), m_out.size());
+}
+
+
+template <typename Codec>
+std::size_t framer_t<Codec>::pending() const noexcept
+{
+    return m_ring.size();
+}
+
+
+template <typename Codec>
+template <typename Handler>
+std::optional<std::size_t> framer_t<Codec>::dispatch(Handler& handler)
+{
+    std::size_t frames = 0;
+    while (true)
+    {
+        auto frame = m_codec.find(m_ring);
+        if (frame.status == frame_t::status_t::MALFORMED)
+        {
+            return std::nullopt;
+        }
+        else if (frame.status == frame_t::status_t::INCOMPLETE)
+        {
+            return frames;
+        }
+
+        handler(m_ring.view(frame.offset, frame.size, m_scratch));
+        m_ring.consume(frame.consumed);
+        ++frames;
+    }
+}
+
+}
@@ -0,0 +1,125 @@
+#include <framing/ring_buffer.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace protei::framing
+{
+
+static std::size_t round_up_pow2(std::size_t value) noexcept
+{
+    std::size_t ret = 1;
+    while (ret < value)
+    {
+        ret <<= 1;
+    }
+    return ret;
+}
+
+
+ring_buffer::ring_buffer(std::size_t capacity)
+    : m_own{new char[round_up_pow2(capacity)]}
+    , m_data{m_own.get()}
+    , m_mask{round_up_pow2(capacity) - 1}
+{}
+
+
+ring_buffer::ring_buffer(buffer::buffer_pool& pool, std::size_t capacity) noexcept
+    : m_pool{&pool}
+    , m_data{nullptr}
+    , m_mask{round_up_pow2(capacity) - 1}
+{}
+
+
+std::pair<char*, std::size_t> ring_buffer::write_area() noexcept
+{
+    if (!m_data)
+    {
+        m_borrowed = m_pool->acquire(capacity());
+        m_data = m_borrowed.data();
+        if (!m_data)
+        {
+            return {nullptr, 0};
+        }
+    }
+
+    auto offset = m_tail & m_mask;
+    return {m_data + offset, std::min(capacity() - size(), capacity() - offset)};
+}
+
+
+void ring_buffer::commit(std::size_t n) noexcept
+{
+    assert(n <= capacity() - size());
+    m_tail += n;
+}
+
+
+void ring_buffer::consume(std::size_t n) noexcept
+{
+    assert(n <= size());
+    m_head += n;
+    if (m_head == m_tail)
+    {
+        // keeps next frames contiguous
+        m_head = m_tail = 0;
+        release();
+    }
+}
+
+
+void ring_buffer::release() noexcept
+{
+    if (m_borrowed && size() == 0)
+    {
+        m_borrowed.release();
+        m_data = nullptr;
+    }
+}
+
+
+std::pair<std::string_view, std::string_view> ring_buffer::readable() const noexcept
+{
+    auto offset = m_head & m_mask;
+    auto first = std::min(size(), capacity() - offset);
+    return {{m_data + offset, first}, {m_data, size() - first}};
+}
+
+
+std::string_view ring_buffer::view(std::size_t offset, std::size_t n, std::string& scratch) const
+{
+    assert(offset + n <= size());
+    auto begin = (m_head + offset) & m_mask;
+    if (begin + n <= capacity())
+    {
+        return {m_data + begin, n};
+    }
+
+    auto first = capacity() - begin;
+    scratch.resize(n);
+    std::memcpy(scratch.data(), m_data + begin, first);
+    std::memcpy(scratch.data() + first, m_data, n - first);
+    return scratch;
+}
+
+
+char ring_buffer::at(std::size_t offset) const noexcept
+{
+    assert(offset < size());
+    return m_data[(m_head + offset) & m_mask];
+}
+
+
+std::size_t ring_buffer::size() const noexcept
+{
+    return m_tail - m_head;
+}
+
+
+std::size_t ring_buffer::capacity() const noexcept
+{
+    return m_mask + 1;
+}
+
+}
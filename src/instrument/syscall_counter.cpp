@@ -0,0 +1,191 @@
+#include <instrument/syscall_counter.h>
+
+#include <dlfcn.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+#include <cerrno>
+#include <utility>
+
+namespace protei::instrument
+{
+
+namespace
+{
+
+thread_local syscall_stats counters;
+
+/**
+ * @brief Resolve libc function hidden by definition of this library
+ */
+template <typename F>
+F next(char const* name) noexcept
+{
+    return reinterpret_cast<F>(::dlsym(RTLD_NEXT, name));
+}
+
+/**
+ * @brief Forward call to libc and count it
+ */
+template <typename Ret, typename F, typename... Args>
+Ret counted(syscall_t call, F real, Args... args) noexcept
+{
+    auto ret = real(args...);
+    auto index = static_cast<std::size_t>(call);
+    ++counters.calls[index];
+    if (ret == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+    {
+        ++counters.would_block[index];
+    }
+    return ret;
+}
+
+}
+
+
+char const* syscall_name(syscall_t call) noexcept
+{
+    switch (call)
+    {
+        case syscall_t::SEND: return "send";
+        case syscall_t::RECV: return "recv";
+        case syscall_t::SENDTO: return "sendto";
+        case syscall_t::RECVFROM: return "recvfrom";
+        case syscall_t::SENDMSG: return "sendmsg";
+        case syscall_t::RECVMSG: return "recvmsg";
+        case syscall_t::RECVMMSG: return "recvmmsg";
+        case syscall_t::ACCEPT: return "accept";
+        case syscall_t::EPOLL_WAIT: return "epoll_wait";
+        case syscall_t::EPOLL_CTL: return "epoll_ctl";
+        case syscall_t::COUNT: break;
+    }
+    return "unknown";
+}
+
+
+std::uint64_t syscall_stats::total() const noexcept
+{
+    std::uint64_t ret = 0;
+    for (auto count: calls)
+    {
+        ret += count;
+    }
+    return ret;
+}
+
+
+std::uint64_t syscall_stats::total_blocked() const noexcept
+{
+    std::uint64_t ret = 0;
+    for (auto count: would_block)
+    {
+        ret += count;
+    }
+    return ret;
+}
+
+
+syscall_stats syscall_stats::operator-(syscall_stats const& other) const noexcept
+{
+    syscall_stats ret;
+    for (std::size_t i = 0; i < calls.size(); ++i)
+    {
+        ret.calls[i] = calls[i] - other.calls[i];
+        ret.would_block[i] = would_block[i] - other.would_block[i];
+    }
+    return ret;
+}
+
+
+syscall_stats thread_syscalls() noexcept
+{
+    return counters;
+}
+
+}
+
+
+using protei::instrument::counted;
+using protei::instrument::next;
+using protei::instrument::syscall_t;
+
+extern "C"
+{
+
+ssize_t send(int fd, void const* buf, std::size_t n, int flags)
+{
+    static auto real = next<ssize_t (*)(int, void const*, std::size_t, int)>("send");
+    return counted<ssize_t>(syscall_t::SEND, real, fd, buf, n, flags);
+}
+
+
+ssize_t recv(int fd, void* buf, std::size_t n, int flags)
+{
+    static auto real = next<ssize_t (*)(int, void*, std::size_t, int)>("recv");
+    return counted<ssize_t>(syscall_t::RECV, real, fd, buf, n, flags);
+}
+
+
+ssize_t sendto(int fd, void const* buf, std::size_t n, int flags, sockaddr const* addr, socklen_t addr_len)
+{
+    static auto real = next<ssize_t (*)(int, void const*, std::size_t, int, sockaddr const*, socklen_t)>("sendto");
+    return counted<ssize_t>(syscall_t::SENDTO, real, fd, buf, n, flags, addr, addr_len);
+}
+
+
+ssize_t recvfrom(int fd, void* buf, std::size_t n, int flags, sockaddr* addr, socklen_t* addr_len)
+{
+    static auto real = next<ssize_t (*)(int, void*, std::size_t, int, sockaddr*, socklen_t*)>("recvfrom");
+    return counted<ssize_t>(syscall_t::RECVFROM, real, fd, buf, n, flags, addr, addr_len);
+}
+
+
+ssize_t sendmsg(int fd, msghdr const* msg, int flags)
+{
+    static auto real = next<ssize_t (*)(int, msghdr const*, int)>("sendmsg");
+    return counted<ssize_t>(syscall_t::SENDMSG, real, fd, msg, flags);
+}
+
+
+ssize_t recvmsg(int fd, msghdr* msg, int flags)
+{
+    static auto real = next<ssize_t (*)(int, msghdr*, int)>("recvmsg");
+    return counted<ssize_t>(syscall_t::RECVMSG, real, fd, msg, flags);
+}
+
+
+int recvmmsg(int fd, mmsghdr* msgs, unsigned int count, int flags, timespec* timeout)
+{
+    static auto real = next<int (*)(int, mmsghdr*, unsigned int, int, timespec*)>("recvmmsg");
+    return counted<int>(syscall_t::RECVMMSG, real, fd, msgs, count, flags, timeout);
+}
+
+
+int accept(int fd, sockaddr* addr, socklen_t* addr_len)
+{
+    static auto real = next<int (*)(int, sockaddr*, socklen_t*)>("accept");
+    return counted<int>(syscall_t::ACCEPT, real, fd, addr, addr_len);
+}
+
+
+int accept4(int fd, sockaddr* addr, socklen_t* addr_len, int flags)
+{
+    static auto real = next<int (*)(int, sockaddr*, socklen_t*, int)>("accept4");
+    return counted<int>(syscall_t::ACCEPT, real, fd, addr, addr_len, flags);
+}
+
+
+int epoll_wait(int epfd, epoll_event* events, int max_events, int timeout)
+{
+    static auto real = next<int (*)(int, epoll_event*, int, int)>("epoll_wait");
+    return counted<int>(syscall_t::EPOLL_WAIT, real, epfd, events, max_events, timeout);
+}
+
+
+int epoll_ctl(int epfd, int op, int fd, epoll_event* event) noexcept
+{
+    static auto real = next<int (*)(int, int, int, epoll_event*)>("epoll_ctl");
+    return counted<int>(syscall_t::EPOLL_CTL, real, epfd, op, fd, event);
+}
+
+}
@@ -0,0 +1,31 @@
+#include <metrics/endpoint_metrics.h>
+
+namespace protei::metrics
+{
+
+#ifndef PROTEI_NO_METRICS
+
+metrics_snapshot endpoint_metrics::snapshot() const noexcept
+{
+    metrics_snapshot ret;
+    ret.bytes_in = m_bytes_in.load(std::memory_order_relaxed);
+    ret.bytes_out = m_bytes_out.load(std::memory_order_relaxed);
+    ret.messages_in = m_messages_in.load(std::memory_order_relaxed);
+    ret.messages_out = m_messages_out.load(std::memory_order_relaxed);
+    ret.accepts = m_accepts.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < m_disconnects.size(); ++i)
+    {
+        ret.disconnects[i] = m_disconnects[i].load(std::memory_order_relaxed);
+    }
+    ret.eagain = m_eagain.load(std::memory_order_relaxed);
+    ret.proceeds = m_proceeds.load(std::memory_order_relaxed);
+    ret.events = m_events.load(std::memory_order_relaxed);
+    ret.events_per_proceed = m_events_per_proceed.snapshot();
+    ret.handler_ns = m_handler.snapshot();
+    ret.loop_lag_ns = m_loop_lag.snapshot();
+    return ret;
+}
+
+#endif
+
+}
@@ -0,0 +1,66 @@
+#include <metrics/histogram.h>
+
+#include <cmath>
+
+namespace protei::metrics
+{
+
+double histogram_snapshot::mean() const noexcept
+{
+    return count ? static_cast<double>(sum) / count : 0.;
+}
+
+
+std::uint64_t histogram_snapshot::percentile(double quantile) const noexcept
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    else if (quantile >= 1.)
+    {
+        return max;
+    }
+
+    auto rank = static_cast<std::uint64_t>(std::ceil(quantile * count));
+    rank = rank ? rank : 1;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+        {
+            // bucket bound may exceed any recorded value
+            auto bound = log_linear::upper_bound(i);
+            return bound < max ? bound : max;
+        }
+    }
+    return max;
+}
+
+
+std::uint64_t histogram_snapshot::count_below(std::uint64_t bound) const noexcept
+{
+    std::uint64_t ret = 0;
+    for (std::size_t i = 0; i < buckets.size() && log_linear::upper_bound(i) < bound; ++i)
+    {
+        ret += buckets[i];
+    }
+    return ret;
+}
+
+
+histogram_snapshot histogram::snapshot() const noexcept
+{
+    histogram_snapshot ret;
+    for (std::size_t i = 0; i < m_buckets.size(); ++i)
+    {
+        ret.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+        ret.count += ret.buckets[i];
+    }
+    ret.sum = m_sum.load(std::memory_order_relaxed);
+    ret.max = m_max.load(std::memory_order_relaxed);
+    return ret;
+}
+
+}
@@ -0,0 +1,202 @@
+#include <shm/shm_channel.h>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace protei::shm
+{
+
+std::optional<shm_channel> shm_channel::create(std::size_t capacity) noexcept
+{
+    auto tx = spsc_ring::create(capacity);
+    auto rx = spsc_ring::create(capacity);
+    std::array<int, 4> events{};
+    for (auto& event: events)
+    {
+        event = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    }
+    if (tx && rx && std::find(events.begin(), events.end(), -1) == events.end())
+    {
+        return shm_channel{std::move(*tx), std::move(*rx), events[0], events[1], events[2], events[3]};
+    }
+
+    for (int event: events)
+    {
+        if (event != -1)
+        {
+            ::close(event);
+        }
+    }
+    return std::nullopt;
+}
+
+
+std::optional<shm_channel> shm_channel::adopt(int const* fds, std::size_t fds_count) noexcept
+{
+    if (fds_count != FDS_COUNT)
+    {
+        for (std::size_t i = 0; i < fds_count; ++i)
+        {
+            ::close(fds[i]);
+        }
+        return std::nullopt;
+    }
+
+    // peer's receiving side is ours sending one
+    auto tx = spsc_ring::attach(fds[0]);
+    auto rx = spsc_ring::attach(fds[1]);
+    if (tx && rx)
+    {
+        return shm_channel{std::move(*tx), std::move(*rx), fds[2], fds[3], fds[4], fds[5]};
+    }
+
+    for (std::size_t i = 2; i < FDS_COUNT; ++i)
+    {
+        ::close(fds[i]);
+    }
+    return std::nullopt;
+}
+
+
+shm_channel::shm_channel(
+        spsc_ring&& tx
+        , spsc_ring&& rx
+        , int tx_event
+        , int rx_event
+        , int tx_writable
+        , int rx_writable) noexcept
+    : m_tx{std::move(tx)}
+    , m_rx{std::move(rx)}
+    , m_tx_event{tx_event}
+    , m_rx_event{rx_event}
+    , m_tx_writable{tx_writable}
+    , m_rx_writable{rx_writable}
+{}
+
+
+shm_channel::~shm_channel()
+{
+    release();
+}
+
+
+shm_channel::shm_channel(shm_channel&& other) noexcept
+    : m_tx{std::move(other.m_tx)}
+    , m_rx{std::move(other.m_rx)}
+    , m_tx_event{std::exchange(other.m_tx_event, -1)}
+    , m_rx_event{std::exchange(other.m_rx_event, -1)}
+    , m_tx_writable{std::exchange(other.m_tx_writable, -1)}
+    , m_rx_writable{std::exchange(other.m_rx_writable, -1)}
+    , m_tx_full{other.m_tx_full}
+    , m_rx_drained{other.m_rx_drained}
+{}
+
+
+shm_channel& shm_channel::operator=(shm_channel&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        m_tx = std::move(other.m_tx);
+        m_rx = std::move(other.m_rx);
+        m_tx_event = std::exchange(other.m_tx_event, -1);
+        m_rx_event = std::exchange(other.m_rx_event, -1);
+        m_tx_writable = std::exchange(other.m_tx_writable, -1);
+        m_rx_writable = std::exchange(other.m_rx_writable, -1);
+        m_tx_full = other.m_tx_full;
+        m_rx_drained = other.m_rx_drained;
+    }
+    return *this;
+}
+
+
+void shm_channel::release() noexcept
+{
+    for (int* fd: {&m_tx_event, &m_rx_event, &m_tx_writable, &m_rx_writable})
+    {
+        if (*fd != -1)
+        {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+
+shm_channel::fds_t shm_channel::peer_fds() const noexcept
+{
+    return { m_rx.fd(), m_tx.fd(), m_rx_event, m_tx_event, m_rx_writable, m_tx_writable };
+}
+
+
+std::optional<std::size_t> shm_channel::send(void const* buffer, std::size_t n) noexcept
+{
+    auto status = m_tx.push(buffer, n);
+    if (status == spsc_ring::push_status::FULL)
+    {
+        // reset wakeup counter, room freed before reset would be lost without second push
+        eventfd_t value;
+        ::eventfd_read(m_tx_writable, &value);
+        status = m_tx.push(buffer, n);
+    }
+
+    m_tx_full = status == spsc_ring::push_status::FULL;
+    if (m_tx_full)
+    {
+        return std::nullopt;
+    }
+    else if (status == spsc_ring::push_status::NOTIFY)
+    {
+        ::eventfd_write(m_tx_event, 1);
+    }
+    return n;
+}
+
+
+std::optional<std::size_t> shm_channel::receive(void* buffer, std::size_t n) noexcept
+{
+    auto received = m_rx.pop(buffer, n);
+    if (!received)
+    {
+        // reset wakeup counter, message pushed before reset would be lost without second check
+        eventfd_t value;
+        ::eventfd_read(m_rx_event, &value);
+        received = m_rx.pop(buffer, n);
+    }
+
+    if (received && m_rx.take_producer_wakeup())
+    {
+        ::eventfd_write(m_rx_writable, 1);
+    }
+    m_rx_drained = !received;
+    return received;
+}
+
+
+bool shm_channel::finished_send() const noexcept
+{
+    return m_tx_full;
+}
+
+
+bool shm_channel::finished_recv() const noexcept
+{
+    return m_rx_drained;
+}
+
+
+int shm_channel::event_fd() const noexcept
+{
+    return m_rx_event;
+}
+
+
+int shm_channel::writable_fd() const noexcept
+{
+    return m_tx_writable;
+}
+
+}
@@ -0,0 +1,257 @@
+#include <shm/spsc_ring.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <utility>
+
+namespace protei::shm
+{
+
+/**
+ * @brief Shared part of ring. Positions grow monotonically, index in data is position modulo capacity
+ */
+struct spsc_ring::header
+{
+    alignas(64) std::atomic<std::uint64_t> head;
+    alignas(64) std::atomic<std::uint64_t> tail;
+    /// set by producer, that found ring full, cleared by consumer waking it up
+    std::atomic<std::uint32_t> producer_waiting;
+    alignas(64) std::uint64_t capacity;
+};
+
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "ring positions are shared between processes");
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "ring flags are shared between processes");
+
+/// every record starts with message size and is aligned to record header size
+static constexpr std::uint64_t RECORD_HEADER_SIZE = sizeof(std::uint64_t);
+/// size of record, that tells consumer to continue from the ring start
+static constexpr std::uint32_t WRAP_MARKER = std::numeric_limits<std::uint32_t>::max();
+
+static std::uint64_t record_size(std::uint64_t message_size) noexcept
+{
+    return RECORD_HEADER_SIZE + ((message_size + RECORD_HEADER_SIZE - 1) & ~(RECORD_HEADER_SIZE - 1));
+}
+
+
+static std::uint64_t round_up_pow2(std::uint64_t value) noexcept
+{
+    std::uint64_t ret = RECORD_HEADER_SIZE;
+    while (ret < value)
+    {
+        ret <<= 1u;
+    }
+    return ret;
+}
+
+
+std::optional<spsc_ring> spsc_ring::create(std::size_t capacity) noexcept
+{
+    auto data_size = round_up_pow2(capacity);
+    auto mapping_size = sizeof(header) + data_size;
+    int fd = ::memfd_create("protei_spsc_ring", MFD_CLOEXEC);
+    if (fd == -1)
+    {
+        return std::nullopt;
+    }
+    else if (0 != ::ftruncate(fd, static_cast<off_t>(mapping_size)))
+    {
+        ::close(fd);
+        return std::nullopt;
+    }
+
+    void* mapping = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        ::close(fd);
+        return std::nullopt;
+    }
+
+    auto* hdr = new (mapping) header{};
+    hdr->capacity = data_size;
+    return spsc_ring{fd, mapping, mapping_size};
+}
+
+
+std::optional<spsc_ring> spsc_ring::attach(int fd) noexcept
+{
+    struct stat st{};
+    if (0 != ::fstat(fd, &st) || static_cast<std::size_t>(st.st_size) <= sizeof(header))
+    {
+        ::close(fd);
+        return std::nullopt;
+    }
+
+    auto mapping_size = static_cast<std::size_t>(st.st_size);
+    void* mapping = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        ::close(fd);
+        return std::nullopt;
+    }
+
+    spsc_ring ring{fd, mapping, mapping_size};
+    auto capacity = ring.m_header->capacity;
+    if (capacity + sizeof(header) != mapping_size || (capacity & (capacity - 1)) != 0)
+    {
+        return std::nullopt;
+    }
+
+    return ring;
+}
+
+
+spsc_ring::spsc_ring(int fd, void* mapping, std::size_t mapping_size) noexcept
+    : m_fd{fd}
+    , m_header{static_cast<header*>(mapping)}
+    , m_data{static_cast<std::byte*>(mapping) + sizeof(header)}
+    , m_mapping_size{mapping_size}
+{}
+
+
+spsc_ring::~spsc_ring()
+{
+    release();
+}
+
+
+spsc_ring::spsc_ring(spsc_ring&& other) noexcept
+    : m_fd{std::exchange(other.m_fd, -1)}
+    , m_header{std::exchange(other.m_header, nullptr)}
+    , m_data{std::exchange(other.m_data, nullptr)}
+    , m_mapping_size{std::exchange(other.m_mapping_size, 0)}
+{}
+
+
+spsc_ring& spsc_ring::operator=(spsc_ring&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        m_fd = std::exchange(other.m_fd, -1);
+        m_header = std::exchange(other.m_header, nullptr);
+        m_data = std::exchange(other.m_data, nullptr);
+        m_mapping_size = std::exchange(other.m_mapping_size, 0);
+    }
+    return *this;
+}
+
+
+void spsc_ring::release() noexcept
+{
+    if (m_header)
+    {
+        ::munmap(m_header, m_mapping_size);
+        m_header = nullptr;
+    }
+    if (m_fd != -1)
+    {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+
+spsc_ring::push_status spsc_ring::push(void const* data, std::size_t size) noexcept
+{
+    auto capacity = m_header->capacity;
+    auto record = record_size(size);
+    auto head = m_header->head.load(std::memory_order_relaxed);
+    auto tail = m_header->tail.load(std::memory_order_acquire);
+    auto index = head & (capacity - 1);
+    auto contiguous = capacity - index;
+    // record never wraps, tail of the ring is skipped if it's too short
+    auto required = record > contiguous ? contiguous + record : record;
+    if (size >= WRAP_MARKER || record > capacity)
+    {
+        return push_status::FULL;
+    }
+    else if (required > capacity - (head - tail))
+    {
+        // seq_cst pairs with consumer's tail store: either producer sees freed room, or consumer sees the flag
+        m_header->producer_waiting.store(1, std::memory_order_seq_cst);
+        tail = m_header->tail.load(std::memory_order_seq_cst);
+        if (required > capacity - (head - tail))
+        {
+            return push_status::FULL;
+        }
+    }
+
+    auto position = head;
+    if (record > contiguous)
+    {
+        std::uint32_t marker = WRAP_MARKER;
+        std::memcpy(m_data + index, &marker, sizeof(marker));
+        position += contiguous;
+        index = 0;
+    }
+
+    auto message_size = static_cast<std::uint32_t>(size);
+    std::memcpy(m_data + index, &message_size, sizeof(message_size));
+    std::memcpy(m_data + index + RECORD_HEADER_SIZE, data, size);
+
+    // seq_cst pairs with consumer's tail store: either consumer sees new head, or producer sees drained ring
+    m_header->head.store(position + record, std::memory_order_seq_cst);
+    return m_header->tail.load(std::memory_order_seq_cst) == head ? push_status::NOTIFY : push_status::PUSHED;
+}
+
+
+std::optional<std::size_t> spsc_ring::pop(void* buffer, std::size_t size) noexcept
+{
+    auto capacity = m_header->capacity;
+    auto tail = m_header->tail.load(std::memory_order_relaxed);
+    auto head = m_header->head.load(std::memory_order_seq_cst);
+    if (tail == head)
+    {
+        return std::nullopt;
+    }
+
+    auto index = tail & (capacity - 1);
+    std::uint32_t message_size;
+    std::memcpy(&message_size, m_data + index, sizeof(message_size));
+    if (message_size == WRAP_MARKER)
+    {
+        tail += capacity - index;
+        index = 0;
+        std::memcpy(&message_size, m_data, sizeof(message_size));
+    }
+
+    auto copied = std::min<std::size_t>(message_size, size);
+    std::memcpy(buffer, m_data + index + RECORD_HEADER_SIZE, copied);
+    m_header->tail.store(tail + record_size(message_size), std::memory_order_seq_cst);
+    return copied;
+}
+
+
+bool spsc_ring::take_producer_wakeup() noexcept
+{
+    return m_header->producer_waiting.load(std::memory_order_seq_cst) != 0
+           && m_header->producer_waiting.exchange(0, std::memory_order_seq_cst) != 0;
+}
+
+
+bool spsc_ring::empty() const noexcept
+{
+    return m_header->tail.load(std::memory_order_acquire) == m_header->head.load(std::memory_order_acquire);
+}
+
+
+std::size_t spsc_ring::capacity() const noexcept
+{
+    return m_header->capacity;
+}
+
+
+int spsc_ring::fd() const noexcept
+{
+    return m_fd;
+}
+
+}
@@ -0,0 +1,13 @@
+#include <socket/af_unix.h>
+
+#include <sys/socket.h>
+
+namespace protei::sock
+{
+
+local::operator int() noexcept
+{
+    return AF_UNIX;
+}
+
+}
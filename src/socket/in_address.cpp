@@ -4,6 +4,8 @@
 
 #include <arpa/inet.h>
 
+#include <cstring>
+
 namespace protei::sock
 {
 
@@ -12,7 +14,7 @@ auto in_address_t::parser(std::string const& str) noexcept
 {
     return [&str]() -> std::optional<std::pair<bytes_t, int>>
     {
-        bytes_t buff;
+        bytes_t buff{};
         if (str.length() < MAX_LEN
                && 0 < inet_pton(static_cast<int>(AF{}), str.data(), &buff))
         {
@@ -93,4 +95,53 @@ int in_address_t::family() const noexcept
     return m_family;
 }
 
+
+
+std::size_t in_address_t::size() const noexcept
+{
+    return is_ipv4() ? sizeof(in_addr) : sizeof(in6_addr);
+}
+
+
+bool operator==(in_address_t const& lhs, in_address_t const& rhs) noexcept
+{
+    auto lhs_bytes = lhs.bytes();
+    auto rhs_bytes = rhs.bytes();
+    return lhs.family() == rhs.family() && 0 == std::memcmp(lhs_bytes.data(), rhs_bytes.data(), lhs.size());
+}
+
+
+bool operator!=(in_address_t const& lhs, in_address_t const& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+
+bool operator==(in_address_port_t const& lhs, in_address_port_t const& rhs) noexcept
+{
+    return lhs.port == rhs.port && lhs.addr == rhs.addr;
+}
+
+
+bool operator!=(in_address_port_t const& lhs, in_address_port_t const& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+
+std::size_t in_address_port_hash::operator()(in_address_port_t const& addr) const noexcept
+{
+    // two 64-bit words of address mixed with port, then finalized by murmur3 mixer
+    std::uint64_t words[2] = {};
+    auto bytes = addr.addr.bytes();
+    std::memcpy(words, bytes.data(), addr.addr.size());
+    std::uint64_t h = words[0] ^ (words[1] * 0x9e3779b97f4a7c15ull) ^ (std::uint64_t{addr.port} << 48u);
+    h ^= h >> 33u;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33u;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33u;
+    return static_cast<std::size_t>(h);
+}
+
 }
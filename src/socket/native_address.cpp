@@ -0,0 +1,92 @@
+#include <socket/native_address.h>
+#include <socket/af_inet.h>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+namespace protei::sock
+{
+
+static_assert(sizeof(sockaddr_in6) == native_address_t::MAX_SOCKADDR_LEN);
+static_assert(sizeof(sockaddr_in) <= native_address_t::MAX_SOCKADDR_LEN);
+
+native_address_t::native_address_t() noexcept
+    : m_storage{}
+    , m_size{0}
+{}
+
+
+native_address_t::native_address_t(in_address_port_t const& addr) noexcept
+    : m_storage{}
+    , m_size{0}
+{
+    auto bytes = addr.addr.bytes();
+    if (addr.addr.is_ipv4())
+    {
+        auto* sock_addr = reinterpret_cast<sockaddr_in*>(m_storage.data());
+        sock_addr->sin_family = AF_INET;
+        sock_addr->sin_port = htons(addr.port);
+        std::memcpy(&sock_addr->sin_addr, bytes.data(), sizeof(sock_addr->sin_addr));
+        m_size = sizeof(sockaddr_in);
+    }
+    else if (addr.addr.is_ipv6())
+    {
+        auto* sock_addr = reinterpret_cast<sockaddr_in6*>(m_storage.data());
+        sock_addr->sin6_family = AF_INET6;
+        sock_addr->sin6_port = htons(addr.port);
+        std::memcpy(&sock_addr->sin6_addr, bytes.data(), sizeof(sock_addr->sin6_addr));
+        m_size = sizeof(sockaddr_in6);
+    }
+}
+
+
+std::optional<in_address_port_t> native_address_t::to_in_address_port() const
+{
+    in_address_t::bytes_t bytes{};
+    if (family() == ipv4{})
+    {
+        auto const* sock_addr = reinterpret_cast<sockaddr_in const*>(m_storage.data());
+        std::memcpy(bytes.data(), &sock_addr->sin_addr, sizeof(sock_addr->sin_addr));
+        return in_address_port_t{ in_address_t{ bytes, ipv4{} }, port() };
+    }
+    else if (family() == ipv6{})
+    {
+        auto const* sock_addr = reinterpret_cast<sockaddr_in6 const*>(m_storage.data());
+        std::memcpy(bytes.data(), &sock_addr->sin6_addr, sizeof(sock_addr->sin6_addr));
+        return in_address_port_t{ in_address_t{ bytes, ipv6{} }, port() };
+    }
+    else
+    {
+        return std::nullopt;
+    }
+}
+
+
+int native_address_t::family() const noexcept
+{
+    return m_size == 0 ? AF_UNSPEC : reinterpret_cast<sockaddr const*>(m_storage.data())->sa_family;
+}
+
+
+std::uint_fast16_t native_address_t::port() const noexcept
+{
+    // sin_port and sin6_port share offset
+    return m_size == 0 ? 0 : ntohs(reinterpret_cast<sockaddr_in const*>(m_storage.data())->sin_port);
+}
+
+
+void native_address_t::normalize() noexcept
+{
+    // fields kernel may fill, but not significant for address identity
+    if (family() == ipv4{})
+    {
+        auto* sock_addr = reinterpret_cast<sockaddr_in*>(m_storage.data());
+        std::memset(sock_addr->sin_zero, 0, sizeof(sock_addr->sin_zero));
+    }
+    else if (family() == ipv6{})
+    {
+        reinterpret_cast<sockaddr_in6*>(m_storage.data())->sin6_flowinfo = 0;
+    }
+}
+
+}
@@ -16,4 +16,16 @@ udp::operator int() noexcept
     return SOCK_DGRAM;
 }
 
+
+unix_stream::operator int() noexcept
+{
+    return SOCK_STREAM;
+}
+
+
+unix_dgram::operator int() noexcept
+{
+    return SOCK_DGRAM;
+}
+
 }
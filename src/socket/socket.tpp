@@ -1,6 +1,32 @@
 namespace protei::sock
 {
 
+namespace detail
+{
+
+/**
+ * @param sock - socket
+ * @param remote - peer address flag
+ * @return local or peer address of socket, std::nullopt if socket is not bound or connected respectively
+ */
+template <typename Proto>
+std::optional<proto_address_t<Proto>> socket_address(impl::socket_impl const& sock, bool remote)
+{
+    if constexpr (is_local_v<Proto>)
+    {
+        unix_address_t addr;
+        bool got = remote ? sock.remote_address(addr) : sock.local_address(addr);
+        return got ? std::optional{addr} : std::nullopt;
+    }
+    else
+    {
+        return remote ? sock.remote_address() : sock.local_address();
+    }
+}
+
+}
+
+
 template <typename Proto>
 sock::socket_t<Proto>::socket_t(impl::socket_impl&& impl) noexcept
     : m_impl{std::move(impl)}
@@ -45,7 +71,14 @@ socket_t<Proto>::~socket_t()
 
 
 template <typename Proto>
-binded_socket_t<Proto>::binded_socket_t(in_address_port_t local, impl::socket_impl&& impl) noexcept
+bool socket_t<Proto>::set_reuse_address(bool enable) noexcept
+{
+    return m_impl.set_reuse_address(enable);
+}
+
+
+template <typename Proto>
+binded_socket_t<Proto>::binded_socket_t(proto_address_t<Proto> local, impl::socket_impl&& impl) noexcept
     : m_impl{std::move(impl)}
     , m_local(local)
 {}
@@ -62,7 +95,7 @@ binded_socket_t<Proto>::~binded_socket_t()
 
 
 template <typename Proto>
-in_address_port_t binded_socket_t<Proto>::local() const noexcept
+proto_address_t<Proto> binded_socket_t<Proto>::local() const noexcept
 {
     return m_local;
 }
@@ -71,7 +104,7 @@ in_address_port_t binded_socket_t<Proto>::local() const noexcept
 template <typename Proto>
 listening_socket_t<Proto>::listening_socket_t(
         unsigned max_conn
-        , in_address_port_t local
+        , proto_address_t<Proto> local
         , impl::socket_impl&& impl) noexcept
     : m_impl{std::move(impl)}
     , m_local{local}
@@ -90,7 +123,26 @@ listening_socket_t<Proto>::~listening_socket_t()
 
 
 template <typename Proto>
-in_address_port_t listening_socket_t<Proto>::local() const noexcept
+std::optional<listening_socket_t<Proto>> listening_socket_t<Proto>::adopt(int fd, unsigned max_conn) noexcept
+{
+    impl::socket_impl sock;
+    if (!sock.adopt(fd, static_cast<int>(Proto{}), is_local_v<Proto>) || !sock.listening())
+    {
+        return std::nullopt;
+    }
+
+    // descriptors created elsewhere are usually blocking, flags are changed only when fd is taken
+    auto local = detail::socket_address<Proto>(sock, false);
+    if (!local || !sock.set_nonblocking())
+    {
+        return std::nullopt;
+    }
+    return listening_socket_t{max_conn, *local, std::move(sock)};
+}
+
+
+template <typename Proto>
+proto_address_t<Proto> listening_socket_t<Proto>::local() const noexcept
 {
     return m_local;
 }
@@ -106,8 +158,8 @@ unsigned listening_socket_t<Proto>::max_conn() const noexcept
 template <typename Proto>
 active_socket_t<Proto>::active_socket_t(
         impl::socket_impl&& impl
-        , std::optional<in_address_port_t> remote
-        , std::optional<in_address_port_t> local
+        , std::optional<proto_address_t<Proto>> remote
+        , std::optional<proto_address_t<Proto>> local
         , bool accepted) noexcept
     : m_impl{std::move(impl)}
     , m_remote{remote}
@@ -118,6 +170,26 @@ active_socket_t<Proto>::active_socket_t(
 }
 
 
+template <typename Proto>
+std::optional<active_socket_t<Proto>> active_socket_t<Proto>::adopt(int fd, bool accepted) noexcept
+{
+    impl::socket_impl sock;
+    if (!sock.adopt(fd, static_cast<int>(Proto{}), is_local_v<Proto>) || sock.listening())
+    {
+        return std::nullopt;
+    }
+
+    auto remote = detail::socket_address<Proto>(sock, true);
+    auto local = detail::socket_address<Proto>(sock, false);
+    // descriptors created elsewhere are usually blocking, flags are changed only when fd is taken
+    if ((!Proto::is_connectionless && !remote) || !sock.set_nonblocking())
+    {
+        return std::nullopt;
+    }
+    return active_socket_t{std::move(sock), remote, local, accepted};
+}
+
+
 template <typename Proto>
 active_socket_t<Proto>::~active_socket_t()
 {
@@ -136,14 +208,14 @@ bool active_socket_t<Proto>::accepted() const noexcept
 
 
 template <typename Proto>
-std::optional<in_address_port_t> active_socket_t<Proto>::remote() const noexcept
+std::optional<proto_address_t<Proto>> active_socket_t<Proto>::remote() const noexcept
 {
     return m_remote;
 }
 
 
 template <typename Proto>
-std::optional<in_address_port_t> active_socket_t<Proto>::local() const noexcept
+std::optional<proto_address_t<Proto>> active_socket_t<Proto>::local() const noexcept
 {
     return m_local;
 }
@@ -1,13 +1,25 @@
 #include <socket/socket_impl.h>
 #include <socket/in_address.h>
+#include <socket/native_address.h>
+#include <socket/unix_address.h>
 #include <socket/af_inet.h>
+#include <buffer/iobuf.h>
 
 #include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <cerrno>
+#include <ctime>
 
 #include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
 #include <functional>
 
 
@@ -44,6 +56,32 @@ static sockaddr_in6 sock_addr6(in_address_t const& addr, std::uint_fast16_t port
 }
 
 
+static timestamp_t to_timestamp(timespec const& ts) noexcept
+{
+    return timestamp_t{std::chrono::duration_cast<timestamp_t::duration>(
+            std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec})};
+}
+
+
+/**
+ * @param msg - received message
+ * @return software timestamp of SCM_TIMESTAMPING control message
+ */
+static std::optional<timestamp_t> software_timestamp(msghdr& msg) noexcept
+{
+    for (auto* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPING)
+        {
+            scm_timestamping tss{};
+            std::memcpy(&tss, CMSG_DATA(cmsg), sizeof(tss));
+            return to_timestamp(tss.ts[0]);
+        }
+    }
+    return std::nullopt;
+}
+
+
 template <typename Addr>
 bool socket_impl::bind(Addr const& addr) noexcept
 {
@@ -86,19 +124,6 @@ std::optional<std::pair<socket_impl, in_address_port_t>> socket_impl::accept() c
 }
 
 
-template <typename ToSockAddr>
-std::size_t socket_impl::send_to_impl(
-        in_address_port_t const& remote
-        , void* buffer
-        , std::size_t n
-        , int flags
-        , ToSockAddr f) noexcept
-{
-    auto sock_addr = std::invoke(f, remote.addr, remote.port);
-    return ::sendto(*m_fd, buffer, n, flags, reinterpret_cast<sockaddr const*>(&sock_addr), sizeof(sock_addr));
-}
-
-
 template <typename Addr>
 std::optional<std::pair<in_address_port_t, std::size_t>> socket_impl::recv_from_impl(
         void* buffer
@@ -151,6 +176,40 @@ bool socket_impl::open(int fam, int proto, int flags) noexcept
 }
 
 
+bool socket_impl::adopt(int fd, int proto, bool local) noexcept
+{
+    int type = 0;
+    int fam = AF_UNSPEC;
+    socklen_t type_size = sizeof(type);
+    socklen_t fam_size = sizeof(fam);
+    if (-1 == ::getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &type_size)
+            || -1 == ::getsockopt(fd, SOL_SOCKET, SO_DOMAIN, &fam, &fam_size)
+            || type != proto
+            || (local ? fam != AF_UNIX : fam != AF_INET && fam != AF_INET6))
+    {
+        return false;
+    }
+
+    m_family = fam;
+    return (m_fd = fd).has_value();
+}
+
+
+bool socket_impl::set_nonblocking() noexcept
+{
+    auto flags = m_fd ? ::fcntl(*m_fd, F_GETFL) : -1;
+    return flags != -1 && ((flags & O_NONBLOCK) || -1 != ::fcntl(*m_fd, F_SETFL, flags | O_NONBLOCK));
+}
+
+
+bool socket_impl::listening() const noexcept
+{
+    int value = 0;
+    socklen_t size = sizeof(value);
+    return m_fd && 0 == ::getsockopt(*m_fd, SOL_SOCKET, SO_ACCEPTCONN, &value, &size) && value;
+}
+
+
 bool socket_impl::shutdown(shutdown_dir dir) noexcept
 {
     int macro_dir = SHUT_RDWR;
@@ -207,6 +266,46 @@ bool socket_impl::connect(in_address_port_t const& remote) noexcept
 }
 
 
+bool socket_impl::bind(unix_address_t const& local) noexcept
+{
+    sockaddr_un sock_addr{};
+    auto size = sock_addr_un(local, sock_addr);
+    return m_fd && 0 == ::bind(*m_fd, reinterpret_cast<sockaddr const*>(&sock_addr), size);
+}
+
+
+bool socket_impl::connect(unix_address_t const& remote) noexcept
+{
+    if (!m_fd || remote.empty())
+    {
+        return false;
+    }
+
+    // unbound datagram socket can't get replies, so it's bound to kernel chosen abstract name as udp one gets
+    // ephemeral port
+    int type = 0;
+    socklen_t type_size = sizeof(type);
+    sockaddr_un local{};
+    socklen_t local_size = sizeof(local);
+    if (0 == ::getsockopt(*m_fd, SOL_SOCKET, SO_TYPE, &type, &type_size)
+            && SOCK_DGRAM == type
+            && 0 == ::getsockname(*m_fd, reinterpret_cast<sockaddr*>(&local), &local_size)
+            && local_size <= offsetof(sockaddr_un, sun_path))
+    {
+        local.sun_family = AF_UNIX;
+        if (0 != ::bind(*m_fd, reinterpret_cast<sockaddr const*>(&local), sizeof(local.sun_family)))
+        {
+            return false;
+        }
+    }
+
+    sockaddr_un sock_addr{};
+    auto size = sock_addr_un(remote, sock_addr);
+    auto connect_res = ::connect(*m_fd, reinterpret_cast<sockaddr const*>(&sock_addr), size);
+    return EINPROGRESS == errno || 0 == connect_res;
+}
+
+
 bool socket_impl::listen(unsigned max_conn) noexcept
 {
     return m_fd && 0 == ::listen(*m_fd, static_cast<int>(max_conn));
@@ -232,27 +331,100 @@ std::optional<std::size_t> socket_impl::send(void* buffer, std::size_t n, int fl
 std::optional<std::size_t> socket_impl::send_to(
         in_address_port_t const& remote, void* buffer, std::size_t n, int flags) noexcept
 {
-    std::size_t ret = -1;
-    if (m_fd && m_family == remote.addr.family())
+    return send_to(native_address_t{remote}, buffer, n, flags);
+}
+
+
+std::optional<std::size_t> socket_impl::send_to(
+        native_address_t const& remote, void* buffer, std::size_t n, int flags) noexcept
+{
+    std::optional<std::size_t> ret;
+    if (m_fd && m_family == remote.family())
     {
-        if (remote.addr.is_ipv4())
-        {
-            ret = send_to_impl(remote, buffer, n, flags, sock_addr4);
-        }
-        else if (remote.addr.is_ipv6())
+        auto sent = ::sendto(
+                *m_fd
+                , buffer
+                , n
+                , flags
+                , reinterpret_cast<sockaddr const*>(remote.m_storage.data())
+                , remote.m_size);
+        if (sent != -1)
         {
-            ret = send_to_impl(remote, buffer, n, flags, sock_addr6);
+            ret = sent;
         }
     }
 
-    if (ret == static_cast<std::size_t>(-1))
+    return ret;
+}
+
+
+std::optional<std::size_t> socket_impl::send_to(
+        unix_address_t const& remote, void* buffer, std::size_t n, int flags) noexcept
+{
+    std::optional<std::size_t> ret;
+    if (m_fd)
     {
-        return std::nullopt;
+        sockaddr_un sock_addr{};
+        auto size = sock_addr_un(remote, sock_addr);
+        auto sent = ::sendto(*m_fd, buffer, n, flags, reinterpret_cast<sockaddr const*>(&sock_addr), size);
+        if (sent != -1)
+        {
+            ret = sent;
+        }
     }
-    else
+
+    return ret;
+}
+
+
+std::optional<std::size_t> socket_impl::send(buffer::io_slice const* slices, std::size_t count, int flags) noexcept
+{
+    return send_msg(nullptr, 0, slices, count, flags);
+}
+
+
+std::optional<std::size_t> socket_impl::send_to(
+        native_address_t const& remote, buffer::io_slice const* slices, std::size_t count, int flags) noexcept
+{
+    return m_family == remote.family()
+            ? send_msg(remote.m_storage.data(), remote.m_size, slices, count, flags)
+            : std::nullopt;
+}
+
+
+std::optional<std::size_t> socket_impl::send_to(
+        unix_address_t const& remote, buffer::io_slice const* slices, std::size_t count, int flags) noexcept
+{
+    sockaddr_un sock_addr{};
+    auto size = sock_addr_un(remote, sock_addr);
+    return send_msg(&sock_addr, size, slices, count, flags);
+}
+
+
+std::optional<std::size_t> socket_impl::send_msg(
+        void const* addr, unsigned addr_size, buffer::io_slice const* slices, std::size_t count, int flags) noexcept
+{
+    static_assert(sizeof(buffer::io_slice) == sizeof(iovec));
+    static_assert(offsetof(buffer::io_slice, data) == offsetof(iovec, iov_base));
+    static_assert(offsetof(buffer::io_slice, size) == offsetof(iovec, iov_len));
+
+    std::optional<std::size_t> ret;
+    if (m_fd)
     {
-        return ret;
+        msghdr msg{};
+        msg.msg_name = const_cast<void*>(addr);
+        msg.msg_namelen = addr_size;
+        // sendmsg doesn't modify iovecs
+        msg.msg_iov = reinterpret_cast<iovec*>(const_cast<buffer::io_slice*>(slices));
+        msg.msg_iovlen = std::min(count, MAX_SLICES);
+        auto sent = ::sendmsg(*m_fd, &msg, flags);
+        if (sent != -1)
+        {
+            ret = sent;
+        }
     }
+
+    return ret;
 }
 
 
@@ -294,17 +466,95 @@ std::optional<std::pair<in_address_port_t, std::size_t>> socket_impl::receive_fr
 }
 
 
+std::optional<std::size_t> socket_impl::receive_from(
+        void* buffer
+        , std::size_t n
+        , int flags
+        , native_address_t& remote) noexcept
+{
+    std::optional<std::size_t> ret;
+    if (m_fd)
+    {
+        socklen_t addr_size = native_address_t::MAX_SOCKADDR_LEN;
+        auto received = ::recvfrom(
+                *m_fd
+                , buffer
+                , n
+                , flags
+                , reinterpret_cast<sockaddr*>(remote.m_storage.data())
+                , &addr_size);
+        if (received != -1)
+        {
+            remote.m_size = std::min<socklen_t>(addr_size, native_address_t::MAX_SOCKADDR_LEN);
+            remote.normalize();
+            ret = received;
+        }
+    }
+
+    return ret;
+}
+
+
+std::optional<std::size_t> socket_impl::receive_from(
+        void* buffer
+        , std::size_t n
+        , int flags
+        , unix_address_t& remote) noexcept
+{
+    std::optional<std::size_t> ret;
+    if (m_fd)
+    {
+        sockaddr_un sock_addr{};
+        socklen_t addr_size = sizeof(sock_addr);
+        auto received = ::recvfrom(*m_fd, buffer, n, flags, reinterpret_cast<sockaddr*>(&sock_addr), &addr_size);
+        if (received != -1)
+        {
+            parse_addr(sock_addr, addr_size, remote);
+            ret = received;
+        }
+    }
+
+    return ret;
+}
+
+
+unsigned socket_impl::sock_addr_un(unix_address_t const& addr, sockaddr_un& sock_addr) noexcept
+{
+    sock_addr.sun_family = AF_UNIX;
+    std::memcpy(sock_addr.sun_path, addr.m_path.data(), addr.m_size);
+    return offsetof(sockaddr_un, sun_path) + addr.m_size;
+}
+
+
+void socket_impl::parse_addr(sockaddr_un const& sock_addr, unsigned size, unix_address_t& addr) noexcept
+{
+    std::size_t path_size = 0;
+    if (size > offsetof(sockaddr_un, sun_path))
+    {
+        path_size = std::min<std::size_t>(size - offsetof(sockaddr_un, sun_path), unix_address_t::MAX_PATH_LEN);
+        if (sock_addr.sun_path[0] != '\0')
+        {
+            // kernel may count terminating NUL of filesystem path
+            path_size = ::strnlen(sock_addr.sun_path, path_size);
+        }
+    }
+
+    std::memcpy(addr.m_path.data(), sock_addr.sun_path, path_size);
+    addr.m_size = static_cast<std::uint32_t>(path_size);
+}
+
+
 template <typename Addr>
 std::optional<in_address_port_t> socket_impl::parse_addr(Addr const& addr, unsigned size)
 {
     std::optional<in_address_t> parsed_addr;
     std::uint_fast16_t port;
-    in_address_t::bytes_t bytes;
+    in_address_t::bytes_t bytes{};
     if constexpr (std::is_same_v<Addr, sockaddr_in>)
     {
         std::copy(
                 reinterpret_cast<std::byte const*>(&addr.sin_addr.s_addr)
-                , reinterpret_cast<std::byte const*>(&addr.sin_addr.s_addr) + sizeof(sockaddr_in)
+                , reinterpret_cast<std::byte const*>(&addr.sin_addr.s_addr) + sizeof(addr.sin_addr.s_addr)
                 , std::begin(bytes));
         parsed_addr.emplace(bytes, ipv4{});
         port = ntohs(addr.sin_port);
@@ -313,7 +563,7 @@ std::optional<in_address_port_t> socket_impl::parse_addr(Addr const& addr, unsig
     {
         std::copy(
                 reinterpret_cast<std::byte const*>(&addr.sin6_addr)
-                , reinterpret_cast<std::byte const*>(&addr.sin6_addr) + sizeof(sockaddr_in6)
+                , reinterpret_cast<std::byte const*>(&addr.sin6_addr) + sizeof(addr.sin6_addr)
                 , std::begin(bytes));
         parsed_addr.emplace(bytes, ipv6{});
         port = ntohs(addr.sin6_port);
@@ -350,6 +600,379 @@ socket_impl& socket_impl::operator=(socket_impl&& other) noexcept
 }
 
 
+std::optional<std::size_t> socket_impl::send_fds(
+        void* buffer, std::size_t n, int const* fds, std::size_t fds_count) noexcept
+{
+    std::optional<std::size_t> ret;
+    if (!m_fd || fds_count > MAX_PASSED_FDS)
+    {
+        return ret;
+    }
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * MAX_PASSED_FDS)]{};
+    iovec iov{buffer, n};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    if (fds_count != 0)
+    {
+        msg.msg_control = control;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * fds_count);
+        auto* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds_count);
+        std::memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * fds_count);
+    }
+
+    auto sent = ::sendmsg(*m_fd, &msg, MSG_NOSIGNAL);
+    if (sent != -1)
+    {
+        ret = sent;
+    }
+
+    return ret;
+}
+
+
+std::optional<std::size_t> socket_impl::receive_fds(
+        void* buffer, std::size_t n, int* fds, std::size_t& fds_count) noexcept
+{
+    std::optional<std::size_t> ret;
+    std::size_t max_fds = std::min(fds_count, MAX_PASSED_FDS);
+    fds_count = 0;
+    if (!m_fd)
+    {
+        return ret;
+    }
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * MAX_PASSED_FDS)]{};
+    iovec iov{buffer, n};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * max_fds);
+    auto received = ::recvmsg(*m_fd, &msg, MSG_CMSG_CLOEXEC);
+    if (received == -1)
+    {
+        return ret;
+    }
+
+    // CMSG_SPACE is padded, so kernel may install more descriptors than asked: they are closed, not stored
+    for (auto* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+        {
+            auto count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                int fd;
+                std::memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+                if (fds_count < max_fds)
+                {
+                    fds[fds_count++] = fd;
+                }
+                else
+                {
+                    ::close(fd);
+                }
+            }
+        }
+    }
+
+    // truncated control data: some descriptors were dropped by kernel, so message can't be trusted
+    if (msg.msg_flags & MSG_CTRUNC)
+    {
+        for (std::size_t i = 0; i < fds_count; ++i)
+        {
+            ::close(fds[i]);
+        }
+        fds_count = 0;
+        errno = EMSGSIZE;
+        return ret;
+    }
+
+    ret = received;
+    return ret;
+}
+
+
+std::optional<std::size_t> socket_impl::receive_timestamped(
+        void* buffer, std::size_t n, int flags, native_address_t* remote, std::optional<timestamp_t>& ts) noexcept
+{
+    std::optional<std::size_t> ret;
+    ts.reset();
+    if (!m_fd)
+    {
+        return ret;
+    }
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(scm_timestamping))]{};
+    iovec iov{buffer, n};
+    msghdr msg{};
+    if (remote)
+    {
+        msg.msg_name = remote->m_storage.data();
+        msg.msg_namelen = native_address_t::MAX_SOCKADDR_LEN;
+    }
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    auto received = ::recvmsg(*m_fd, &msg, flags);
+    if (received != -1)
+    {
+        if (remote)
+        {
+            remote->m_size = std::min<socklen_t>(msg.msg_namelen, native_address_t::MAX_SOCKADDR_LEN);
+            remote->normalize();
+        }
+        ts = software_timestamp(msg);
+        ret = received;
+    }
+
+    return ret;
+}
+
+
+std::optional<tx_timestamp_t> socket_impl::receive_tx_timestamp() noexcept
+{
+    while (m_fd)
+    {
+        // extended error carries offender address after itself
+        constexpr std::size_t err_size = sizeof(sock_extended_err) + sizeof(sockaddr_in6);
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(scm_timestamping)) + CMSG_SPACE(err_size)]{};
+        msghdr msg{};
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        // OPT_TSONLY: no payload is looped back to error queue
+        if (::recvmsg(*m_fd, &msg, MSG_ERRQUEUE) == -1)
+        {
+            break;
+        }
+
+        auto time = software_timestamp(msg);
+        for (auto* cmsg = CMSG_FIRSTHDR(&msg); cmsg && time; cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if ((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR)
+                || (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR))
+            {
+                sock_extended_err err{};
+                std::memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+                if (err.ee_errno != ENOMSG || err.ee_origin != SO_EE_ORIGIN_TIMESTAMPING)
+                {
+                    break;
+                }
+                auto stage = err.ee_info == SCM_TSTAMP_SCHED ? tx_timestamp_t::stage_t::SCHEDULED
+                        : err.ee_info == SCM_TSTAMP_ACK ? tx_timestamp_t::stage_t::ACKED
+                        : tx_timestamp_t::stage_t::SENT;
+                return tx_timestamp_t{*time, stage, err.ee_data};
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+
+std::optional<int> socket_impl::pending_error() noexcept
+{
+    int error = 0;
+    socklen_t size = sizeof(error);
+    // reading SO_ERROR clears it
+    if (m_fd && 0 == ::getsockopt(*m_fd, SOL_SOCKET, SO_ERROR, &error, &size))
+    {
+        return error;
+    }
+    return std::nullopt;
+}
+
+
+std::optional<in_address_port_t> socket_impl::local_address() const
+{
+    native_address_t addr;
+    socklen_t addr_size = native_address_t::MAX_SOCKADDR_LEN;
+    if (m_fd && 0 == ::getsockname(*m_fd, reinterpret_cast<sockaddr*>(addr.m_storage.data()), &addr_size))
+    {
+        addr.m_size = std::min<socklen_t>(addr_size, native_address_t::MAX_SOCKADDR_LEN);
+        return addr.to_in_address_port();
+    }
+    return std::nullopt;
+}
+
+
+std::optional<in_address_port_t> socket_impl::remote_address() const
+{
+    native_address_t addr;
+    socklen_t addr_size = native_address_t::MAX_SOCKADDR_LEN;
+    if (m_fd && 0 == ::getpeername(*m_fd, reinterpret_cast<sockaddr*>(addr.m_storage.data()), &addr_size))
+    {
+        addr.m_size = std::min<socklen_t>(addr_size, native_address_t::MAX_SOCKADDR_LEN);
+        return addr.to_in_address_port();
+    }
+    return std::nullopt;
+}
+
+
+bool socket_impl::local_address(unix_address_t& local) const noexcept
+{
+    sockaddr_un sock_addr{};
+    socklen_t addr_size = sizeof(sock_addr);
+    if (m_fd && 0 == ::getsockname(*m_fd, reinterpret_cast<sockaddr*>(&sock_addr), &addr_size))
+    {
+        parse_addr(sock_addr, addr_size, local);
+        return true;
+    }
+    return false;
+}
+
+
+bool socket_impl::remote_address(unix_address_t& remote) const noexcept
+{
+    sockaddr_un sock_addr{};
+    socklen_t addr_size = sizeof(sock_addr);
+    if (m_fd && 0 == ::getpeername(*m_fd, reinterpret_cast<sockaddr*>(&sock_addr), &addr_size))
+    {
+        parse_addr(sock_addr, addr_size, remote);
+        return true;
+    }
+    return false;
+}
+
+
+bool socket_impl::set_reuse_address(bool enable) noexcept
+{
+    int value = enable;
+    return m_fd && 0 == ::setsockopt(*m_fd, SOL_SOCKET, SO_REUSEADDR, &value, sizeof(value));
+}
+
+
+bool socket_impl::set_timestamping(bool rx, bool tx, bool tx_ack) noexcept
+{
+    unsigned flags = 0;
+    if (rx)
+    {
+        flags |= SOF_TIMESTAMPING_RX_SOFTWARE;
+    }
+    if (tx)
+    {
+        flags |= SOF_TIMESTAMPING_TX_SCHED | SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_OPT_ID
+                 | SOF_TIMESTAMPING_OPT_TSONLY;
+        flags |= tx_ack ? SOF_TIMESTAMPING_TX_ACK : 0;
+    }
+    // generated timestamps are reported only with SOFTWARE
+    flags |= flags ? SOF_TIMESTAMPING_SOFTWARE : 0;
+    return m_fd && 0 == ::setsockopt(*m_fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags));
+}
+
+
+bool socket_impl::multicast_membership(
+        in_address_t const& group, in_address_t const* iface, unsigned if_index, bool join) noexcept
+{
+    if (!m_fd || group.family() != m_family)
+    {
+        return false;
+    }
+
+    auto group_bytes = group.bytes();
+    if (group.is_ipv4())
+    {
+        ip_mreqn req{};
+        std::copy_n(group_bytes.begin(), sizeof(req.imr_multiaddr), reinterpret_cast<std::byte*>(&req.imr_multiaddr));
+        if (iface)
+        {
+            auto iface_bytes = iface->bytes();
+            std::copy_n(iface_bytes.begin(), sizeof(req.imr_address), reinterpret_cast<std::byte*>(&req.imr_address));
+        }
+        req.imr_ifindex = static_cast<int>(if_index);
+        return 0 == ::setsockopt(
+                *m_fd, IPPROTO_IP, join ? IP_ADD_MEMBERSHIP : IP_DROP_MEMBERSHIP, &req, sizeof(req));
+    }
+    else if (!iface)
+    {
+        // IPv6 identifies interfaces by index only
+        ipv6_mreq req{};
+        std::copy_n(group_bytes.begin(), sizeof(req.ipv6mr_multiaddr), reinterpret_cast<std::byte*>(&req.ipv6mr_multiaddr));
+        req.ipv6mr_interface = if_index;
+        return 0 == ::setsockopt(
+                *m_fd, IPPROTO_IPV6, join ? IPV6_JOIN_GROUP : IPV6_LEAVE_GROUP, &req, sizeof(req));
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
+bool socket_impl::set_multicast_loop(bool enable) noexcept
+{
+    int value = enable;
+    if (!m_fd)
+    {
+        return false;
+    }
+    else if (m_family == ipv4{})
+    {
+        return 0 == ::setsockopt(*m_fd, IPPROTO_IP, IP_MULTICAST_LOOP, &value, sizeof(value));
+    }
+    else
+    {
+        return 0 == ::setsockopt(*m_fd, IPPROTO_IPV6, IPV6_MULTICAST_LOOP, &value, sizeof(value));
+    }
+}
+
+
+bool socket_impl::set_multicast_ttl(unsigned ttl) noexcept
+{
+    int value = static_cast<int>(ttl);
+    if (!m_fd)
+    {
+        return false;
+    }
+    else if (m_family == ipv4{})
+    {
+        return 0 == ::setsockopt(*m_fd, IPPROTO_IP, IP_MULTICAST_TTL, &value, sizeof(value));
+    }
+    else
+    {
+        return 0 == ::setsockopt(*m_fd, IPPROTO_IPV6, IPV6_MULTICAST_HOPS, &value, sizeof(value));
+    }
+}
+
+
+bool socket_impl::set_multicast_interface(in_address_t const* iface, unsigned if_index) noexcept
+{
+    if (!m_fd)
+    {
+        return false;
+    }
+    else if (m_family == ipv4{})
+    {
+        ip_mreqn req{};
+        if (iface)
+        {
+            if (!iface->is_ipv4())
+            {
+                return false;
+            }
+            auto iface_bytes = iface->bytes();
+            std::copy_n(iface_bytes.begin(), sizeof(req.imr_address), reinterpret_cast<std::byte*>(&req.imr_address));
+        }
+        req.imr_ifindex = static_cast<int>(if_index);
+        return 0 == ::setsockopt(*m_fd, IPPROTO_IP, IP_MULTICAST_IF, &req, sizeof(req));
+    }
+    else if (!iface)
+    {
+        int value = static_cast<int>(if_index);
+        return 0 == ::setsockopt(*m_fd, IPPROTO_IPV6, IPV6_MULTICAST_IF, &value, sizeof(value));
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
 bool socket_impl::eagain() const noexcept
 {
     return errno == EAGAIN;
@@ -379,6 +1002,59 @@ std::optional<std::pair<socket_impl, in_address_port_t>> socket_impl::accept() c
 }
 
 
+std::optional<socket_impl> socket_impl::accept(unix_address_t& remote) const
+{
+    std::optional<socket_impl> ret;
+    if (m_fd)
+    {
+        sockaddr_un sock_addr{};
+        socklen_t addr_size = sizeof(sock_addr);
+        int accepted_fd = ::accept4(*m_fd, reinterpret_cast<sockaddr*>(&sock_addr), &addr_size, SOCK_NONBLOCK);
+        if (-1 != accepted_fd)
+        {
+            parse_addr(sock_addr, addr_size, remote);
+            ret.emplace(accepted_fd, m_family);
+        }
+    }
+
+    return ret;
+}
+
+
+std::optional<std::pair<socket_impl, in_address_port_t>> socket_impl::accepted(int fd) const
+{
+    std::optional<std::pair<socket_impl, in_address_port_t>> ret;
+    socket_impl sock{fd, m_family};
+    auto remote = sock.remote_address();
+    if (remote)
+    {
+        ret = { std::move(sock), *remote };
+    }
+    else
+    {
+        // peer has already reset connection
+        ::close(fd);
+    }
+    return ret;
+}
+
+
+std::optional<socket_impl> socket_impl::accepted(int fd, unix_address_t& remote) const noexcept
+{
+    std::optional<socket_impl> ret;
+    socket_impl sock{fd, m_family};
+    if (sock.remote_address(remote))
+    {
+        ret.emplace(std::move(sock));
+    }
+    else
+    {
+        ::close(fd);
+    }
+    return ret;
+}
+
+
 bool socket_impl::would_block() const noexcept
 {
     return errno == EWOULDBLOCK;
@@ -0,0 +1,84 @@
+#include <socket/unix_address.h>
+
+#include <sys/un.h>
+
+#include <stdexcept>
+#include <string_view>
+
+namespace protei::sock
+{
+
+static_assert(sizeof(sockaddr_un::sun_path) == unix_address_t::MAX_PATH_LEN);
+
+std::optional<unix_address_t> unix_address_t::create(std::string const& name) noexcept
+{
+    unix_address_t ret;
+    if (name.empty())
+    {
+        return std::nullopt;
+    }
+    else if (name.front() == '@')
+    {
+        // leading NUL selects abstract namespace, name isn't NUL terminated
+        if (name.size() > MAX_PATH_LEN)
+        {
+            return std::nullopt;
+        }
+        ret.m_path[0] = '\0';
+        name.copy(ret.m_path.data() + 1, name.size() - 1, 1);
+        ret.m_size = static_cast<std::uint32_t>(name.size());
+    }
+    else
+    {
+        // room for terminating NUL is left for portability
+        if (name.size() >= MAX_PATH_LEN || name.find('\0') != std::string::npos)
+        {
+            return std::nullopt;
+        }
+        name.copy(ret.m_path.data(), name.size());
+        ret.m_size = static_cast<std::uint32_t>(name.size());
+    }
+
+    return ret;
+}
+
+
+unix_address_t::unix_address_t() noexcept
+    : m_path{}
+    , m_size{0}
+{}
+
+
+unix_address_t::unix_address_t(std::string const& name)
+    : unix_address_t{}
+{
+    if (auto created = create(name))
+    {
+        *this = *created;
+    }
+    else
+    {
+        throw std::invalid_argument{"String {" + name + "} is invalid unix socket address"};
+    }
+}
+
+
+std::string unix_address_t::name() const
+{
+    if (is_abstract())
+    {
+        return "@" + std::string(m_path.data() + 1, m_size - 1);
+    }
+    else
+    {
+        return std::string(m_path.data(), m_size);
+    }
+}
+
+
+std::size_t unix_address_t::hash::operator()(unix_address_t const& addr) const noexcept
+{
+    return std::hash<std::string_view>{}(std::string_view{addr.m_path.data(), addr.m_size});
+}
+
+}
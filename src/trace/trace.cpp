@@ -0,0 +1,282 @@
+#include <trace/trace.h>
+#include <utils/may_be_unused.h>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <csignal>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace protei::trace
+{
+
+namespace
+{
+
+static_assert((RING_RECORDS & (RING_RECORDS - 1)) == 0, "ring index is masked");
+
+/**
+ * @brief Single writer ring of one thread
+ */
+struct ring
+{
+    /// records ever written, stored by owner thread only
+    std::atomic<std::uint64_t> head{0};
+    /// owned by live thread, ring of exited thread keeps its records until reused
+    std::atomic<bool> owned{false};
+    std::array<record, RING_RECORDS> records{};
+};
+
+std::array<std::atomic<ring*>, MAX_THREADS> g_rings{};
+std::array<char, PATH_MAX> g_crash_path{};
+
+thread_local ring* t_ring = nullptr;
+thread_local std::uint32_t t_tid = 0;
+thread_local bool t_no_ring = false;
+
+
+std::int64_t now(clockid_t clock) noexcept
+{
+    timespec ts{};
+    ::clock_gettime(clock, &ts);
+    return std::int64_t{ts.tv_sec} * 1000000000 + ts.tv_nsec;
+}
+
+
+/**
+ * @brief Releases ring of exiting thread for reuse
+ */
+struct ring_owner
+{
+    ~ring_owner()
+    {
+        t_ring->owned.store(false, std::memory_order_release);
+        t_ring = nullptr;
+    }
+};
+
+
+ring* acquire() noexcept
+{
+    for (auto& slot: g_rings)
+    {
+        auto* r = slot.load(std::memory_order_acquire);
+        bool owned = false;
+        if (!r)
+        {
+            auto* fresh = new (std::nothrow) ring;
+            if (!fresh)
+            {
+                break;
+            }
+            fresh->owned.store(true, std::memory_order_relaxed);
+            if (!slot.compare_exchange_strong(r, fresh, std::memory_order_acq_rel))
+            {
+                delete fresh;
+                continue;
+            }
+            r = fresh;
+        }
+        else if (!r->owned.compare_exchange_strong(owned, true, std::memory_order_acquire))
+        {
+            continue;
+        }
+
+        t_ring = r;
+        t_tid = static_cast<std::uint32_t>(::syscall(SYS_gettid));
+        static thread_local ring_owner owner;
+        MAY_BE_UNUSED(owner);
+        return r;
+    }
+    // don't scan slots on every record
+    t_no_ring = true;
+    return nullptr;
+}
+
+
+void on_crash(int signo)
+{
+    dump(g_crash_path.data());
+    // handler is reset to default, signal isn't blocked
+    ::raise(signo);
+}
+
+}
+
+
+void write(op_t op, int fd, std::size_t size, std::int64_t result) noexcept
+{
+    auto* r = t_ring;
+    if (!r && (t_no_ring || !(r = acquire())))
+    {
+        return;
+    }
+    auto head = r->head.load(std::memory_order_relaxed);
+    r->records[head & (RING_RECORDS - 1)] = record{
+            static_cast<std::uint64_t>(now(CLOCK_MONOTONIC))
+            , result
+            , static_cast<std::uint32_t>(size)
+            , fd
+            , t_tid
+            , op
+            , 0};
+    r->head.store(head + 1, std::memory_order_release);
+}
+
+
+bool dump(char const* path) noexcept
+{
+    std::uint64_t capacity = 0;
+    for (auto& slot: g_rings)
+    {
+        if (auto* r = slot.load(std::memory_order_acquire))
+        {
+            capacity += std::min<std::uint64_t>(r->head.load(std::memory_order_acquire), RING_RECORDS);
+        }
+    }
+
+    int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+    std::size_t size = sizeof(file_header) + capacity * sizeof(record);
+    void* map = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0
+        || (map = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    auto* out = reinterpret_cast<record*>(static_cast<char*>(map) + sizeof(file_header));
+    std::uint64_t count = 0;
+    for (auto& slot: g_rings)
+    {
+        auto* r = slot.load(std::memory_order_acquire);
+        if (!r)
+        {
+            continue;
+        }
+        auto head = r->head.load(std::memory_order_acquire);
+        // ring may have advanced since capacity was counted
+        auto first = head - std::min({head, std::uint64_t{RING_RECORDS}, capacity - count});
+        for (auto i = first; i < head; ++i)
+        {
+            out[count + i - first] = r->records[i & (RING_RECORDS - 1)];
+        }
+
+        // records at least RING_RECORDS behind current head may be overwritten while copied
+        std::atomic_thread_fence(std::memory_order_acquire);
+        auto current = r->head.load(std::memory_order_relaxed);
+        auto valid = current >= RING_RECORDS ? current - RING_RECORDS + 1 : 0;
+        if (valid > first)
+        {
+            auto skip = std::min(valid, head) - first;
+            std::memmove(out + count, out + count + skip, (head - first - skip) * sizeof(record));
+            first += skip;
+        }
+        count += head - first;
+    }
+
+    file_header header{
+            file_header::MAGIC
+            , file_header::VERSION
+            , sizeof(record)
+            , now(CLOCK_REALTIME) - now(CLOCK_MONOTONIC)
+            , count};
+    std::memcpy(map, &header, sizeof(header));
+    ::munmap(map, size);
+    bool ret = ::ftruncate(fd, static_cast<off_t>(sizeof(file_header) + count * sizeof(record))) == 0;
+    ::close(fd);
+    return ret;
+}
+
+
+bool install_crash_handler(std::string const& path) noexcept
+{
+    if (path.size() >= g_crash_path.size())
+    {
+        return false;
+    }
+    std::memcpy(g_crash_path.data(), path.c_str(), path.size() + 1);
+
+    struct sigaction action{};
+    action.sa_handler = on_crash;
+    action.sa_flags = SA_RESETHAND | SA_NODEFER;
+    sigemptyset(&action.sa_mask);
+    for (int signo: {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT})
+    {
+        if (::sigaction(signo, &action, nullptr) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+std::optional<trace_file> load(std::string const& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return std::nullopt;
+    }
+    struct stat st{};
+    void* map = MAP_FAILED;
+    if (::fstat(fd, &st) != 0
+        || static_cast<std::size_t>(st.st_size) < sizeof(file_header)
+        || (map = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)) == MAP_FAILED)
+    {
+        ::close(fd);
+        return std::nullopt;
+    }
+    ::close(fd);
+
+    std::optional<trace_file> ret{trace_file{}};
+    std::memcpy(&ret->header, map, sizeof(file_header));
+    auto const& header = ret->header;
+    if (header.magic != file_header::MAGIC
+        || header.version != file_header::VERSION
+        || header.record_size != sizeof(record)
+        || header.records > (st.st_size - sizeof(file_header)) / sizeof(record))
+    {
+        ret.reset();
+    }
+    else
+    {
+        auto const* first = reinterpret_cast<record const*>(static_cast<char const*>(map) + sizeof(file_header));
+        ret->records.assign(first, first + header.records);
+        std::stable_sort(ret->records.begin(), ret->records.end(), [](record const& lhs, record const& rhs)
+        {
+            return lhs.timestamp_ns < rhs.timestamp_ns;
+        });
+    }
+    ::munmap(map, st.st_size);
+    return ret;
+}
+
+
+std::string_view to_string(op_t op) noexcept
+{
+    switch (op)
+    {
+        case op_t::SEND: return "send";
+        case op_t::SEND_CHAIN: return "send_chain";
+        case op_t::RECV: return "recv";
+        case op_t::FINISHED_SEND: return "finished_send";
+        case op_t::FINISHED_RECV: return "finished_recv";
+    }
+    return "unknown";
+}
+
+}
@@ -0,0 +1,442 @@
+#include <uring/fixed_io.h>
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+namespace protei::uring
+{
+
+namespace
+{
+
+enum class op_t : std::uint64_t
+{
+    RECV = 0,
+    SEND = 1,
+};
+
+/// user data of cancellations, their completions are ignored
+constexpr std::uint64_t CANCEL = ~std::uint64_t{0};
+
+
+std::uint64_t user_data(unsigned index, op_t op) noexcept
+{
+    return std::uint64_t{index} << 1 | static_cast<std::uint64_t>(op);
+}
+
+}
+
+
+fixed_slot::fixed_slot(fixed_io* io, unsigned index) noexcept
+    : m_io{io}
+    , m_index{index}
+{}
+
+
+fixed_slot::fixed_slot(fixed_slot&& other) noexcept
+    : m_io{std::exchange(other.m_io, nullptr)}
+    , m_index{other.m_index}
+{}
+
+
+fixed_slot& fixed_slot::operator=(fixed_slot&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (m_io)
+        {
+            m_io->detach(m_index);
+        }
+        m_io = std::exchange(other.m_io, nullptr);
+        m_index = other.m_index;
+    }
+    return *this;
+}
+
+
+fixed_slot::~fixed_slot()
+{
+    if (m_io)
+    {
+        m_io->detach(m_index);
+    }
+}
+
+
+std::optional<std::size_t> fixed_slot::send(void const* data, std::size_t n) noexcept
+{
+    auto space = m_io->send_space(m_index, n);
+    if (space)
+    {
+        std::memcpy(m_io->send_buffer(m_index) + m_io->m_slots[m_index].queued, data, *space);
+        m_io->commit_send(m_index, *space);
+    }
+    return space;
+}
+
+
+std::optional<std::size_t> fixed_slot::send(buffer::iobuf const& buf) noexcept
+{
+    auto space = m_io->send_space(m_index, buf.size());
+    if (space)
+    {
+        // slice shares blocks, so only queued part is copied
+        buf.slice(0, *space).copy_to(m_io->send_buffer(m_index) + m_io->m_slots[m_index].queued);
+        m_io->commit_send(m_index, *space);
+    }
+    return space;
+}
+
+
+std::optional<std::size_t> fixed_slot::recv(void* data, std::size_t n) noexcept
+{
+    return m_io->take_received(m_index, data, n);
+}
+
+
+bool fixed_slot::readable() const noexcept
+{
+    auto const& slot = m_io->m_slots[m_index];
+    return slot.received || slot.end_of_stream || slot.recv_error;
+}
+
+
+std::size_t fixed_slot::unsent() const noexcept
+{
+    return m_io->m_slots[m_index].queued;
+}
+
+
+fixed_io::fixed_io(uring_t&& ring, std::size_t buffer_size, bool fixed_buffers) noexcept
+    : m_ring{std::move(ring)}
+    , m_buffer_size{buffer_size}
+    , m_fixed_buffers{fixed_buffers}
+{}
+
+
+std::optional<fixed_io> fixed_io::create(unsigned slots, std::size_t buffer_size, bool fixed_buffers) noexcept
+{
+    // receive and send of each slot may be queued at once, larger rings are flushed by submission on overflow
+    auto ring = uring_t::create(std::clamp(slots, 1u, 2048u) * 2);
+    if (!ring || slots == 0 || buffer_size == 0 || !ring->register_files(slots))
+    {
+        return std::nullopt;
+    }
+
+    fixed_io ret{std::move(*ring), buffer_size, fixed_buffers};
+    ret.m_arena_size = std::size_t{slots} * 2 * buffer_size;
+    auto* arena = ::mmap(nullptr, ret.m_arena_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (arena == MAP_FAILED)
+    {
+        return std::nullopt;
+    }
+    ret.m_arena = static_cast<char*>(arena);
+    if (fixed_buffers && !ret.m_ring.register_buffer(ret.m_arena, ret.m_arena_size))
+    {
+        return std::nullopt;
+    }
+
+    ret.m_slots.resize(slots);
+    ret.m_free.reserve(slots);
+    for (auto index = slots; index > 0; --index)
+    {
+        ret.m_free.push_back(index - 1);
+    }
+    return ret;
+}
+
+
+fixed_io::fixed_io(fixed_io&& other) noexcept
+    : m_ring{std::move(other.m_ring)}
+    , m_buffer_size{other.m_buffer_size}
+    , m_fixed_buffers{other.m_fixed_buffers}
+    , m_arena{std::exchange(other.m_arena, nullptr)}
+    , m_arena_size{other.m_arena_size}
+    , m_slots{std::move(other.m_slots)}
+    , m_free{std::move(other.m_free)}
+    , m_completions{std::move(other.m_completions)}
+{}
+
+
+fixed_io& fixed_io::operator=(fixed_io&& other) noexcept
+{
+    if (this != &other)
+    {
+        std::swap(m_ring, other.m_ring);
+        std::swap(m_buffer_size, other.m_buffer_size);
+        std::swap(m_fixed_buffers, other.m_fixed_buffers);
+        std::swap(m_arena, other.m_arena);
+        std::swap(m_arena_size, other.m_arena_size);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_free, other.m_free);
+        std::swap(m_completions, other.m_completions);
+    }
+    return *this;
+}
+
+
+fixed_io::~fixed_io()
+{
+    // buffer of zero copy send, notified after destruction, stays pinned by registration until ring is closed
+    if (m_arena)
+    {
+        ::munmap(m_arena, m_arena_size);
+    }
+}
+
+
+std::optional<fixed_slot> fixed_io::attach(int fd) noexcept
+{
+    if (m_free.empty() || !m_ring.update_file(m_free.back(), fd))
+    {
+        return std::nullopt;
+    }
+
+    auto index = m_free.back();
+    m_free.pop_back();
+    m_slots[index] = slot_state{};
+    m_slots[index].fd = fd;
+    queue_recv(index);
+    return fixed_slot{this, index};
+}
+
+
+std::size_t fixed_io::available() const noexcept
+{
+    return m_free.size();
+}
+
+
+bool fixed_io::serves(int fd) const noexcept
+{
+    return fd != -1 && std::any_of(m_slots.begin(), m_slots.end(), [fd](auto const& slot) { return slot.fd == fd; });
+}
+
+
+bool fixed_io::submit() noexcept
+{
+    return m_ring.submit();
+}
+
+
+std::size_t fixed_io::reap(std::chrono::milliseconds timeout) noexcept
+{
+    m_completions.clear();
+    m_ring.proceed(timeout, m_completions);
+    for (auto const& done: m_completions)
+    {
+        complete(done);
+    }
+    // receives and sends queued again by completions
+    m_ring.submit();
+    return m_completions.size();
+}
+
+
+int fixed_io::native_handle() const noexcept
+{
+    return m_ring.native_handle();
+}
+
+
+std::optional<std::size_t> fixed_io::send_space(unsigned index, std::size_t n) noexcept
+{
+    auto const& slot = m_slots[index];
+    if (slot.send_error)
+    {
+        errno = slot.send_error;
+        return std::nullopt;
+    }
+    else if (slot.queued == m_buffer_size && n)
+    {
+        // socket API compatible would block reporting
+        errno = EAGAIN;
+        return std::nullopt;
+    }
+    return std::min(n, m_buffer_size - slot.queued);
+}
+
+
+void fixed_io::commit_send(unsigned index, std::size_t n) noexcept
+{
+    m_slots[index].queued += n;
+    flush(index);
+}
+
+
+std::optional<std::size_t> fixed_io::take_received(unsigned index, void* data, std::size_t n) noexcept
+{
+    auto& slot = m_slots[index];
+    if (slot.received)
+    {
+        auto taken = std::min(n, slot.received);
+        std::memcpy(data, recv_buffer(index) + slot.recv_offset, taken);
+        slot.recv_offset += taken;
+        slot.received -= taken;
+        if (!slot.received)
+        {
+            queue_recv(index);
+        }
+        return taken;
+    }
+    else if (slot.end_of_stream)
+    {
+        return 0;
+    }
+
+    errno = slot.recv_error ? slot.recv_error : EAGAIN;
+    return std::nullopt;
+}
+
+
+bool fixed_io::queue_recv(unsigned index) noexcept
+{
+    auto& slot = m_slots[index];
+    if (!m_ring.recv(
+            static_cast<int>(index)
+            , recv_buffer(index)
+            , m_buffer_size
+            , user_data(index, op_t::RECV)
+            , fixed_t{true, m_fixed_buffers}))
+    {
+        slot.recv_error = ENOBUFS;
+        return false;
+    }
+    slot.recv_queued = true;
+    ++slot.pending;
+    return true;
+}
+
+
+bool fixed_io::flush(unsigned index) noexcept
+{
+    auto& slot = m_slots[index];
+    if (slot.in_flight || !slot.queued || slot.send_error)
+    {
+        return true;
+    }
+
+    auto send = slot.copy_send ? &uring_t::write : &uring_t::send;
+    if (!(m_ring.*send)(
+            static_cast<int>(index)
+            , send_buffer(index)
+            , slot.queued
+            , user_data(index, op_t::SEND)
+            , fixed_t{true, m_fixed_buffers}))
+    {
+        slot.send_error = ENOBUFS;
+        return false;
+    }
+    slot.in_flight = slot.queued;
+    slot.sent = 0;
+    ++slot.pending;
+    return true;
+}
+
+
+void fixed_io::complete(completion const& done) noexcept
+{
+    if (done.user_data == CANCEL)
+    {
+        return;
+    }
+
+    auto index = static_cast<unsigned>(done.user_data >> 1);
+    auto& slot = m_slots[index];
+    if (static_cast<op_t>(done.user_data & 1) == op_t::SEND)
+    {
+        if (!done.notification)
+        {
+            if (done.result == -EOPNOTSUPP && m_fixed_buffers && !slot.copy_send)
+            {
+                // socket has no zero copy support, data is sent again by copying write
+                slot.copy_send = true;
+            }
+            else if (done.result < 0)
+            {
+                slot.send_error = -done.result;
+            }
+            else
+            {
+                slot.sent = static_cast<std::size_t>(done.result);
+            }
+            if (done.more)
+            {
+                // zero copy send: buffer is released by notification
+                return;
+            }
+        }
+
+        --slot.pending;
+        slot.queued -= slot.sent;
+        std::memmove(send_buffer(index), send_buffer(index) + slot.sent, slot.queued);
+        slot.in_flight = 0;
+        slot.sent = 0;
+        if (slot.fd != -1)
+        {
+            flush(index);
+        }
+    }
+    else
+    {
+        --slot.pending;
+        slot.recv_queued = false;
+        if (done.result > 0)
+        {
+            slot.received = static_cast<std::size_t>(done.result);
+            slot.recv_offset = 0;
+        }
+        else if (done.result == 0)
+        {
+            slot.end_of_stream = true;
+        }
+        else
+        {
+            slot.recv_error = -done.result;
+        }
+    }
+
+    if (slot.fd == -1 && !slot.pending)
+    {
+        m_free.push_back(index);
+    }
+}
+
+
+void fixed_io::detach(unsigned index) noexcept
+{
+    auto& slot = m_slots[index];
+    slot.fd = -1;
+    // queued operations take file reference on submission, so they are submitted before file is cleared
+    m_ring.submit();
+    if (slot.recv_queued)
+    {
+        m_ring.cancel(user_data(index, op_t::RECV), CANCEL);
+    }
+    slot.queued = slot.in_flight;
+    m_ring.update_file(index, -1);
+    // cancellation of receive waiting for data completes on submission, so it doesn't hold socket open
+    m_ring.submit();
+    if (!slot.pending)
+    {
+        m_free.push_back(index);
+    }
+}
+
+
+char* fixed_io::recv_buffer(unsigned index) const noexcept
+{
+    return m_arena + std::size_t{index} * 2 * m_buffer_size;
+}
+
+
+char* fixed_io::send_buffer(unsigned index) const noexcept
+{
+    return recv_buffer(index) + m_buffer_size;
+}
+
+}
@@ -0,0 +1,574 @@
+#include <uring/uring.h>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace protei::uring
+{
+
+namespace
+{
+
+int io_uring_setup(unsigned entries, io_uring_params* params) noexcept
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+
+int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags, void* arg, std::size_t size) noexcept
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, size));
+}
+
+
+int io_uring_register(int fd, unsigned opcode, void* arg, unsigned nr_args) noexcept
+{
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+
+template <typename T>
+T* at(void* base, std::uint32_t offset) noexcept
+{
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+
+/// ring indexes are shared with kernel
+std::uint32_t load_acquire(std::uint32_t const* ptr) noexcept
+{
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+
+template <typename T>
+void store_release(T* ptr, T value) noexcept
+{
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+}
+
+
+uring_t::uring_t(unsigned entries)
+{
+    if (!setup(entries))
+    {
+        throw std::runtime_error("Error creating io_uring. Errno: " + std::to_string(errno));
+    }
+}
+
+
+std::optional<uring_t> uring_t::create(unsigned entries) noexcept
+{
+    uring_t ret{};
+    if (ret.setup(entries))
+    {
+        return ret;
+    }
+    return std::nullopt;
+}
+
+
+uring_t::uring_t(uring_t&& other) noexcept
+{
+    exchange(std::move(other));
+}
+
+
+uring_t& uring_t::operator=(uring_t&& other) noexcept
+{
+    if (this != &other)
+    {
+        exchange(std::move(other));
+    }
+    return *this;
+}
+
+
+uring_t::~uring_t()
+{
+    unmap();
+    if (m_fd != -1)
+    {
+        ::close(m_fd);
+    }
+}
+
+
+bool uring_t::setup(unsigned entries) noexcept
+{
+    io_uring_params params{};
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = entries * 4;
+    m_fd = io_uring_setup(entries, &params);
+    if (m_fd == -1)
+    {
+        return false;
+    }
+
+    m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+    m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap)
+    {
+        m_sq_ring_size = m_cq_ring_size = std::max(m_sq_ring_size, m_cq_ring_size);
+    }
+    m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+    m_sq_ring = ::mmap(nullptr, m_sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+    m_cq_ring = single_mmap
+            ? m_sq_ring
+            : ::mmap(nullptr, m_cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+    m_sqes = ::mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+    if (m_sq_ring == MAP_FAILED || m_cq_ring == MAP_FAILED || m_sqes == MAP_FAILED)
+    {
+        auto error = errno;
+        unmap();
+        ::close(std::exchange(m_fd, -1));
+        errno = error;
+        return false;
+    }
+
+    m_sq_head = at<std::uint32_t>(m_sq_ring, params.sq_off.head);
+    m_sq_tail = at<std::uint32_t>(m_sq_ring, params.sq_off.tail);
+    m_sq_flags = at<std::uint32_t>(m_sq_ring, params.sq_off.flags);
+    m_sq_mask = *at<std::uint32_t>(m_sq_ring, params.sq_off.ring_mask);
+    m_sq_entries = params.sq_entries;
+    m_cq_head = at<std::uint32_t>(m_cq_ring, params.cq_off.head);
+    m_cq_tail = at<std::uint32_t>(m_cq_ring, params.cq_off.tail);
+    m_cq_mask = *at<std::uint32_t>(m_cq_ring, params.cq_off.ring_mask);
+    m_cqes = at<void>(m_cq_ring, params.cq_off.cqes);
+
+    // submission queue entries are used in order, so index array is identity
+    auto* array = at<std::uint32_t>(m_sq_ring, params.sq_off.array);
+    for (std::uint32_t i = 0; i < m_sq_entries; ++i)
+    {
+        array[i] = i;
+    }
+    return true;
+}
+
+
+void uring_t::unmap() noexcept
+{
+    if (m_sqes && m_sqes != MAP_FAILED)
+    {
+        ::munmap(m_sqes, m_sqes_size);
+    }
+    if (m_cq_ring && m_cq_ring != MAP_FAILED && m_cq_ring != m_sq_ring)
+    {
+        ::munmap(m_cq_ring, m_cq_ring_size);
+    }
+    if (m_sq_ring && m_sq_ring != MAP_FAILED)
+    {
+        ::munmap(m_sq_ring, m_sq_ring_size);
+    }
+    m_sqes = m_cq_ring = m_sq_ring = nullptr;
+}
+
+
+void* uring_t::get_sqe() noexcept
+{
+    auto tail = *m_sq_tail;
+    if (tail - load_acquire(m_sq_head) >= m_sq_entries && (!submit() || tail - load_acquire(m_sq_head) >= m_sq_entries))
+    {
+        return nullptr;
+    }
+
+    auto* sqe = static_cast<io_uring_sqe*>(m_sqes) + (tail & m_sq_mask);
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+
+bool uring_t::accept_multishot(int fd, std::uint64_t user_data) noexcept
+{
+    auto* sqe = static_cast<io_uring_sqe*>(get_sqe());
+    if (!sqe)
+    {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    sqe->user_data = user_data;
+    store_release(m_sq_tail, *m_sq_tail + 1);
+    ++m_pending;
+    return true;
+}
+
+
+bool uring_t::recv_multishot(int fd, std::uint16_t buffer_group, std::uint64_t user_data) noexcept
+{
+    auto* sqe = static_cast<io_uring_sqe*>(get_sqe());
+    if (!sqe)
+    {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = buffer_group;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->user_data = user_data;
+    store_release(m_sq_tail, *m_sq_tail + 1);
+    ++m_pending;
+    return true;
+}
+
+
+bool uring_t::send(int fd, void const* data, std::size_t n, std::uint64_t user_data, fixed_t fixed) noexcept
+{
+    return queue_rw(fixed.buffer ? IORING_OP_SEND_ZC : IORING_OP_SEND, fd, data, n, user_data, fixed);
+}
+
+
+bool uring_t::write(int fd, void const* data, std::size_t n, std::uint64_t user_data, fixed_t fixed) noexcept
+{
+    return queue_rw(fixed.buffer ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE, fd, data, n, user_data, fixed);
+}
+
+
+bool uring_t::recv(int fd, void* data, std::size_t n, std::uint64_t user_data, fixed_t fixed) noexcept
+{
+    return queue_rw(fixed.buffer ? IORING_OP_READ_FIXED : IORING_OP_RECV, fd, data, n, user_data, fixed);
+}
+
+
+bool uring_t::queue_rw(
+        int opcode
+        , int fd
+        , void const* data
+        , std::size_t n
+        , std::uint64_t user_data
+        , fixed_t fixed) noexcept
+{
+    auto* sqe = static_cast<io_uring_sqe*>(get_sqe());
+    if (!sqe)
+    {
+        return false;
+    }
+
+    sqe->opcode = static_cast<std::uint8_t>(opcode);
+    sqe->fd = fd;
+    sqe->flags = fixed.file ? IOSQE_FIXED_FILE : 0;
+    sqe->addr = reinterpret_cast<std::uint64_t>(data);
+    sqe->len = static_cast<std::uint32_t>(n);
+    // io_uring waits for readiness of non-blocking socket instead of failing with EAGAIN, so operation completes
+    // when data is transferred
+    if (opcode == IORING_OP_SEND || opcode == IORING_OP_SEND_ZC)
+    {
+        // short send of stream socket is retried by kernel until all data is sent
+        sqe->msg_flags = MSG_WAITALL;
+        if (fixed.buffer)
+        {
+            sqe->ioprio = IORING_RECVSEND_FIXED_BUF;
+        }
+    }
+    // index of registered buffer, read and write of socket ignore offset
+    sqe->buf_index = 0;
+    sqe->user_data = user_data;
+    store_release(m_sq_tail, *m_sq_tail + 1);
+    ++m_pending;
+    return true;
+}
+
+
+bool uring_t::register_files(unsigned count) noexcept
+{
+    std::vector<int> fds(count, -1);
+    return io_uring_register(m_fd, IORING_REGISTER_FILES, fds.data(), count) == 0;
+}
+
+
+bool uring_t::update_file(unsigned index, int fd) noexcept
+{
+    io_uring_files_update update{};
+    update.offset = index;
+    update.fds = reinterpret_cast<std::uint64_t>(&fd);
+    return io_uring_register(m_fd, IORING_REGISTER_FILES_UPDATE, &update, 1) == 1;
+}
+
+
+bool uring_t::register_buffer(void* data, std::size_t size) noexcept
+{
+    iovec buffer{data, size};
+    return io_uring_register(m_fd, IORING_REGISTER_BUFFERS, &buffer, 1) == 0;
+}
+
+
+bool uring_t::cancel(std::uint64_t target, std::uint64_t user_data) noexcept
+{
+    auto* sqe = static_cast<io_uring_sqe*>(get_sqe());
+    if (!sqe)
+    {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = target;
+    sqe->user_data = user_data;
+    store_release(m_sq_tail, *m_sq_tail + 1);
+    ++m_pending;
+    return true;
+}
+
+
+bool uring_t::submit() noexcept
+{
+    while (m_pending)
+    {
+        auto submitted = io_uring_enter(m_fd, m_pending, 0, 0, nullptr, 0);
+        if (submitted < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        m_pending -= static_cast<unsigned>(submitted);
+    }
+    return true;
+}
+
+
+std::optional<completion> uring_t::wait() noexcept
+{
+    while (load_acquire(m_cq_tail) == *m_cq_head || m_pending)
+    {
+        auto submitted = io_uring_enter(m_fd, m_pending, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (submitted < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return std::nullopt;
+        }
+        m_pending -= static_cast<unsigned>(submitted);
+    }
+
+    auto head = *m_cq_head;
+    auto const& cqe = static_cast<io_uring_cqe*>(m_cqes)[head & m_cq_mask];
+    completion ret{
+            cqe.user_data
+            , cqe.res
+            , (cqe.flags & IORING_CQE_F_MORE) != 0
+            , std::nullopt
+            , (cqe.flags & IORING_CQE_F_NOTIF) != 0};
+    store_release(m_cq_head, head + 1);
+    return ret;
+}
+
+
+std::size_t uring_t::proceed(std::chrono::milliseconds timeout, std::vector<completion>& completions) noexcept
+{
+    // completions may be ready or overflowed to kernel list, don't wait then
+    bool ready = load_acquire(m_cq_tail) != *m_cq_head;
+    bool overflow = load_acquire(m_sq_flags) & IORING_SQ_CQ_OVERFLOW;
+    if (!ready || overflow || m_pending)
+    {
+        __kernel_timespec ts{};
+        ts.tv_sec = std::chrono::duration_cast<std::chrono::seconds>(timeout).count();
+        ts.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout % std::chrono::seconds{1}).count();
+        io_uring_getevents_arg arg{};
+        arg.ts = reinterpret_cast<std::uint64_t>(&ts);
+        unsigned min_complete = ready ? 0 : 1;
+        auto submitted = io_uring_enter(
+                m_fd
+                , m_pending
+                , min_complete
+                , IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG
+                , &arg
+                , sizeof(arg));
+        if (submitted > 0)
+        {
+            m_pending -= static_cast<unsigned>(submitted);
+        }
+    }
+
+    return harvest(completions);
+}
+
+
+std::size_t uring_t::harvest(std::vector<completion>& completions) noexcept
+{
+    auto head = *m_cq_head;
+    auto tail = load_acquire(m_cq_tail);
+    auto* cqes = static_cast<io_uring_cqe*>(m_cqes);
+    for (auto i = head; i != tail; ++i)
+    {
+        auto const& cqe = cqes[i & m_cq_mask];
+        completions.push_back(completion{
+                cqe.user_data
+                , cqe.res
+                , (cqe.flags & IORING_CQE_F_MORE) != 0
+                , cqe.flags & IORING_CQE_F_BUFFER
+                        ? std::optional<std::uint16_t>{static_cast<std::uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT)}
+                        : std::nullopt
+                , (cqe.flags & IORING_CQE_F_NOTIF) != 0});
+    }
+    store_release(m_cq_head, tail);
+    return tail - head;
+}
+
+
+int uring_t::native_handle() const noexcept
+{
+    return m_fd;
+}
+
+
+void uring_t::exchange(uring_t&& other) noexcept
+{
+    // resources of this are released by other
+    std::swap(m_fd, other.m_fd);
+    std::swap(m_sq_ring, other.m_sq_ring);
+    std::swap(m_sq_ring_size, other.m_sq_ring_size);
+    std::swap(m_cq_ring, other.m_cq_ring);
+    std::swap(m_cq_ring_size, other.m_cq_ring_size);
+    std::swap(m_sqes, other.m_sqes);
+    std::swap(m_sqes_size, other.m_sqes_size);
+    std::swap(m_sq_head, other.m_sq_head);
+    std::swap(m_sq_tail, other.m_sq_tail);
+    std::swap(m_sq_flags, other.m_sq_flags);
+    std::swap(m_sq_mask, other.m_sq_mask);
+    std::swap(m_sq_entries, other.m_sq_entries);
+    std::swap(m_cq_head, other.m_cq_head);
+    std::swap(m_cq_tail, other.m_cq_tail);
+    std::swap(m_cq_mask, other.m_cq_mask);
+    std::swap(m_cqes, other.m_cqes);
+    std::swap(m_pending, other.m_pending);
+}
+
+
+std::optional<provided_buffers> provided_buffers::create(
+        uring_t& ring
+        , std::uint16_t group
+        , std::uint16_t count
+        , std::uint32_t size) noexcept
+{
+    if (count == 0 || (count & (count - 1)) != 0 || count > 32768 || size == 0)
+    {
+        return std::nullopt;
+    }
+
+    // ring must be page aligned, buffers follow it in the same mapping
+    auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto ring_size = (count * sizeof(io_uring_buf) + page - 1) / page * page;
+    provided_buffers ret{};
+    ret.m_memory_size = ring_size + std::size_t{count} * size;
+    ret.m_memory = ::mmap(nullptr, ret.m_memory_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ret.m_memory == MAP_FAILED)
+    {
+        ret.m_memory = nullptr;
+        return std::nullopt;
+    }
+
+    io_uring_buf_reg reg{};
+    reg.ring_addr = reinterpret_cast<std::uint64_t>(ret.m_memory);
+    reg.ring_entries = count;
+    reg.bgid = group;
+    if (io_uring_register(ring.native_handle(), IORING_REGISTER_PBUF_RING, &reg, 1) != 0)
+    {
+        return std::nullopt;
+    }
+
+    ret.m_ring_fd = ring.native_handle();
+    ret.m_buffers = static_cast<char*>(ret.m_memory) + ring_size;
+    ret.m_size = size;
+    ret.m_count = count;
+    ret.m_group = group;
+    for (std::uint16_t id = 0; id < count; ++id)
+    {
+        ret.recycle(id);
+    }
+    return ret;
+}
+
+
+provided_buffers::~provided_buffers()
+{
+    if (m_ring_fd != -1)
+    {
+        io_uring_buf_reg reg{};
+        reg.bgid = m_group;
+        io_uring_register(m_ring_fd, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+    }
+    if (m_memory)
+    {
+        ::munmap(m_memory, m_memory_size);
+    }
+}
+
+
+provided_buffers::provided_buffers(provided_buffers&& other) noexcept
+{
+    exchange(std::move(other));
+}
+
+
+provided_buffers& provided_buffers::operator=(provided_buffers&& other) noexcept
+{
+    if (this != &other)
+    {
+        exchange(std::move(other));
+    }
+    return *this;
+}
+
+
+char* provided_buffers::data(std::uint16_t id) const noexcept
+{
+    return m_buffers + std::size_t{id} * m_size;
+}
+
+
+void provided_buffers::recycle(std::uint16_t id) noexcept
+{
+    // io_uring_buf_ring isn't used: its flexible array is shifted by empty struct in C++. Ring tail overlays resv
+    // field of the first buffer
+    auto* bufs = static_cast<io_uring_buf*>(m_memory);
+    auto& buf = bufs[m_tail & (m_count - 1)];
+    buf.addr = reinterpret_cast<std::uint64_t>(data(id));
+    buf.len = m_size;
+    buf.bid = id;
+    store_release(&bufs[0].resv, ++m_tail);
+}
+
+
+std::uint16_t provided_buffers::group() const noexcept
+{
+    return m_group;
+}
+
+
+void provided_buffers::exchange(provided_buffers&& other) noexcept
+{
+    std::swap(m_ring_fd, other.m_ring_fd);
+    std::swap(m_memory, other.m_memory);
+    std::swap(m_memory_size, other.m_memory_size);
+    std::swap(m_buffers, other.m_buffers);
+    std::swap(m_size, other.m_size);
+    std::swap(m_count, other.m_count);
+    std::swap(m_tail, other.m_tail);
+    std::swap(m_group, other.m_group);
+}
+
+}
@@ -14,4 +14,19 @@ std::optional<sock::in_address_port_t> from_string_and_port(std::string const& s
             });
 }
 
+
+
+template <>
+std::optional<sock::in_address_port_t> address_from_string(std::string const& str, std::uint_fast16_t port) noexcept
+{
+    return from_string_and_port(str, port);
+}
+
+
+template <>
+std::optional<sock::unix_address_t> address_from_string(std::string const& str, std::uint_fast16_t) noexcept
+{
+    return sock::unix_address_t::create(str);
+}
+
 }
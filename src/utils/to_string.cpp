@@ -1,5 +1,7 @@
 #include <utils/mbind.h>
 #include <socket/in_address.h>
+#include <socket/native_address.h>
+#include <socket/unix_address.h>
 
 #include <arpa/inet.h>
 
@@ -22,4 +24,19 @@ std::string to_string(sock::in_address_port_t addr) noexcept
     return to_string(addr.addr) + ":" + std::to_string(addr.port);
 }
 
+
+
+std::string to_string(sock::native_address_t const& addr) noexcept
+{
+    auto in_addr = addr.to_in_address_port();
+    return in_addr ? to_string(*in_addr) : std::string{};
+}
+
+
+
+std::string to_string(sock::unix_address_t const& addr) noexcept
+{
+    return addr.name();
+}
+
 }
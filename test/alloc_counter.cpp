@@ -0,0 +1,132 @@
+#include "alloc_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+thread_local protei::test::alloc_stats allocations;
+
+void* allocate(std::size_t size)
+{
+    ++allocations.allocations;
+    allocations.bytes += size;
+    // malloc(0) may return nullptr, operator new must not
+    return std::malloc(size ? size : 1);
+}
+
+void* allocate(std::size_t size, std::align_val_t align)
+{
+    ++allocations.allocations;
+    allocations.bytes += size;
+    auto alignment = static_cast<std::size_t>(align);
+    // aligned_alloc requires size multiple of alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+}
+
+namespace protei::test
+{
+
+alloc_stats thread_allocations() noexcept
+{
+    return allocations;
+}
+
+}
+
+
+// replacements of global allocation functions, whole test binary is counted
+
+void* operator new(std::size_t size)
+{
+    if (auto* ptr = allocate(size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept
+{
+    return allocate(size);
+}
+
+
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept
+{
+    return allocate(size);
+}
+
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    if (auto* ptr = allocate(size, align))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+    return operator new(size, align);
+}
+
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,86 @@
+#ifndef PROTEI_TEST_TASK_ALLOC_COUNTER_H
+#define PROTEI_TEST_TASK_ALLOC_COUNTER_H
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+namespace protei::test
+{
+
+/**
+ * @brief Heap allocations of calling thread counted by test binary's global operator new replacement
+ */
+struct alloc_stats
+{
+    std::size_t allocations = 0;
+    std::size_t bytes = 0;
+};
+
+/**
+ * @return allocations made by calling thread since its start
+ */
+alloc_stats thread_allocations() noexcept;
+
+
+/**
+ * @brief Counts heap allocations of calling thread made during scope lifetime
+ */
+class alloc_scope
+{
+public:
+    alloc_scope() noexcept
+        : m_start{thread_allocations()}
+    {}
+
+    /**
+     * @return allocations count since scope construction
+     */
+    std::size_t allocations() const noexcept
+    {
+        return thread_allocations().allocations - m_start.allocations;
+    }
+
+    /**
+     * @return allocated bytes since scope construction
+     */
+    std::size_t bytes() const noexcept
+    {
+        return thread_allocations().bytes - m_start.bytes;
+    }
+
+private:
+    alloc_stats m_start;
+};
+
+}
+
+#define PROTEI_ALLOC_CHECK_(statement, expected, fail) \
+    do \
+    { \
+        ::protei::test::alloc_scope alloc_scope_; \
+        statement; \
+        auto const allocations_ = alloc_scope_.allocations(); \
+        if (allocations_ != (expected)) \
+        { \
+            fail() << #statement " made " << allocations_ << " heap allocations (" << alloc_scope_.bytes() \
+                   << " bytes), expected " << (expected); \
+        } \
+    } while (false)
+
+/**
+ * @brief Expect statement makes no heap allocation in calling thread
+ */
+#define EXPECT_NO_ALLOC(statement) PROTEI_ALLOC_CHECK_(statement, 0u, ADD_FAILURE)
+
+/**
+ * @brief Assert statement makes no heap allocation in calling thread
+ */
+#define ASSERT_NO_ALLOC(statement) PROTEI_ALLOC_CHECK_(statement, 0u, FAIL)
+
+/**
+ * @brief Expect statement makes exactly count heap allocations in calling thread
+ */
+#define EXPECT_ALLOC_COUNT(statement, count) PROTEI_ALLOC_CHECK_(statement, static_cast<std::size_t>(count), ADD_FAILURE)
+
+#endif //PROTEI_TEST_TASK_ALLOC_COUNTER_H
@@ -0,0 +1,154 @@
+#include "alloc_counter.h"
+
+#include <endpoint/server.h>
+#include <endpoint/client.h>
+#include <epoll/epoll.h>
+#include <socket/af_inet.h>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <unistd.h>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::endpoint;
+
+TEST(alloc_counter, countsThreadAllocations)
+{
+    EXPECT_ALLOC_COUNT(auto ptr = std::make_unique<int>(1), 1);
+    EXPECT_ALLOC_COUNT(std::string str(100, 'a'), 1);
+    EXPECT_NO_ALLOC(int value = 1; (void)value);
+
+    test::alloc_scope scope;
+    std::vector<char> vec(64);
+    EXPECT_EQ(scope.allocations(), 1u);
+    EXPECT_GE(scope.bytes(), 64u);
+}
+
+
+TEST(alloc, tcpSteadyStateCycle)
+{
+    server_t<tcp, epoll_t> server{epoll_t{5, 10u}, ipv4{}};
+    std::optional<accepted_sock<tcp>> accepted;
+    auto listener = utils::mbind(
+            socket_t<tcp>::create(ipv4{})
+            , [](socket_t<tcp>&& sock)
+            {
+                sock.set_reuse_address(true);
+                return sock.bind(in_address_port_t{in_address_t{"127.0.0.1"}, 7911});
+            }
+            , [](binded_socket_t<tcp>&& sock) { return sock.listen(4); });
+    ASSERT_TRUE(listener);
+    ASSERT_TRUE(server.start(
+            ::dup(listener->native_handle())
+            , 4
+            , [&accepted](accepted_sock<tcp>&& sock) { accepted.emplace(std::move(sock)); }
+            , [&accepted](int fd)
+            {
+                if (accepted && accepted->native_handle() == fd)
+                {
+                    accepted.reset();
+                }
+            }));
+
+    bool read_ready = false;
+    client_t<tcp, epoll_t> client{epoll_t{5, 10u}, ipv4{}};
+    ASSERT_TRUE(client.start());
+    ASSERT_TRUE(client.connect("127.0.0.1", 7911, [](){}, [&read_ready]() { read_ready = true; }, [](){}));
+    for (int i = 0; i < 10 && !accepted; ++i)
+    {
+        server.proceed(std::chrono::milliseconds{10});
+    }
+    ASSERT_TRUE(accepted);
+
+    // receive -> handle -> send through server's event loop and back to client
+    char const request[] = "steady state request";
+    char buff[64];
+    auto cycle = [&]() -> bool
+    {
+        read_ready = false;
+        if (client.send(const_cast<char*>(request), sizeof(request)) != sizeof(request)
+            || !server.proceed(std::chrono::milliseconds{100}))
+        {
+            return false;
+        }
+        auto rec = accepted->recv(buff, sizeof(buff));
+        if (!rec || rec->second != sizeof(request) || std::memcmp(buff, request, sizeof(request)) != 0
+            || accepted->send(buff, rec->second) != sizeof(request))
+        {
+            return false;
+        }
+        for (int i = 0; i < 10 && !read_ready; ++i)
+        {
+            client.proceed(std::chrono::milliseconds{10});
+        }
+        auto echo = client.recv(buff, sizeof(buff));
+        return read_ready && echo && echo->second == sizeof(request);
+    };
+
+    // warm up: lazily sized event buffers of epoll and event loop
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(cycle());
+    }
+    bool done = false;
+    EXPECT_NO_ALLOC(done = cycle());
+    EXPECT_TRUE(done);
+}
+
+
+TEST(alloc, udpSteadyStateCycle)
+{
+    server_t<udp, epoll_t> server{epoll_t{5, 10u}, ipv4{}};
+    std::optional<accepted_sock_ref<udp>> sock;
+    ASSERT_TRUE(server.start(
+            "127.0.0.1"
+            , 7912
+            , [&sock](accepted_sock_ref<udp>&& ref)
+            {
+                if (!sock)
+                {
+                    sock.emplace(std::move(ref));
+                }
+            }
+            , [&sock]() { sock.reset(); }));
+
+    client_t<udp, epoll_t> client{epoll_t{5, 10u}, ipv4{}};
+    ASSERT_TRUE(client.start());
+    ASSERT_TRUE(client.connect("127.0.0.1", 7912, [](){}, [](){}, [](){}));
+
+    char const request[] = "steady state datagram";
+    char buff[64];
+    auto cycle = [&]() -> bool
+    {
+        if (client.send(const_cast<char*>(request), sizeof(request)) != sizeof(request)
+            || !server.proceed(std::chrono::milliseconds{100})
+            || !sock)
+        {
+            return false;
+        }
+        auto rec = sock->recv(buff, sizeof(buff));
+        if (!rec || rec->second != sizeof(request) || sock->send(buff, rec->second) != sizeof(request))
+        {
+            return false;
+        }
+        std::optional<std::pair<in_address_port_t, std::size_t>> echo;
+        for (int i = 0; i < 10 && !echo; ++i)
+        {
+            client.proceed(std::chrono::milliseconds{10});
+            echo = client.recv(buff, sizeof(buff));
+        }
+        return echo && echo->second == sizeof(request);
+    };
+
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(cycle());
+    }
+    bool done = false;
+    EXPECT_NO_ALLOC(done = cycle());
+    EXPECT_TRUE(done);
+}
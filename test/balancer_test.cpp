@@ -0,0 +1,102 @@
+#include <endpoint/balancer.h>
+#include <endpoint/server.h>
+#include <endpoint/client.h>
+#include <epoll/epoll.h>
+#include <socket/af_unix.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::endpoint;
+
+TEST(least_loaded_balancer, choose)
+{
+    least_loaded_balancer balancer;
+    EXPECT_EQ(balancer({3, 0, 1}, 0), 1u);
+    EXPECT_FALSE(balancer({1, 0}, 0));
+    EXPECT_FALSE(balancer({0, 3}, 0));
+    EXPECT_FALSE(balancer({3}, 1));
+    EXPECT_FALSE((least_loaded_balancer{5}({5, 0}, 0)));
+}
+
+
+TEST(balancer, migrateBetweenReactors)
+{
+    using server = server_t<unix_stream, epoll_t>;
+    server source{epoll_t{5, 10u}, local{}};
+    server destination{epoll_t{5, 10u}, local{}};
+    std::vector<accepted_sock<unix_stream>> source_socks;
+    ASSERT_TRUE(source.start(
+            "@protei.test.migrate"
+            , 0
+            , 5
+            , [&source_socks](accepted_sock<unix_stream>&& sock) { source_socks.push_back(std::move(sock)); }
+            , [](int){}));
+    std::vector<int> erased;
+    ASSERT_TRUE(destination.start(
+            "@protei.test.migrate.dst"
+            , 0
+            , 5
+            , [](accepted_sock<unix_stream>&&){}
+            , [&erased](int fd) { erased.push_back(fd); }));
+
+    client_t<unix_stream, epoll_t> client1{epoll_t{5, 10u}, local{}};
+    client_t<unix_stream, epoll_t> client2{epoll_t{5, 10u}, local{}};
+    for (auto* client: {&client1, &client2})
+    {
+        ASSERT_TRUE(client->start());
+        ASSERT_TRUE(client->connect("@protei.test.migrate", 0, [](){}, [](){}, [](){}));
+    }
+    source.proceed(std::chrono::milliseconds{50});
+    ASSERT_EQ(source_socks.size(), 2u);
+    EXPECT_EQ(source.load(), 2u);
+
+    // data arriving while connection migrates must not be lost
+    std::string ping{"ping"};
+    ASSERT_TRUE(client1.send(ping.data(), ping.size()));
+
+    // idle destination is blocked in proceed, attach must wake it up
+    std::string pending{"pending"};
+    std::optional<accepted_sock<unix_stream>> migrated;
+    std::string migrated_pending;
+    auto started = std::chrono::steady_clock::now();
+    std::thread destination_reactor{[&destination]() { destination.proceed(std::chrono::seconds{10}); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    std::vector<server*> reactors{&source, &destination};
+    ASSERT_TRUE(migrate(
+            reactors
+            , 0
+            , source_socks.front()
+            , [&, pending](accepted_sock<unix_stream>&& sock)
+            {
+                migrated.emplace(std::move(sock));
+                migrated_pending = pending;
+            }));
+    source_socks.erase(source_socks.begin());
+    EXPECT_EQ(source.load(), 1u);
+    EXPECT_EQ(destination.load(), 1u);
+    // loads are equal now
+    EXPECT_FALSE(migrate(reactors, 0, source_socks.front(), nullptr));
+
+    destination_reactor.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds{5});
+    ASSERT_TRUE(migrated);
+    EXPECT_EQ(migrated_pending, pending);
+
+    std::string buff(16, '\0');
+    auto rec = migrated->recv(buff.data(), buff.size());
+    ASSERT_TRUE(rec);
+    EXPECT_EQ(buff.substr(0, rec->second), ping);
+
+    // termination is reported by destination
+    int fd = migrated->native_handle();
+    client1.stop();
+    destination.proceed(std::chrono::milliseconds{50});
+    ASSERT_FALSE(erased.empty());
+    EXPECT_EQ(erased.front(), fd);
+    EXPECT_EQ(destination.load(), 0u);
+}
@@ -0,0 +1,54 @@
+#include <buffer/buffer_pool.h>
+
+#include <gtest/gtest.h>
+
+using namespace protei::buffer;
+
+TEST(buffer_pool, sizeClasses)
+{
+    buffer_pool pool{4096};
+    auto small = pool.acquire(1);
+    auto exact = pool.acquire(512);
+    auto large = pool.acquire(1000);
+    EXPECT_EQ(small.size(), buffer_pool::MIN_BUFFER_SIZE);
+    EXPECT_EQ(exact.size(), 512u);
+    EXPECT_EQ(large.size(), 1024u);
+    EXPECT_FALSE(pool.acquire(buffer_pool::MAX_BUFFER_SIZE + 1));
+
+    // buffers larger than slab are allocated one by one
+    auto huge = pool.acquire(buffer_pool::MAX_BUFFER_SIZE);
+    ASSERT_TRUE(huge);
+    EXPECT_EQ(pool.stats().allocated_bytes, 3 * 4096u + buffer_pool::MAX_BUFFER_SIZE);
+}
+
+
+TEST(buffer_pool, reuseAndHighWater)
+{
+    buffer_pool pool{1024};
+    char* first_data = nullptr;
+    {
+        auto first = pool.acquire(256);
+        auto second = pool.acquire(256);
+        first_data = first.data();
+        EXPECT_NE(first_data, second.data());
+        EXPECT_EQ(pool.stats().in_use, 2u);
+        EXPECT_EQ(pool.stats().in_use_bytes, 512u);
+
+        auto moved = std::move(first);
+        EXPECT_FALSE(first);
+        EXPECT_EQ(pool.stats().in_use, 2u);
+    }
+    EXPECT_EQ(pool.stats().in_use, 0u);
+    EXPECT_EQ(pool.stats().in_use_bytes, 0u);
+    EXPECT_EQ(pool.stats().high_water, 2u);
+    EXPECT_EQ(pool.stats().high_water_bytes, 512u);
+
+    // released buffers are reused without allocation
+    auto again = pool.acquire(200);
+    auto other = pool.acquire(200);
+    EXPECT_TRUE(again.data() == first_data || other.data() == first_data);
+    EXPECT_EQ(pool.stats().allocated_bytes, 1024u);
+    again.release();
+    EXPECT_FALSE(again);
+    EXPECT_EQ(pool.stats().in_use, 1u);
+}
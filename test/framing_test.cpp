@@ -0,0 +1,175 @@
+#include <framing/framer.h>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <deque>
+#include <vector>
+
+using namespace protei::framing;
+
+namespace
+{
+
+/**
+ * @brief Stream socket stub with given arrived segments. Like kernel stream buffer, recv returns all arrived data
+ * fitting buffer, so short read means drained socket
+ */
+struct segmented_stream
+{
+    std::optional<std::pair<int, std::size_t>> recv(void* buffer, std::size_t n)
+    {
+        if (segments.empty())
+        {
+            return std::nullopt;
+        }
+
+        std::size_t received = 0;
+        while (received < n && !segments.empty())
+        {
+            auto& front = segments.front();
+            auto size = std::min(n - received, front.size());
+            std::memcpy(static_cast<char*>(buffer) + received, front.data(), size);
+            received += size;
+            front.erase(0, size);
+            if (front.empty())
+            {
+                segments.pop_front();
+            }
+        }
+        return std::pair{0, received};
+    }
+
+    std::optional<std::size_t> send(void* buffer, std::size_t n)
+    {
+        sent.append(static_cast<char const*>(buffer), n);
+        return n;
+    }
+
+    std::deque<std::string> segments;
+    std::string sent;
+};
+
+}
+
+TEST(ring_buffer, wrap)
+{
+    ring_buffer ring{6};
+    EXPECT_EQ(ring.capacity(), 8u);
+    auto [buffer, n] = ring.write_area();
+    ASSERT_EQ(n, 8u);
+    std::memcpy(buffer, "abcdef", 6);
+    ring.commit(6);
+    ring.consume(4);
+
+    // free space is split: 2 bytes at the end and 4 at the beginning
+    std::tie(buffer, n) = ring.write_area();
+    ASSERT_EQ(n, 2u);
+    std::memcpy(buffer, "gh", 2);
+    ring.commit(2);
+    std::tie(buffer, n) = ring.write_area();
+    ASSERT_EQ(n, 4u);
+    std::memcpy(buffer, "ij", 2);
+    ring.commit(2);
+
+    std::string scratch;
+    EXPECT_EQ(ring.view(0, 4, scratch), "efgh");
+    EXPECT_TRUE(scratch.empty());
+    EXPECT_EQ(ring.view(1, 5, scratch), "fghij");
+    EXPECT_EQ(scratch, "fghij");
+    EXPECT_EQ(ring.at(5), 'j');
+    auto [first, second] = ring.readable();
+    EXPECT_EQ(first, "efgh");
+    EXPECT_EQ(second, "ij");
+}
+
+
+TEST(framer, lengthPrefixSegmented)
+{
+    for (auto prefix: {length_prefix_codec::prefix_t::U16, length_prefix_codec::prefix_t::VARINT})
+    {
+        framer_t<length_prefix_codec> framer{length_prefix_codec{prefix, 1024}, 256};
+        segmented_stream stream;
+        std::string payload(200, 'x');
+        ASSERT_TRUE(framer.write(stream, "hello"));
+        ASSERT_TRUE(framer.write(stream, payload));
+        ASSERT_TRUE(framer.write(stream, ""));
+        ASSERT_TRUE(framer.write(stream, payload));
+
+        // segments split headers and make frames wrap the ring
+        std::vector<std::string> frames;
+        auto handler = [&frames](std::string_view frame) { frames.emplace_back(frame); };
+        for (std::size_t i = 0; i < stream.sent.size(); i += 7)
+        {
+            stream.segments.emplace_back(stream.sent.substr(i, 7));
+            ASSERT_TRUE(framer.read(stream, handler));
+        }
+        EXPECT_EQ(frames, (std::vector<std::string>{"hello", payload, "", payload}));
+        EXPECT_EQ(framer.pending(), 0u);
+    }
+}
+
+
+TEST(framer, lengthPrefixMalformed)
+{
+    framer_t<length_prefix_codec> framer{length_prefix_codec{length_prefix_codec::prefix_t::U8, 16}, 64};
+    segmented_stream stream;
+    EXPECT_FALSE(framer.write(stream, std::string(256, 'x')));
+    stream.segments.emplace_back("\x20", 1);
+    EXPECT_FALSE(framer.read(stream, [](std::string_view) {}));
+
+    framer_t<length_prefix_codec> varint{length_prefix_codec{length_prefix_codec::prefix_t::VARINT, 1 << 20}, 64};
+    stream.segments.emplace_back(std::string(11, '\x80'));
+    EXPECT_FALSE(varint.read(stream, [](std::string_view) {}));
+}
+
+
+TEST(framer, delimiter)
+{
+    framer_t<delimiter_codec> framer{delimiter_codec{'\n', 16}, 16};
+    segmented_stream stream;
+    stream.segments = {"first\nsec", "ond\n", "\nthird", "\n"};
+    std::vector<std::string> frames;
+    auto handler = [&frames](std::string_view frame) { frames.emplace_back(frame); };
+    EXPECT_EQ(framer.read(stream, handler), 4u);
+    EXPECT_EQ(frames, (std::vector<std::string>{"first", "second", "", "third"}));
+
+    ASSERT_TRUE(framer.write(stream, "reply"));
+    EXPECT_EQ(stream.sent, "reply\n");
+
+    stream.segments = {std::string(17, 'x')};
+    EXPECT_FALSE(framer.read(stream, handler));
+}
+
+
+TEST(framer, borrowsRingFromPool)
+{
+    protei::buffer::buffer_pool pool;
+    std::vector<framer_t<length_prefix_codec>> connections;
+    for (int i = 0; i < 100; ++i)
+    {
+        connections.emplace_back(length_prefix_codec{length_prefix_codec::prefix_t::U8, 255}, pool, 1024);
+    }
+    EXPECT_EQ(pool.stats().allocated_bytes, 0u);
+
+    std::vector<std::string> frames;
+    auto handler = [&frames](std::string_view frame) { frames.emplace_back(frame); };
+    segmented_stream stream;
+    auto& framer = connections.front();
+
+    // idle connection doesn't hold buffer
+    EXPECT_EQ(framer.read(stream, handler), 0u);
+    EXPECT_EQ(pool.stats().in_use, 0u);
+
+    // partial frame keeps buffer borrowed
+    stream.segments = {std::string{"\x05hel"}};
+    EXPECT_EQ(framer.read(stream, handler), 0u);
+    EXPECT_EQ(pool.stats().in_use, 1u);
+    EXPECT_EQ(pool.stats().in_use_bytes, 1024u);
+
+    stream.segments = {std::string{"lo"}};
+    EXPECT_EQ(framer.read(stream, handler), 1u);
+    EXPECT_EQ(frames, std::vector<std::string>{"hello"});
+    EXPECT_EQ(pool.stats().in_use, 0u);
+    EXPECT_EQ(pool.stats().high_water, 1u);
+}
@@ -0,0 +1,103 @@
+#include <endpoint/server.h>
+#include <endpoint/client.h>
+#include <epoll/epoll.h>
+#include <socket/af_inet.h>
+#include <socket/af_unix.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::endpoint;
+
+TEST(handoff, hotRestart)
+{
+    std::vector<accepted_sock<unix_stream>> old_accepted;
+    server_t<unix_stream, epoll_t> old_server{epoll_t{5, 10u}, local{}};
+    ASSERT_TRUE(old_server.start(
+            "@protei.test.restart"
+            , 0
+            , 5
+            , [&old_accepted](accepted_sock<unix_stream>&& sock) { old_accepted.push_back(std::move(sock)); }
+            , [&old_accepted](int fd)
+            {
+                old_accepted.erase(
+                        std::remove_if(old_accepted.begin(), old_accepted.end()
+                                , [fd](auto const& sock) { return sock.native_handle() == fd; })
+                        , old_accepted.end());
+            }));
+
+    client_t<unix_stream, epoll_t> client1{epoll_t{5, 10u}, local{}};
+    ASSERT_TRUE(client1.start());
+    ASSERT_TRUE(client1.connect("@protei.test.restart", 0, [](){}, [](){}, [](){}));
+    old_server.proceed(std::chrono::milliseconds{50});
+    ASSERT_EQ(old_accepted.size(), 1u);
+
+    // new process is emulated by thread
+    std::vector<accepted_sock<unix_stream>> new_accepted;
+    server_t<unix_stream, epoll_t> new_server{epoll_t{5, 10u}, local{}};
+    bool adopted = false;
+    std::thread new_process{[&]()
+    {
+        adopted = new_server.adopt(
+                "@protei.test.handoff"
+                , std::chrono::milliseconds{1000}
+                , 5
+                , [&new_accepted](accepted_sock<unix_stream>&& sock) { new_accepted.push_back(std::move(sock)); }
+                , [](int){});
+    }};
+    EXPECT_TRUE(old_server.handoff(
+            "@protei.test.handoff"
+            , {old_accepted.front().native_handle()}
+            , std::chrono::milliseconds{1000}));
+    new_process.join();
+    ASSERT_TRUE(adopted);
+    EXPECT_TRUE(old_accepted.empty());
+    ASSERT_EQ(new_accepted.size(), 1u);
+
+    // handed off connection is served by new server
+    std::string ping{"ping"};
+    ASSERT_TRUE(client1.send(ping.data(), ping.size()));
+    std::string buff(16, '\0');
+    std::optional<std::pair<unix_address_t, std::size_t>> rec;
+    for (int i = 0; i < 10 && !rec; ++i)
+    {
+        new_server.proceed(std::chrono::milliseconds{10});
+        rec = new_accepted.front().recv(buff.data(), buff.size());
+    }
+    ASSERT_TRUE(rec);
+    EXPECT_EQ(buff.substr(0, rec->second), ping);
+
+    // and new connections are accepted by new server only
+    client_t<unix_stream, epoll_t> client2{epoll_t{5, 10u}, local{}};
+    ASSERT_TRUE(client2.start());
+    ASSERT_TRUE(client2.connect("@protei.test.restart", 0, [](){}, [](){}, [](){}));
+    old_server.proceed(std::chrono::milliseconds{10});
+    new_server.proceed(std::chrono::milliseconds{50});
+    EXPECT_EQ(new_accepted.size(), 2u);
+}
+
+
+TEST(handoff, noReceiver)
+{
+    server_t<tcp, epoll_t> server{epoll_t{5, 10u}, ipv4{}};
+    ASSERT_TRUE(server.start("127.0.0.1", 7896, 5, [](accepted_sock<tcp>&&){}, [](int){}));
+    EXPECT_FALSE(server.handoff("@protei.test.handoff.none", {}, std::chrono::milliseconds{30}));
+
+    // server keeps listening on failed handoff
+    client_t<tcp, epoll_t> client{epoll_t{5, 10u}, ipv4{}};
+    ASSERT_TRUE(client.start());
+    EXPECT_TRUE(client.connect("127.0.0.1", 7896, [](){}, [](){}, [](){}));
+
+    server_t<tcp, epoll_t> successor{epoll_t{5, 10u}, ipv4{}};
+    EXPECT_FALSE(successor.adopt(
+            "@protei.test.handoff.none"
+            , std::chrono::milliseconds{30}
+            , 5
+            , [](accepted_sock<tcp>&&){}
+            , [](int){}));
+}
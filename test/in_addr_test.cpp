@@ -1,4 +1,5 @@
 #include <socket/in_address.h>
+#include <socket/native_address.h>
 #include <utils/to_string.h>
 #include <socket/af_inet.h>
 
@@ -74,3 +75,35 @@ TEST(in_address_t, validMappedIPv6)
     ASSERT_EQ(to_string(in_addr), erasedZeroes);
 }
 
+TEST(in_address_t, equalityAndHash)
+{
+    in_address_port_t lhs{in_address_t{"192.168.0.1"}, 80};
+    in_address_port_t rhs{in_address_t{"192.168.0.1"}, 80};
+    EXPECT_EQ(lhs, rhs);
+    EXPECT_EQ(in_address_port_hash{}(lhs), in_address_port_hash{}(rhs));
+    EXPECT_NE(lhs, (in_address_port_t{in_address_t{"192.168.0.1"}, 81}));
+    EXPECT_NE(lhs, (in_address_port_t{in_address_t{"192.168.0.2"}, 80}));
+    EXPECT_NE(lhs, (in_address_port_t{in_address_t{"::ffff:192.168.0.1"}, 80}));
+    EXPECT_NE(in_address_port_hash{}(lhs), in_address_port_hash{}({in_address_t{"192.168.0.1"}, 81}));
+}
+
+TEST(native_address_t, roundTrip)
+{
+    in_address_port_t addr4{in_address_t{"192.168.0.1"}, 8080};
+    in_address_port_t addr6{in_address_t{"ff06::c3"}, 443};
+    native_address_t native4{addr4};
+    native_address_t native6{addr6};
+
+    EXPECT_EQ(native4.family(), static_cast<int>(ipv4{}));
+    EXPECT_EQ(native6.family(), static_cast<int>(ipv6{}));
+    EXPECT_EQ(native4.port(), 8080u);
+    EXPECT_EQ(native4.to_in_address_port().value(), addr4);
+    EXPECT_EQ(native6.to_in_address_port().value(), addr6);
+    EXPECT_EQ(to_string(native6), "ff06::c3:443");
+
+    EXPECT_EQ(native4, native_address_t{addr4});
+    EXPECT_NE(native4, native6);
+    EXPECT_EQ(native_address_t::hash{}(native4), native_address_t::hash{}(native_address_t{addr4}));
+    EXPECT_TRUE(native_address_t{}.empty());
+    EXPECT_FALSE(native_address_t{}.to_in_address_port());
+}
@@ -0,0 +1,129 @@
+#include <buffer/iobuf.h>
+#include <socket/socket.h>
+#include <socket/unix_address.h>
+
+#include <gtest/gtest.h>
+
+#include <sys/socket.h>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::buffer;
+
+namespace
+{
+
+std::string to_string(iobuf const& buf)
+{
+    std::string ret(buf.size(), '\0');
+    buf.copy_to(ret.data());
+    return ret;
+}
+
+}
+
+TEST(block_pool, reuse)
+{
+    block_pool pool{64, 4};
+    auto* first = pool.acquire();
+    EXPECT_EQ(pool.allocated(), 4u);
+    EXPECT_EQ(pool.available(), 3u);
+
+    block_pool::retain(first);
+    block_pool::release(first);
+    EXPECT_EQ(pool.available(), 3u);
+    block_pool::release(first);
+    EXPECT_EQ(pool.available(), 4u);
+    EXPECT_EQ(pool.acquire(), first);
+    block_pool::release(first);
+}
+
+
+TEST(iobuf, shareBlocks)
+{
+    block_pool pool{16, 8};
+    {
+        iobuf payload{pool};
+        payload.append("0123456789", 10);
+        payload.append("abcdefghij", 10);
+        EXPECT_EQ(payload.segments(), 2u);
+        EXPECT_EQ(to_string(payload), "0123456789abcdefghij");
+
+        // slice and copies share blocks
+        auto slice = payload.slice(5, 10);
+        EXPECT_EQ(to_string(slice), "56789abcde");
+        auto copy = payload;
+        EXPECT_EQ(pool.allocated() - pool.available(), 2u);
+
+        // shared block isn't written by append
+        copy.append("!", 1);
+        EXPECT_EQ(to_string(payload), "0123456789abcdefghij");
+        EXPECT_EQ(to_string(copy), "0123456789abcdefghij!");
+
+        iobuf message{pool};
+        message.append(payload);
+        message.prepend("hdr:", 4);
+        EXPECT_EQ(to_string(message), "hdr:0123456789abcdefghij");
+
+        message.consume(6);
+        EXPECT_EQ(to_string(message), "23456789abcdefghij");
+        EXPECT_EQ(message.size(), 18u);
+        message.consume(100);
+        EXPECT_TRUE(message.empty());
+    }
+    EXPECT_EQ(pool.available(), pool.allocated());
+}
+
+
+TEST(iobuf, fanOut)
+{
+    block_pool pool{8, 16};
+    iobuf payload{pool};
+    payload.append("broadcast payload", 17);
+
+    std::vector<std::pair<active_socket_t<unix_stream>, active_socket_t<unix_stream>>> subscribers;
+    for (int i = 0; i < 3; ++i)
+    {
+        int fds[2];
+        ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+        subscribers.emplace_back(*active_socket_t<unix_stream>::adopt(fds[0]), *active_socket_t<unix_stream>::adopt(fds[1]));
+    }
+
+    for (auto& [sender, receiver]: subscribers)
+    {
+        iobuf message{pool};
+        char header = static_cast<char>('0' + receiver.native_handle() % 10);
+        message.append(payload);
+        message.prepend(&header, 1);
+        ASSERT_EQ(sender.send(message, 0), 18u);
+
+        std::string buff(32, '\0');
+        auto rec = receiver.receive(buff.data(), buff.size(), 0);
+        ASSERT_TRUE(rec);
+        EXPECT_EQ(buff.substr(0, *rec), header + std::string{"broadcast payload"});
+    }
+    // only payload blocks are in use
+    EXPECT_EQ(pool.allocated() - pool.available(), payload.segments());
+}
+
+
+TEST(iobuf, datagramGather)
+{
+    block_pool pool{4, 4};
+    iobuf message{pool};
+    message.append("one datagram", 12);
+    ASSERT_EQ(message.segments(), 3u);
+
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_DGRAM, 0, fds), 0);
+    auto sender = active_socket_t<unix_dgram>::adopt(fds[0]);
+    auto receiver = active_socket_t<unix_dgram>::adopt(fds[1]);
+    ASSERT_TRUE(sender && receiver);
+
+    // segments are sent as single datagram
+    ASSERT_EQ(sender->send(message, 0), 12u);
+    std::string buff(32, '\0');
+    auto rec = receiver->receive(buff.data(), buff.size(), 0);
+    ASSERT_TRUE(rec);
+    EXPECT_EQ(buff.substr(0, rec->second), "one datagram");
+}
@@ -0,0 +1,168 @@
+#include <metrics/histogram.h>
+#include <endpoint/server.h>
+#include <endpoint/client.h>
+#include <epoll/epoll.h>
+#include <socket/af_inet.h>
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::endpoint;
+using protei::metrics::disconnect_t;
+using protei::metrics::log_linear;
+
+namespace
+{
+
+/**
+ * @brief Connected tcp server and client on loopback
+ */
+struct tcp_pair
+{
+    explicit tcp_pair(std::uint_fast16_t port)
+    {
+        auto listener = utils::mbind(
+                socket_t<tcp>::create(ipv4{})
+                , [port](socket_t<tcp>&& sock)
+                {
+                    sock.set_reuse_address(true);
+                    return sock.bind(in_address_port_t{in_address_t{"127.0.0.1"}, port});
+                }
+                , [](binded_socket_t<tcp>&& sock) { return sock.listen(4); });
+        if (!listener
+            || !server.start(
+                    ::dup(listener->native_handle())
+                    , 4
+                    , [this](accepted_sock<tcp>&& sock) { accepted.emplace(std::move(sock)); }
+                    , [this](int) { ++erased; })
+            || !client.start()
+            || !client.connect("127.0.0.1", port, [](){}, [](){}, [](){}))
+        {
+            return;
+        }
+        for (int i = 0; i < 10 && !accepted; ++i)
+        {
+            server.proceed(std::chrono::milliseconds{10});
+        }
+    }
+
+    server_t<tcp, epoll_t> server{epoll_t{5, 10u}, ipv4{}};
+    client_t<tcp, epoll_t> client{epoll_t{5, 10u}, ipv4{}};
+    std::optional<accepted_sock<tcp>> accepted;
+    int erased = 0;
+};
+
+}
+
+TEST(histogram, logLinearBuckets)
+{
+    for (std::uint64_t value = 0; value < log_linear::SUB_BUCKETS; ++value)
+    {
+        EXPECT_EQ(log_linear::bucket(value), value);
+    }
+    for (std::uint64_t value: {8ull, 9ull, 100ull, 1000ull, 123456ull, 1ull << 30, (1ull << 30) + 12345})
+    {
+        auto bucket = log_linear::bucket(value);
+        EXPECT_LE(log_linear::lower_bound(bucket), value);
+        EXPECT_GE(log_linear::upper_bound(bucket), value);
+        EXPECT_LE(log_linear::upper_bound(bucket) - log_linear::lower_bound(bucket), value / log_linear::SUB_BUCKETS);
+        EXPECT_EQ(log_linear::lower_bound(bucket + 1), log_linear::upper_bound(bucket) + 1);
+    }
+    EXPECT_EQ(log_linear::bucket(~0ull), log_linear::BUCKETS - 1);
+}
+
+
+TEST(histogram, percentiles)
+{
+    metrics::histogram hist;
+    for (std::uint64_t value = 1; value <= 1000; ++value)
+    {
+        hist.record(value);
+    }
+
+    auto snapshot = hist.snapshot();
+    EXPECT_EQ(snapshot.count, 1000u);
+    EXPECT_EQ(snapshot.max, 1000u);
+    EXPECT_DOUBLE_EQ(snapshot.mean(), 500.5);
+    EXPECT_GE(snapshot.percentile(0.5), 500u);
+    EXPECT_LE(snapshot.percentile(0.5), 500u + 500u / log_linear::SUB_BUCKETS);
+    EXPECT_GE(snapshot.percentile(0.99), 990u);
+    EXPECT_EQ(snapshot.percentile(1.), 1000u);
+    EXPECT_EQ(metrics::histogram{}.snapshot().percentile(0.5), 0u);
+}
+
+
+TEST(metrics, tcpTrafficAndLoop)
+{
+    if (!metrics::enabled)
+    {
+        GTEST_SKIP();
+    }
+    tcp_pair pair{7916};
+    ASSERT_TRUE(pair.accepted);
+
+    char request[] = "request";
+    char buff[64];
+    ASSERT_EQ(pair.client.send(request, sizeof(request)), sizeof(request));
+    ASSERT_TRUE(pair.server.proceed(std::chrono::milliseconds{100}));
+    auto rec = pair.accepted->recv(buff, sizeof(buff));
+    ASSERT_TRUE(rec);
+    EXPECT_FALSE(pair.accepted->recv(buff, sizeof(buff)));
+    ASSERT_EQ(pair.accepted->send(buff, rec->second), sizeof(request));
+    ASSERT_TRUE(pair.client.proceed(std::chrono::milliseconds{100}));
+    ASSERT_TRUE(pair.client.recv(buff, sizeof(buff)));
+
+    auto server = pair.server.metrics();
+    EXPECT_EQ(server.accepts, 1u);
+    EXPECT_EQ(server.messages_in, 1u);
+    EXPECT_EQ(server.bytes_in, sizeof(request));
+    EXPECT_EQ(server.messages_out, 1u);
+    EXPECT_EQ(server.bytes_out, sizeof(request));
+    EXPECT_EQ(server.eagain, 1u);
+    EXPECT_GE(server.proceeds, 2u);
+    EXPECT_EQ(server.events_per_proceed.count, server.proceeds);
+    EXPECT_EQ(server.events_per_proceed.sum, server.events);
+    EXPECT_EQ(server.handler_ns.count, server.events);
+    EXPECT_EQ(server.loop_lag_ns.count, server.proceeds - 1);
+
+    auto client = pair.client.metrics();
+    EXPECT_EQ(client.accepts, 0u);
+    EXPECT_EQ(client.messages_out, 1u);
+    EXPECT_EQ(client.messages_in, 1u);
+    EXPECT_EQ(client.bytes_in, sizeof(request));
+    EXPECT_EQ(client.eagain, 0u);
+}
+
+
+TEST(metrics, disconnectReason)
+{
+    if (!metrics::enabled)
+    {
+        GTEST_SKIP();
+    }
+    tcp_pair pair{7917};
+    ASSERT_TRUE(pair.accepted);
+    pair.client.stop();
+    for (int i = 0; i < 10 && pair.erased == 0; ++i)
+    {
+        pair.server.proceed(std::chrono::milliseconds{10});
+    }
+    ASSERT_EQ(pair.erased, 1);
+    char byte;
+    auto eof = pair.accepted->recv(&byte, sizeof(byte));
+    ASSERT_TRUE(eof);
+    EXPECT_EQ(eof->second, 0u);
+
+    // several termination events of one connection are counted once
+    auto snapshot = pair.server.metrics();
+    EXPECT_EQ(snapshot.disconnected(disconnect_t::PEER_CLOSED), 1u);
+    EXPECT_EQ(snapshot.disconnected(disconnect_t::HANGUP), 0u);
+    EXPECT_EQ(snapshot.disconnected(disconnect_t::ERROR), 0u);
+    // end of stream isn't a message
+    EXPECT_EQ(snapshot.messages_in, 0u);
+}
+
@@ -0,0 +1,66 @@
+#include <endpoint/multicast_receiver.h>
+#include <endpoint/client.h>
+#include <epoll/epoll.h>
+#include <socket/af_inet.h>
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::utils;
+using namespace protei::endpoint;
+
+TEST(multicast, socketOptions)
+{
+    auto sock = socket_t<udp>::create(ipv4{});
+    ASSERT_TRUE(sock);
+    EXPECT_TRUE(sock->set_multicast_loop(true));
+    EXPECT_TRUE(sock->set_multicast_ttl(2));
+    EXPECT_TRUE(sock->set_multicast_interface(in_address_t{"127.0.0.1"}));
+    EXPECT_TRUE(sock->join_group(in_address_t{"239.255.0.3"}, in_address_t{"127.0.0.1"}));
+    EXPECT_FALSE(sock->join_group(in_address_t{"ff02::1"}));
+    EXPECT_TRUE(sock->leave_group(in_address_t{"239.255.0.3"}, in_address_t{"127.0.0.1"}));
+}
+
+TEST(multicast, receiveSeveralGroupsOnLoopback)
+{
+    multicast_receiver_t<udp, epoll_t> receiver{epoll_t{5, 10u}, ipv4{}};
+    std::set<std::string> received;
+    ASSERT_TRUE(receiver.start(
+            7890
+            , {"239.255.0.1", "239.255.0.2"}
+            , "127.0.0.1"
+            , [&received](accepted_sock_ref<udp>&& sock)
+            {
+                std::string buff(16, '\0');
+                while (auto rec = sock.recv(buff.data(), buff.size()))
+                {
+                    received.insert(buff.substr(0, rec->second));
+                }
+            }
+            , [](){}));
+
+    client_t<udp, epoll_t> sender1{epoll_t{5, 10u}, ipv4{}};
+    client_t<udp, epoll_t> sender2{epoll_t{5, 10u}, ipv4{}};
+    for (auto [sender, group]: {std::pair{&sender1, "239.255.0.1"}, std::pair{&sender2, "239.255.0.2"}})
+    {
+        ASSERT_TRUE(sender->start());
+        ASSERT_TRUE(sender->set_multicast(1, true, "127.0.0.1"));
+        ASSERT_TRUE(sender->connect(group, 7890, [](){}, [](){}, [](){}));
+        std::string tick = group;
+        ASSERT_TRUE(sender->send(tick.data(), tick.size()));
+    }
+
+    receiver.proceed(std::chrono::milliseconds{50});
+    EXPECT_EQ(received, (std::set<std::string>{"239.255.0.1", "239.255.0.2"}));
+
+    ASSERT_TRUE(receiver.leave_group("239.255.0.2", "127.0.0.1"));
+    received.clear();
+    std::string tick{"after leave"};
+    ASSERT_TRUE(sender2.send(tick.data(), tick.size()));
+    receiver.proceed(std::chrono::milliseconds{50});
+    EXPECT_TRUE(received.empty());
+}
@@ -0,0 +1,92 @@
+#include <endpoint/prefork.h>
+#include <endpoint/server.h>
+#include <endpoint/client.h>
+#include <epoll/epoll.h>
+#include <socket/af_inet.h>
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::utils;
+using namespace protei::endpoint;
+
+TEST(epoll_t, addExclusive)
+{
+    epoll_t first{5, 10u};
+    epoll_t second{5, 10u};
+    auto sock = mbind(
+            socket_t<tcp>::create(ipv4{})
+            , [](socket_t<tcp>&& created) { return created.bind(in_address_port_t{in_address_t{"127.0.0.1"}, 0}); }
+            , [](binded_socket_t<tcp>&& binded) { return binded.listen(5); });
+    ASSERT_TRUE(sock);
+    EXPECT_TRUE(first.add_socket(sock->native_handle(), sock_op::READ, true));
+    EXPECT_TRUE(second.add_socket(sock->native_handle(), sock_op::READ, true));
+    // exclusive registration can't be modified
+    EXPECT_FALSE(first.mod_socket(sock->native_handle(), sock_op::READ_WRITE));
+}
+
+
+TEST(prefork, workersShareListener)
+{
+    auto listener = mbind(
+            socket_t<tcp>::create(ipv4{})
+            , [](socket_t<tcp>&& sock)
+            {
+                sock.set_reuse_address(true);
+                return sock.bind(in_address_port_t{in_address_t{"127.0.0.1"}, 7897});
+            }
+            , [](binded_socket_t<tcp>&& sock) { return sock.listen(16); });
+    ASSERT_TRUE(listener);
+
+    // each worker answers with its index and serves until killed
+    auto workers = prefork_t::start(listener->native_handle(), 2, [](int fd, unsigned index)
+    {
+        server_t<tcp, epoll_t> server{epoll_t{5, 10u}, ipv4{}};
+        std::vector<accepted_sock<tcp>> accepted;
+        bool started = server.start(
+                fd
+                , 16
+                , [&accepted, index](accepted_sock<tcp>&& sock)
+                {
+                    char answer = static_cast<char>('0' + index);
+                    sock.send(&answer, sizeof(answer));
+                    accepted.push_back(std::move(sock));
+                }
+                , [](int){}
+                , true);
+        while (started)
+        {
+            server.proceed(std::chrono::milliseconds{100});
+        }
+        return 1;
+    });
+    ASSERT_TRUE(workers);
+    EXPECT_EQ(workers->workers().size(), 2u);
+
+    std::set<char> answered;
+    for (int i = 0; i < 8; ++i)
+    {
+        client_t<tcp, epoll_t> client{epoll_t{5, 10u}, ipv4{}};
+        ASSERT_TRUE(client.start());
+        ASSERT_TRUE(client.connect("127.0.0.1", 7897, [](){}, [](){}, [](){}));
+        char answer = 0;
+        std::optional<std::pair<in_address_port_t, std::size_t>> rec;
+        for (int tries = 0; tries < 100 && !rec; ++tries)
+        {
+            client.proceed(std::chrono::milliseconds{10});
+            rec = client.recv(&answer, sizeof(answer));
+        }
+        ASSERT_TRUE(rec);
+        answered.insert(answer);
+    }
+    EXPECT_FALSE(answered.empty());
+    EXPECT_TRUE(std::all_of(answered.begin(), answered.end(), [](char c) { return c == '0' || c == '1'; }));
+
+    EXPECT_TRUE(workers->stop());
+    EXPECT_FALSE(workers->wait());
+    EXPECT_TRUE(workers->workers().empty());
+}
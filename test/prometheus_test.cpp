@@ -0,0 +1,114 @@
+#include "alloc_counter.h"
+
+#include <endpoint/prometheus_exporter.h>
+#include <endpoint/client.h>
+#include <socket/af_inet.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::endpoint;
+
+namespace
+{
+
+/**
+ * @brief Exporter with one exported server and scraper connected to it
+ */
+struct scrape_env
+{
+    explicit scrape_env(std::uint_fast16_t port)
+    {
+        exporter.add("main", server);
+        if (!exporter.start("127.0.0.1", port)
+            || !scraper.start()
+            || !scraper.connect("127.0.0.1", port, [](){}, [this]() { read_ready = true; }, [](){}))
+        {
+            return;
+        }
+        for (int i = 0; i < 10; ++i)
+        {
+            exporter.proceed(std::chrono::milliseconds{10});
+        }
+        started = true;
+    }
+
+    /**
+     * @brief Send request and proceed exporter until response is received
+     * @param request - HTTP request
+     * @param response - buffer response is received to
+     * @return received response size
+     */
+    std::size_t scrape(std::string_view request, std::string& response)
+    {
+        read_ready = false;
+        if (scraper.send(const_cast<char*>(request.data()), request.size()) != request.size())
+        {
+            return 0;
+        }
+        for (int i = 0; i < 10 && !read_ready; ++i)
+        {
+            exporter.proceed(std::chrono::milliseconds{10});
+            scraper.proceed(std::chrono::milliseconds{10});
+        }
+        auto rec = scraper.recv(response.data(), response.size());
+        return rec ? rec->second : 0;
+    }
+
+    server_t<tcp, epoll_t> server{epoll_t{5, 10u}, ipv4{}};
+    prometheus_exporter exporter;
+    client_t<tcp, epoll_t> scraper{epoll_t{5, 10u}, ipv4{}};
+    bool read_ready = false;
+    bool started = false;
+};
+
+}
+
+TEST(prometheus_exporter, servesMetrics)
+{
+    scrape_env env{7919};
+    ASSERT_TRUE(env.started);
+
+    std::string buff(64 * 1024, '\0');
+    auto size = env.scrape("GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n", buff);
+    std::string_view response{buff.data(), size};
+    ASSERT_EQ(response.substr(0, 17), "HTTP/1.1 200 OK\r\n");
+    auto body = response.substr(response.find("\r\n\r\n") + 4);
+    EXPECT_NE(response.find("Content-Length: " + std::to_string(body.size()) + "\r\n"), std::string_view::npos);
+    EXPECT_NE(body.find("# TYPE transport_accepts_total counter\n"), std::string_view::npos);
+    EXPECT_NE(body.find("transport_accepts_total{endpoint=\"main\"} 0\n"), std::string_view::npos);
+    EXPECT_NE(body.find("transport_disconnects_total{endpoint=\"main\",reason=\"peer_closed\"} 0\n"),
+              std::string_view::npos);
+    EXPECT_NE(body.find("transport_bytes_in_total{endpoint=\"main\"}"), std::string_view::npos);
+    EXPECT_NE(body.find("transport_events_per_proceed_bucket{endpoint=\"main\",le=\"+Inf\"}"),
+              std::string_view::npos);
+    EXPECT_NE(body.find("transport_handler_seconds{endpoint=\"main\",quantile=\"0.99\"}"), std::string_view::npos);
+
+    // keep-alive connection serves next requests
+    size = env.scrape("GET /other HTTP/1.1\r\n\r\n", buff);
+    EXPECT_EQ(std::string_view(buff.data(), size).substr(0, 24), "HTTP/1.1 404 Not Found\r\n");
+    size = env.scrape("POST /metrics HTTP/1.1\r\nConnection: close\r\n\r\n", buff);
+    EXPECT_EQ(std::string_view(buff.data(), size).substr(0, 24), "HTTP/1.1 405 Method Not ");
+    EXPECT_NE(std::string_view(buff.data(), size).find("Connection: close\r\n"), std::string_view::npos);
+}
+
+
+TEST(prometheus_exporter, scrapeDoesNotAllocate)
+{
+    scrape_env env{7920};
+    ASSERT_TRUE(env.started);
+
+    std::string buff(64 * 1024, '\0');
+    std::string_view const request = "GET /metrics HTTP/1.1\r\n\r\n";
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_GT(env.scrape(request, buff), 0u);
+    }
+    std::size_t size = 0;
+    EXPECT_NO_ALLOC(size = env.scrape(request, buff));
+    EXPECT_GT(size, 0u);
+}
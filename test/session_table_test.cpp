@@ -0,0 +1,123 @@
+#include <endpoint/server.h>
+#include <epoll/epoll.h>
+#include <socket/af_inet.h>
+#include <utils/flat_hash_map.h>
+#include <utils/address_from_string.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <map>
+#include <set>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::utils;
+using namespace protei::endpoint;
+
+TEST(flat_hash_map, insertFindErase)
+{
+    flat_hash_map<int, int> map{4};
+    auto slots = map.slot_count();
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_TRUE(map.try_emplace(i, i * 2).second);
+    }
+    EXPECT_GT(map.slot_count(), slots);
+    EXPECT_FALSE(map.try_emplace(5, 0).second);
+    EXPECT_EQ(map.size(), 1000u);
+
+    for (int i = 0; i < 1000; i += 2)
+    {
+        ASSERT_TRUE(map.erase(i));
+    }
+    EXPECT_FALSE(map.erase(0));
+    EXPECT_EQ(map.size(), 500u);
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto* found = map.find(i);
+        if (i % 2)
+        {
+            ASSERT_NE(found, nullptr);
+            EXPECT_EQ(*found, i * 2);
+        }
+        else
+        {
+            EXPECT_EQ(found, nullptr);
+        }
+    }
+
+    EXPECT_EQ(map.erase_if([](int key, int&) { return key < 500; }), 250u);
+    EXPECT_EQ(map.size(), 250u);
+    EXPECT_EQ(map.find(499), nullptr);
+    EXPECT_NE(map.find(501), nullptr);
+}
+
+TEST(flat_hash_map, reserveAvoidsRehash)
+{
+    flat_hash_map<in_address_port_t, int, in_address_port_hash> map{10000};
+    auto slots = map.slot_count();
+    for (std::uint_fast16_t port = 1; port <= 10000; ++port)
+    {
+        map.try_emplace(*from_string_and_port("127.0.0.1", port), port);
+    }
+    EXPECT_EQ(map.slot_count(), slots);
+    EXPECT_EQ(*map.find(*from_string_and_port("127.0.0.1", 42)), 42);
+    EXPECT_EQ(map.find(*from_string_and_port("127.0.0.2", 42)), nullptr);
+}
+
+TEST(session_table, demultiplexAndExpire)
+{
+    server_t<udp, epoll_t> server{epoll_t{5, 10u}, ipv4{}};
+    session_options options;
+    options.capacity = 16;
+    options.idle_timeout = std::chrono::milliseconds{100};
+    std::size_t created = 0;
+    std::size_t expired = 0;
+    std::map<std::uint_fast16_t, std::string> received;
+    ASSERT_TRUE(server.start(
+            "127.0.0.1"
+            , 7852
+            , options
+            , [&](udp_session<udp>& session)
+            {
+                ++created;
+                session.context = &received[session.peer().port()];
+            }
+            , [&](udp_session<udp>& session, void const* data, std::size_t size)
+            {
+                static_cast<std::string*>(session.context)->append(static_cast<char const*>(data), size);
+                std::string ack{"ack"};
+                session.send(ack.data(), ack.size());
+            }
+            , [&](udp_session<udp>&) { ++expired; }));
+    ASSERT_NE(server.sessions(), nullptr);
+
+    in_address_port_t serv_addr{*in_address_t::create("127.0.0.1"), 7852};
+    auto peer1 = mbind(socket_t<udp>::create(ipv4{}), [&](socket_t<udp>&& sock) { return sock.connect(serv_addr); });
+    auto peer2 = mbind(socket_t<udp>::create(ipv4{}), [&](socket_t<udp>&& sock) { return sock.connect(serv_addr); });
+    ASSERT_TRUE(peer1 && peer2);
+    std::string a{"a"}, b{"b"};
+    peer1->send(a.data(), a.size(), 0);
+    peer2->send(b.data(), b.size(), 0);
+    peer1->send(a.data(), a.size(), 0);
+    server.proceed(std::chrono::milliseconds{50});
+
+    EXPECT_EQ(created, 2u);
+    EXPECT_EQ(server.sessions()->size(), 2u);
+    ASSERT_EQ(received.size(), 2u);
+    std::set<std::string> payloads;
+    for (auto& [port, payload]: received) { payloads.insert(payload); }
+    EXPECT_EQ(payloads, (std::set<std::string>{"aa", "b"}));
+
+    std::string ack(8, '\0');
+    auto rec = peer1->receive(ack.data(), ack.size(), 0);
+    ASSERT_TRUE(rec);
+    EXPECT_EQ(ack.substr(0, rec->second), "ack");
+
+    std::this_thread::sleep_for(options.idle_timeout);
+    server.proceed(std::chrono::milliseconds{0});
+    EXPECT_EQ(expired, 2u);
+    EXPECT_EQ(server.sessions()->size(), 0u);
+}
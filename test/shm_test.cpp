@@ -0,0 +1,177 @@
+#include <endpoint/shm_server.h>
+#include <endpoint/shm_client.h>
+#include <epoll/epoll.h>
+
+#include <gtest/gtest.h>
+
+#include <poll.h>
+#include <unistd.h>
+
+using namespace protei;
+using namespace protei::shm;
+using namespace protei::epoll;
+using namespace protei::endpoint;
+
+TEST(spsc_ring, pushPopWrap)
+{
+    auto ring = spsc_ring::create(100);
+    ASSERT_TRUE(ring);
+    EXPECT_EQ(ring->capacity(), 128u);
+    EXPECT_TRUE(ring->empty());
+    EXPECT_FALSE(ring->pop(nullptr, 0));
+
+    std::string msg(20, 'a');
+    std::string buff(64, '\0');
+    EXPECT_EQ(ring->push(msg.data(), msg.size()), spsc_ring::push_status::NOTIFY);
+    EXPECT_EQ(ring->push(msg.data(), msg.size()), spsc_ring::push_status::PUSHED);
+    EXPECT_EQ(ring->pop(buff.data(), buff.size()), msg.size());
+    EXPECT_EQ(ring->pop(buff.data(), 4), 4u);
+    EXPECT_TRUE(ring->empty());
+
+    // 32 bytes records: 4 of them fill the ring
+    for (char c = 'b'; c < 'z'; ++c)
+    {
+        msg.assign(20, c);
+        for (int i = 0; i < 4; ++i)
+        {
+            ASSERT_NE(ring->push(msg.data(), msg.size()), spsc_ring::push_status::FULL);
+        }
+        ASSERT_EQ(ring->push(msg.data(), msg.size()), spsc_ring::push_status::FULL);
+        for (int i = 0; i < 4; ++i)
+        {
+            ASSERT_EQ(ring->pop(buff.data(), buff.size()), msg.size());
+            ASSERT_EQ(buff.substr(0, msg.size()), msg);
+        }
+    }
+
+    // 56 bytes records don't divide the ring, so tail of the ring is skipped
+    for (char c = 'b'; c < 'z'; ++c)
+    {
+        msg.assign(44, c);
+        ASSERT_EQ(ring->push(msg.data(), msg.size()), spsc_ring::push_status::NOTIFY);
+        ASSERT_EQ(ring->pop(buff.data(), buff.size()), msg.size());
+        ASSERT_EQ(buff.substr(0, msg.size()), msg);
+    }
+    EXPECT_TRUE(ring->empty());
+
+    std::string huge(200, 'x');
+    EXPECT_EQ(ring->push(huge.data(), huge.size()), spsc_ring::push_status::FULL);
+}
+
+
+TEST(spsc_ring, attach)
+{
+    auto ring = spsc_ring::create(4096);
+    ASSERT_TRUE(ring);
+    auto peer = spsc_ring::attach(::dup(ring->fd()));
+    ASSERT_TRUE(peer);
+    std::string msg{"hello"};
+    std::string buff(16, '\0');
+    ring->push(msg.data(), msg.size());
+    ASSERT_EQ(peer->pop(buff.data(), buff.size()), msg.size());
+    EXPECT_EQ(buff.substr(0, msg.size()), msg);
+    EXPECT_TRUE(ring->empty());
+}
+
+
+TEST(shm_channel, wakeProducerOnDrain)
+{
+    auto channel = shm_channel::create(128);
+    ASSERT_TRUE(channel);
+    auto fds = channel->peer_fds();
+    for (auto& fd: fds)
+    {
+        fd = ::dup(fd);
+    }
+    auto peer = shm_channel::adopt(fds.data(), fds.size());
+    ASSERT_TRUE(peer);
+    auto writable = [&channel]()
+    {
+        pollfd pfd{channel->writable_fd(), POLLIN, 0};
+        return ::poll(&pfd, 1, 0) == 1;
+    };
+
+    // 32 bytes records: 4 of them fill the ring
+    std::string msg(20, 'a');
+    std::string buff(64, '\0');
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(channel->send(msg.data(), msg.size()));
+    }
+    EXPECT_FALSE(writable());
+    EXPECT_FALSE(channel->send(msg.data(), msg.size()));
+    EXPECT_TRUE(channel->finished_send());
+    EXPECT_FALSE(writable());
+
+    // the first receive from full ring wakes producer up, the following ones don't
+    ASSERT_EQ(peer->receive(buff.data(), buff.size()), msg.size());
+    EXPECT_TRUE(writable());
+    ASSERT_TRUE(channel->send(msg.data(), msg.size()));
+    EXPECT_FALSE(channel->finished_send());
+    ASSERT_EQ(peer->receive(buff.data(), buff.size()), msg.size());
+    ASSERT_TRUE(channel->send(msg.data(), msg.size()));
+    EXPECT_FALSE(channel->send(msg.data(), msg.size()));
+    EXPECT_FALSE(writable());
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_EQ(peer->receive(buff.data(), buff.size()), msg.size());
+    }
+    EXPECT_TRUE(writable());
+    EXPECT_FALSE(peer->receive(buff.data(), buff.size()));
+}
+
+
+TEST(shm, pingPong)
+{
+    shm_server_t<epoll_t> server{epoll_t{5, 10u}, 4096};
+    std::vector<shm_accepted_sock> accepted;
+    std::vector<int> erased;
+    ASSERT_TRUE(server.start(
+            "@protei.test.shm"
+            , 5
+            , [&accepted](shm_accepted_sock&& sock) { accepted.push_back(std::move(sock)); }
+            , [&erased](int fd) { erased.push_back(fd); }));
+
+    shm_client_t<epoll_t> client{epoll_t{5, 10u}};
+    bool connected = false;
+    unsigned read_ready = 0;
+    bool disconnected = false;
+    ASSERT_TRUE(client.start());
+    ASSERT_TRUE(client.connect(
+            "@protei.test.shm"
+            , [&connected]() { connected = true; }
+            , [&read_ready]() { ++read_ready; }
+            , [&disconnected]() { disconnected = true; }));
+    server.proceed(std::chrono::milliseconds{50});
+    ASSERT_EQ(accepted.size(), 1u);
+    client.proceed(std::chrono::milliseconds{50});
+    ASSERT_TRUE(connected);
+    ASSERT_TRUE(client.connected());
+
+    std::string buff(16, '\0');
+    for (int i = 0; i < 3; ++i)
+    {
+        std::string ping = "ping" + std::to_string(i);
+        ASSERT_TRUE(client.send(ping.data(), ping.size()));
+        auto rec = accepted.front().recv(buff.data(), buff.size());
+        ASSERT_TRUE(rec);
+        EXPECT_EQ(buff.substr(0, rec->second), ping);
+        EXPECT_FALSE(accepted.front().recv(buff.data(), buff.size()));
+        EXPECT_TRUE(accepted.front().finished_recv());
+        ASSERT_TRUE(accepted.front().send(buff.data(), rec->second));
+
+        client.proceed(std::chrono::milliseconds{50});
+        rec = client.recv(buff.data(), buff.size());
+        ASSERT_TRUE(rec);
+        EXPECT_EQ(buff.substr(0, rec->second), ping);
+        EXPECT_EQ(rec->first.name(), "@protei.test.shm");
+        EXPECT_FALSE(client.recv(buff.data(), buff.size()));
+    }
+    EXPECT_EQ(read_ready, 3u);
+
+    int fd = accepted.front().native_handle();
+    client.stop();
+    server.proceed(std::chrono::milliseconds{50});
+    ASSERT_FALSE(erased.empty());
+    EXPECT_EQ(erased.front(), fd);
+}
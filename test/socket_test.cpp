@@ -4,6 +4,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <thread>
+
 using namespace protei;
 using namespace protei::sock;
 using namespace protei::utils;
@@ -74,6 +77,164 @@ void test_connect()
 }
 
 
+void test_connect_udp()
+{
+    in_address_port_t serv_addr{*in_address_t::create("127.0.0.1"), 8042};
+    in_address_port_t other_addr{*in_address_t::create("127.0.0.1"), 8043};
+    auto serv = mbind(socket_t<udp>::create(ipv4{}), [&](socket_t<udp>&& sock) { return sock.bind(serv_addr); });
+    auto other = mbind(socket_t<udp>::create(ipv4{}), [&](socket_t<udp>&& sock) { return sock.bind(other_addr); });
+    auto client = mbind(socket_t<udp>::create(ipv4{}), [&](socket_t<udp>&& sock) { return sock.connect(serv_addr); });
+    ASSERT_TRUE(serv && other && client);
+    ASSERT_EQ(to_string(client->remote().value()), to_string(serv_addr));
+
+    std::string hello{"hello"};
+    auto sent = client->send(hello.data(), hello.length(), 0);
+    ASSERT_EQ(sent.value(), hello.length());
+
+    std::string buff(16, '\0');
+    std::optional<std::pair<in_address_port_t, std::size_t>> rec;
+    int max_tries = 50;
+    while (!(rec = serv->receive(buff.data(), buff.size(), 0)) && max_tries-- > 0);
+    ASSERT_TRUE(rec.has_value());
+    EXPECT_EQ(buff.substr(0, rec->second), hello);
+
+    // datagram from foreign peer is filtered by kernel
+    std::string foreign{"foreign"};
+    ASSERT_TRUE(other->send(rec->first, foreign.data(), foreign.size(), 0));
+    ASSERT_TRUE(serv->send(rec->first, hello.data(), hello.size(), 0));
+    max_tries = 50;
+    while (!(rec = client->receive(buff.data(), buff.size(), 0)) && max_tries-- > 0);
+    ASSERT_TRUE(rec.has_value());
+    EXPECT_EQ(buff.substr(0, rec->second), hello);
+    EXPECT_EQ(to_string(rec->first), to_string(serv_addr));
+    EXPECT_FALSE(client->receive(buff.data(), buff.size(), 0));
+    EXPECT_TRUE(client->again());
+}
+
+/**
+ * @brief Read queued TX timestamps until count of them is read
+ */
+template <typename Sock>
+std::vector<tx_timestamp_t> tx_timestamps(Sock& sock, std::size_t count)
+{
+    std::vector<tx_timestamp_t> ret;
+    for (int tries = 0; tries < 100 && ret.size() < count; ++tries)
+    {
+        while (auto ts = sock.receive_tx_timestamp())
+        {
+            ret.push_back(*ts);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return ret;
+}
+
+
+void test_timestamping_udp()
+{
+    in_address_port_t serv_addr{*in_address_t::create("127.0.0.1"), 8052};
+    auto serv = mbind(socket_t<udp>::create(ipv4{}), [&](socket_t<udp>&& sock) { return sock.bind(serv_addr); });
+    auto client = mbind(socket_t<udp>::create(ipv4{}), [&](socket_t<udp>&& sock) { return sock.connect(serv_addr); });
+    ASSERT_TRUE(serv && client);
+    ASSERT_TRUE(serv->set_timestamping(true, false));
+    ASSERT_TRUE(client->set_timestamping(false, true));
+
+    // kernel switches on stamping of received packets asynchronously, first datagrams may miss it
+    auto before = std::chrono::system_clock::now();
+    std::string hello{"hello"};
+    std::string buff(16, '\0');
+    std::optional<timestamp_t> ts;
+    decltype(serv->receive_timestamped(buff.data(), buff.size(), 0, ts)) rec;
+    std::uint32_t sent = 0;
+    while (!ts && sent < 50)
+    {
+        ASSERT_TRUE(client->send(hello.data(), hello.length(), 0));
+        ++sent;
+        int max_tries = 50;
+        while (!(rec = serv->receive_timestamped(buff.data(), buff.size(), 0, ts)) && max_tries-- > 0);
+        ASSERT_TRUE(rec.has_value());
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    EXPECT_EQ(buff.substr(0, rec->second), hello);
+    EXPECT_EQ(to_string(rec->first.addr), "127.0.0.1");
+    ASSERT_TRUE(ts.has_value());
+    EXPECT_GE(*ts, before);
+    EXPECT_LE(*ts, std::chrono::system_clock::now());
+
+    // each datagram is stamped when it enters scheduler and when it is handed to loopback driver
+    auto tx = tx_timestamps(*client, 2 * sent);
+    ASSERT_EQ(tx.size(), 2 * sent);
+    for (std::uint32_t id = 0; id < sent; ++id)
+    {
+        for (auto stage: {tx_timestamp_t::stage_t::SCHEDULED, tx_timestamp_t::stage_t::SENT})
+        {
+            EXPECT_EQ(std::count_if(tx.begin(), tx.end(), [&](tx_timestamp_t const& stamp)
+            {
+                return stamp.id == id && stamp.stage == stage && stamp.time >= before;
+            }), 1);
+        }
+    }
+    EXPECT_FALSE(client->receive_tx_timestamp());
+}
+
+
+void test_timestamping_tcp()
+{
+    in_address_port_t serv_addr{*in_address_t::create("127.0.0.1"), 8054};
+    auto serv = mbind(
+            socket_t<tcp>::create(ipv4{})
+            , [&](socket_t<tcp>&& sock)
+            {
+                sock.set_reuse_address(true);
+                return sock.bind(serv_addr);
+            }
+            , [](binded_socket_t<tcp>&& sock) { return sock.listen(1); });
+    ASSERT_TRUE(serv);
+    auto client = mbind(socket_t<tcp>::create(ipv4{}), [&](socket_t<tcp>&& sock) { return sock.connect(serv_addr); });
+    ASSERT_TRUE(client);
+    decltype(serv->accept()) accepted;
+    int max_tries = 50;
+    while (!(accepted = serv->accept()) && max_tries-- > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    ASSERT_TRUE(accepted);
+    ASSERT_TRUE(accepted->set_timestamping(true, false));
+    ASSERT_TRUE(client->set_timestamping(false, true));
+
+    std::string hello{"hello"};
+    std::string buff(16, '\0');
+    std::optional<timestamp_t> ts;
+    std::uint32_t sent = 0;
+    while (!ts && sent < 50)
+    {
+        ASSERT_EQ(client->send(hello.data(), hello.length(), 0), hello.length());
+        ++sent;
+        std::optional<std::size_t> rec;
+        max_tries = 50;
+        while (!(rec = accepted->receive_timestamped(buff.data(), buff.size(), 0, ts)) && max_tries-- > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        ASSERT_EQ(rec, hello.length());
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    ASSERT_TRUE(ts.has_value());
+
+    // stream stamps are keyed by offset of the last byte of send call
+    auto tx = tx_timestamps(*client, 3 * sent);
+    ASSERT_EQ(tx.size(), 3 * sent);
+    tx.erase(std::remove_if(tx.begin(), tx.end(), [&](tx_timestamp_t const& stamp)
+    {
+        return stamp.id != sent * hello.length() - 1;
+    }), tx.end());
+    ASSERT_EQ(tx.size(), 3u);
+    EXPECT_EQ(tx[0].stage, tx_timestamp_t::stage_t::SCHEDULED);
+    EXPECT_EQ(tx[1].stage, tx_timestamp_t::stage_t::SENT);
+    EXPECT_EQ(tx[2].stage, tx_timestamp_t::stage_t::ACKED);
+    EXPECT_LE(tx[1].time, *ts);
+}
+
 TEST(socket_t, createAndCloseUdp)
 {
     test_create<udp>();
@@ -98,3 +259,18 @@ TEST(socket_t, connectAccept)
 {
     test_connect();
 }
+
+TEST(socket_t, connectUdp)
+{
+    test_connect_udp();
+}
+
+TEST(socket_t, timestampingUdp)
+{
+    test_timestamping_udp();
+}
+
+TEST(socket_t, timestampingTcp)
+{
+    test_timestamping_tcp();
+}
@@ -0,0 +1,145 @@
+#include <instrument/syscall_counter.h>
+#include <endpoint/server.h>
+#include <endpoint/client.h>
+#include <epoll/epoll.h>
+#include <framing/framer.h>
+#include <socket/af_inet.h>
+
+#include <gtest/gtest.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::endpoint;
+using protei::instrument::syscall_t;
+
+namespace
+{
+
+/**
+ * @brief Connected tcp server and client on loopback
+ */
+struct tcp_pair
+{
+    explicit tcp_pair(std::uint_fast16_t port)
+    {
+        auto listener = utils::mbind(
+                socket_t<tcp>::create(ipv4{})
+                , [port](socket_t<tcp>&& sock)
+                {
+                    sock.set_reuse_address(true);
+                    return sock.bind(in_address_port_t{in_address_t{"127.0.0.1"}, port});
+                }
+                , [](binded_socket_t<tcp>&& sock) { return sock.listen(4); });
+        if (!listener
+            || !server.start(
+                    ::dup(listener->native_handle())
+                    , 4
+                    , [this](accepted_sock<tcp>&& sock) { accepted.emplace(std::move(sock)); }
+                    , [this](int) { ++erased; })
+            || !client.start()
+            || !client.connect("127.0.0.1", port, [](){}, [](){}, [](){}))
+        {
+            return;
+        }
+        for (int i = 0; i < 10 && !accepted; ++i)
+        {
+            server.proceed(std::chrono::milliseconds{10});
+        }
+    }
+
+    server_t<tcp, epoll_t> server{epoll_t{5, 10u}, ipv4{}};
+    client_t<tcp, epoll_t> client{epoll_t{5, 10u}, ipv4{}};
+    std::optional<accepted_sock<tcp>> accepted;
+    int erased = 0;
+};
+
+}
+
+TEST(syscall_counter, countsThreadCalls)
+{
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds), 0);
+    instrument::syscall_scope scope;
+    char buff[4] = "abc";
+    EXPECT_EQ(::send(fds[0], buff, sizeof(buff), 0), 4);
+    EXPECT_EQ(::recv(fds[1], buff, sizeof(buff), 0), 4);
+    EXPECT_EQ(::recv(fds[1], buff, sizeof(buff), 0), -1);
+
+    auto stats = scope.stats();
+    EXPECT_EQ(stats[syscall_t::SEND], 1u);
+    EXPECT_EQ(stats[syscall_t::RECV], 2u);
+    EXPECT_EQ(stats.blocked(syscall_t::RECV), 1u);
+    EXPECT_EQ(stats.total(), 3u);
+    EXPECT_EQ(stats.total_blocked(), 1u);
+    EXPECT_STREQ(instrument::syscall_name(syscall_t::EPOLL_CTL), "epoll_ctl");
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+
+TEST(syscalls, tcpSteadyStateCycle)
+{
+    tcp_pair pair{7913};
+    ASSERT_TRUE(pair.accepted);
+
+    char request[] = "request";
+    char buff[64];
+    instrument::syscall_scope scope;
+    ASSERT_EQ(pair.client.send(request, sizeof(request)), sizeof(request));
+    ASSERT_TRUE(pair.server.proceed(std::chrono::milliseconds{100}));
+    auto rec = pair.accepted->recv(buff, sizeof(buff));
+    ASSERT_TRUE(rec);
+    ASSERT_EQ(pair.accepted->send(buff, rec->second), sizeof(request));
+    ASSERT_TRUE(pair.client.proceed(std::chrono::milliseconds{100}));
+    ASSERT_TRUE(pair.client.recv(buff, sizeof(buff)));
+
+    // one syscall per operation: no re-registration per event and no probes of drained socket
+    auto stats = scope.stats();
+    EXPECT_EQ(stats[syscall_t::EPOLL_CTL], 0u);
+    EXPECT_EQ(stats[syscall_t::EPOLL_WAIT], 2u);
+    EXPECT_EQ(stats.total_blocked(), 0u);
+    EXPECT_EQ(stats.total(), 6u);
+}
+
+
+TEST(syscalls, framerReadsWithoutProbe)
+{
+    tcp_pair pair{7914};
+    ASSERT_TRUE(pair.accepted);
+    framing::length_prefix_codec codec{framing::length_prefix_codec::prefix_t::U16, 1024};
+    framing::framer_t<framing::length_prefix_codec> writer{codec, 256};
+    framing::framer_t<framing::length_prefix_codec> reader{codec, 256};
+    ASSERT_TRUE(writer.write(pair.client, "first"));
+    ASSERT_TRUE(writer.write(pair.client, "second"));
+    ASSERT_TRUE(pair.server.proceed(std::chrono::milliseconds{100}));
+
+    instrument::syscall_scope scope;
+    std::vector<std::string> frames;
+    EXPECT_EQ(reader.read(*pair.accepted, [&frames](std::string_view frame) { frames.emplace_back(frame); }), 2u);
+    EXPECT_EQ(frames, (std::vector<std::string>{"first", "second"}));
+
+    // short read drained socket, it isn't probed until EAGAIN
+    auto stats = scope.stats();
+    EXPECT_EQ(stats.total(), 1u);
+    EXPECT_EQ(stats.total_blocked(), 0u);
+}
+
+
+TEST(syscalls, peerCloseUnregistersOnce)
+{
+    tcp_pair pair{7915};
+    ASSERT_TRUE(pair.accepted);
+    pair.client.stop();
+
+    instrument::syscall_scope scope;
+    for (int i = 0; i < 10 && pair.erased == 0; ++i)
+    {
+        pair.server.proceed(std::chrono::milliseconds{10});
+    }
+    EXPECT_EQ(pair.erased, 1);
+    EXPECT_EQ(scope.stats()[syscall_t::EPOLL_CTL], 1u);
+}
@@ -0,0 +1,149 @@
+#include <endpoint/server.h>
+#include <endpoint/client.h>
+#include <epoll/epoll.h>
+#include <socket/af_inet.h>
+#include <utils/to_string.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::endpoint;
+using namespace protei::utils;
+
+namespace
+{
+
+/**
+ * @brief Proceed endpoint until predicate holds, predicate may consume data, so it isn't rechecked after success
+ * @return true if predicate held
+ */
+template <typename Endpoint, typename Pred>
+bool proceed_until(Endpoint& endpoint, Pred&& pred)
+{
+    for (int i = 0; i < 50; ++i)
+    {
+        if (pred())
+        {
+            return true;
+        }
+        endpoint.proceed(std::chrono::milliseconds{10});
+    }
+    return pred();
+}
+
+}
+
+TEST(timestamping, endpointsTcp)
+{
+    server_t<tcp, epoll_t> server{epoll_t{5, 10u}, ipv4{}};
+    client_t<tcp, epoll_t> client{epoll_t{5, 10u}, ipv4{}};
+    std::optional<accepted_sock<tcp>> accepted;
+    std::vector<int> server_tx;
+    std::size_t client_tx = 0;
+    int erased = 0;
+    bool disconnected = false;
+    ASSERT_TRUE(server.set_timestamping(true, [&](int fd, tx_timestamp_t const&) { server_tx.push_back(fd); }));
+    ASSERT_TRUE(server.start(
+            "127.0.0.1"
+            , 8056
+            , 4
+            , [&](accepted_sock<tcp>&& sock) { accepted.emplace(std::move(sock)); }
+            , [&](int) { ++erased; }
+            , true));
+    ASSERT_TRUE(client.start());
+    ASSERT_TRUE(client.connect("127.0.0.1", 8056, [](){}, [](){}, [&]() { disconnected = true; }));
+    ASSERT_TRUE(proceed_until(server, [&]() { return accepted.has_value(); }));
+    ASSERT_TRUE(client.set_timestamping(false, [&](int, tx_timestamp_t const&) { ++client_tx; }));
+
+    // kernel switches on stamping of received packets asynchronously, first segments may miss it
+    auto before = std::chrono::system_clock::now();
+    std::string hello{"hello"};
+    std::string buff(16, '\0');
+    std::optional<timestamp_t> ts;
+    for (int sent = 0; !ts && sent < 50; ++sent)
+    {
+        ASSERT_EQ(client.send(hello.data(), hello.size()), hello.size());
+        decltype(accepted->recv_timestamped(buff.data(), buff.size(), ts)) rec;
+        ASSERT_TRUE(proceed_until(server, [&]()
+        {
+            return (rec = accepted->recv_timestamped(buff.data(), buff.size(), ts)).has_value();
+        }));
+        EXPECT_EQ(buff.substr(0, rec->second), hello);
+    }
+    ASSERT_TRUE(ts.has_value());
+    EXPECT_GE(*ts, before);
+
+    // TX stamps make poll report error readiness, endpoints read them instead of disconnecting
+    EXPECT_TRUE(proceed_until(client, [&]() { return client_tx > 0; }));
+    ASSERT_EQ(accepted->send(hello.data(), hello.size()), hello.size());
+    EXPECT_TRUE(proceed_until(server, [&]() { return !server_tx.empty(); }));
+    EXPECT_EQ(server_tx.front(), accepted->native_handle());
+    EXPECT_FALSE(disconnected);
+    EXPECT_EQ(erased, 0);
+    ASSERT_EQ(client.send(hello.data(), hello.size()), hello.size());
+    EXPECT_TRUE(proceed_until(server, [&]() { return accepted->recv(buff.data(), buff.size()).has_value(); }));
+
+    // real failure is still reported
+    accepted.reset();
+    EXPECT_TRUE(proceed_until(client, [&]() { return disconnected; }));
+}
+
+
+TEST(timestamping, serverUdp)
+{
+    server_t<udp, epoll_t> server{epoll_t{5, 10u}, ipv4{}};
+    client_t<udp, epoll_t> client{epoll_t{5, 10u}, ipv4{}};
+    std::string hello{"hello"};
+    std::string buff(16, '\0');
+    std::optional<timestamp_t> ts;
+    std::optional<std::pair<in_address_port_t, std::size_t>> rec;
+    std::size_t server_tx = 0;
+    bool closed = false;
+    ASSERT_TRUE(server.start(
+            "127.0.0.1"
+            , 8058
+            , [&](accepted_sock_ref<udp>&& sock)
+            {
+                std::optional<timestamp_t> stamp;
+                while (auto got = sock.recv_timestamped(buff.data(), buff.size(), stamp))
+                {
+                    rec = got;
+                    if (stamp)
+                    {
+                        ts = stamp;
+                        sock.send(hello.data(), hello.size());
+                    }
+                }
+            }
+            , [&]() { closed = true; }));
+    ASSERT_TRUE(server.set_timestamping(true, [&](int, tx_timestamp_t const&) { ++server_tx; }));
+    ASSERT_TRUE(client.start());
+    ASSERT_TRUE(client.connect("127.0.0.1", 8058, [](){}, [](){}, [](){}));
+
+    auto before = std::chrono::system_clock::now();
+    for (int sent = 0; !ts && sent < 50; ++sent)
+    {
+        ASSERT_EQ(client.send(hello.data(), hello.size()), hello.size());
+        rec.reset();
+        ASSERT_TRUE(proceed_until(server, [&]() { return rec.has_value(); }));
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    ASSERT_TRUE(ts.has_value());
+    EXPECT_GE(*ts, before);
+    EXPECT_EQ(buff.substr(0, rec->second), hello);
+    EXPECT_EQ(to_string(rec->first.addr), "127.0.0.1");
+
+    // reply stamps don't stop server
+    EXPECT_TRUE(proceed_until(server, [&]() { return server_tx > 0; }));
+    EXPECT_FALSE(closed);
+    std::optional<timestamp_t> client_ts;
+    EXPECT_TRUE(proceed_until(client, [&]()
+    {
+        return client.recv_timestamped(buff.data(), buff.size(), client_ts).has_value();
+    }));
+    EXPECT_FALSE(client_ts);
+}
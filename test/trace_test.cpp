@@ -0,0 +1,141 @@
+#include <trace/trace.h>
+#include <endpoint/server.h>
+#include <endpoint/client.h>
+#include <epoll/epoll.h>
+#include <socket/af_inet.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::endpoint;
+
+namespace
+{
+
+/**
+ * @brief Dump file removed on destruction
+ */
+struct dump_file
+{
+    ~dump_file()
+    {
+        ::unlink(path.c_str());
+    }
+
+    std::optional<trace::trace_file> dump() const
+    {
+        return trace::dump(path.c_str()) ? trace::load(path) : std::nullopt;
+    }
+
+    std::string path = "/tmp/protei_trace_test." + std::to_string(::getpid());
+};
+
+
+std::vector<trace::record> of_fd(trace::trace_file const& file, int fd)
+{
+    std::vector<trace::record> ret;
+    std::copy_if(file.records.begin(), file.records.end(), std::back_inserter(ret), [fd](trace::record const& rec)
+    {
+        return rec.fd == fd;
+    });
+    return ret;
+}
+
+}
+
+TEST(trace, ringDumpAndLoad)
+{
+    constexpr int fd = 1'000'001;
+    trace::write(trace::op_t::SEND, fd, 10, 10);
+    std::thread{[]() { trace::write(trace::op_t::RECV, fd, 20, -EAGAIN); }}.join();
+
+    dump_file file;
+    auto loaded = file.dump();
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(loaded->header.record_size, sizeof(trace::record));
+    EXPECT_GT(loaded->header.realtime_offset_ns, 0);
+    auto records = of_fd(*loaded, fd);
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].op, trace::op_t::SEND);
+    EXPECT_EQ(records[0].size, 10u);
+    EXPECT_EQ(records[0].result, 10);
+    EXPECT_EQ(records[1].op, trace::op_t::RECV);
+    EXPECT_EQ(records[1].result, -EAGAIN);
+    EXPECT_LE(records[0].timestamp_ns, records[1].timestamp_ns);
+    EXPECT_NE(records[0].tid, records[1].tid);
+    EXPECT_FALSE(trace::load("/proc/self/status"));
+}
+
+
+TEST(trace, ringOverwritesOldest)
+{
+    constexpr int fd = 1'000'002;
+    for (std::size_t i = 0; i < trace::RING_RECORDS + 10; ++i)
+    {
+        trace::write(trace::op_t::SEND, fd, i, 0);
+    }
+
+    dump_file file;
+    auto loaded = file.dump();
+    ASSERT_TRUE(loaded);
+    auto records = of_fd(*loaded, fd);
+    // the oldest slot may be concurrently rewritten, so dump skips it
+    ASSERT_EQ(records.size(), trace::RING_RECORDS - 1);
+    EXPECT_EQ(records.front().size, 11u);
+    EXPECT_EQ(records.back().size, trace::RING_RECORDS + 9);
+}
+
+
+TEST(trace, socketOperations)
+{
+    if (!trace::enabled)
+    {
+        GTEST_SKIP();
+    }
+    std::optional<accepted_sock<tcp>> accepted;
+    server_t<tcp, epoll_t> server{epoll_t{5, 10u}, ipv4{}};
+    client_t<tcp, epoll_t> client{epoll_t{5, 10u}, ipv4{}};
+    ASSERT_TRUE(server.start("127.0.0.1", 7921, 4, [&](accepted_sock<tcp>&& sock) { accepted.emplace(std::move(sock)); }
+                             , [](int) {}));
+    ASSERT_TRUE(client.start());
+    ASSERT_TRUE(client.connect("127.0.0.1", 7921, [](){}, [](){}, [](){}));
+    for (int i = 0; i < 10 && !accepted; ++i)
+    {
+        server.proceed(std::chrono::milliseconds{10});
+    }
+    ASSERT_TRUE(accepted);
+
+    char request[] = "request";
+    char buff[64];
+    ASSERT_EQ(client.send(request, sizeof(request)), sizeof(request));
+    server.proceed(std::chrono::milliseconds{100});
+    ASSERT_TRUE(accepted->recv(buff, sizeof(buff)));
+    EXPECT_FALSE(accepted->recv(buff, sizeof(buff)));
+    EXPECT_TRUE(accepted->finished_recv());
+
+    dump_file file;
+    auto loaded = file.dump();
+    ASSERT_TRUE(loaded);
+    auto records = of_fd(*loaded, accepted->native_handle());
+    ASSERT_GE(records.size(), 3u);
+    records.erase(records.begin(), records.end() - 3);
+    EXPECT_EQ(records[0].op, trace::op_t::RECV);
+    EXPECT_EQ(records[0].size, sizeof(buff));
+    EXPECT_EQ(records[0].result, static_cast<std::int64_t>(sizeof(request)));
+    EXPECT_EQ(records[1].op, trace::op_t::RECV);
+    EXPECT_EQ(records[1].result, -EAGAIN);
+    EXPECT_EQ(records[2].op, trace::op_t::FINISHED_RECV);
+    EXPECT_EQ(records[2].result, 1);
+    EXPECT_TRUE(std::any_of(loaded->records.begin(), loaded->records.end(), [&](trace::record const& rec)
+    {
+        return rec.op == trace::op_t::SEND && rec.fd >= 0 && rec.size == sizeof(request)
+               && rec.result == static_cast<std::int64_t>(sizeof(request));
+    }));
+}
@@ -0,0 +1,251 @@
+#include <endpoint/server.h>
+#include <endpoint/client.h>
+#include <epoll/epoll.h>
+#include <socket/af_unix.h>
+#include <utils/to_string.h>
+
+#include <gtest/gtest.h>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::utils;
+using namespace protei::endpoint;
+
+namespace
+{
+
+std::size_t open_fds()
+{
+    std::size_t ret = 0;
+    if (auto* dir = ::opendir("/proc/self/fd"))
+    {
+        while (::readdir(dir))
+        {
+            ++ret;
+        }
+        ::closedir(dir);
+    }
+    return ret;
+}
+
+}
+
+TEST(unix_address_t, create)
+{
+    auto abstract = unix_address_t::create("@protei.test");
+    ASSERT_TRUE(abstract);
+    EXPECT_TRUE(abstract->is_abstract());
+    EXPECT_EQ(to_string(*abstract), "@protei.test");
+
+    auto path = unix_address_t::create("/tmp/protei.sock");
+    ASSERT_TRUE(path);
+    EXPECT_FALSE(path->is_abstract());
+    EXPECT_EQ(path->name(), "/tmp/protei.sock");
+    EXPECT_NE(*path, *abstract);
+    EXPECT_EQ(unix_address_t::hash{}(*path), unix_address_t::hash{}(unix_address_t{"/tmp/protei.sock"}));
+
+    EXPECT_TRUE(unix_address_t{}.empty());
+    EXPECT_FALSE(unix_address_t::create(""));
+    EXPECT_FALSE(unix_address_t::create(std::string(unix_address_t::MAX_PATH_LEN, 'a')));
+    EXPECT_TRUE(unix_address_t::create("@" + std::string(unix_address_t::MAX_PATH_LEN - 1, 'a')));
+}
+
+
+TEST(socket_t, connectAcceptUnixStream)
+{
+    unix_address_t serv_addr{"@protei.test.stream"};
+    auto serv = mbind(
+            socket_t<unix_stream>::create(local{})
+            , [&](socket_t<unix_stream>&& sock) { return sock.bind(serv_addr); }
+            , [](binded_socket_t<unix_stream>&& sock) { return sock.listen(5); });
+    ASSERT_TRUE(serv);
+
+    auto client = mbind(
+            socket_t<unix_stream>::create(local{})
+            , [&](socket_t<unix_stream>&& sock) { return sock.connect(serv_addr); });
+    ASSERT_TRUE(client);
+    auto accepted = serv->accept();
+    ASSERT_TRUE(accepted);
+    EXPECT_EQ(accepted->local(), serv_addr);
+    EXPECT_TRUE(accepted->remote().value().empty());
+
+    std::string hello{"hello"};
+    EXPECT_EQ(client->send(hello.data(), hello.size(), 0), hello.size());
+    std::string recv(16, '\0');
+    auto rec = accepted->receive(recv.data(), recv.size(), 0);
+    ASSERT_TRUE(rec);
+    EXPECT_EQ(recv.substr(0, *rec), hello);
+}
+
+
+TEST(endpoint, unixStreamEcho)
+{
+    server_t<unix_stream, epoll_t> server{epoll_t{5, 10u}, local{}};
+    std::vector<accepted_sock<unix_stream>> accepted;
+    ASSERT_TRUE(server.start(
+            "@protei.test.echo"
+            , 0
+            , 5
+            , [&accepted](accepted_sock<unix_stream>&& sock) { accepted.push_back(std::move(sock)); }
+            , [](int){}));
+
+    client_t<unix_stream, epoll_t> client{epoll_t{5, 10u}, local{}};
+    ASSERT_TRUE(client.start());
+    ASSERT_TRUE(client.connect("@protei.test.echo", 0, [](){}, [](){}, [](){}));
+    server.proceed(std::chrono::milliseconds{50});
+    ASSERT_EQ(accepted.size(), 1u);
+
+    std::string ping{"ping"};
+    ASSERT_TRUE(client.send(ping.data(), ping.size()));
+    std::string buff(16, '\0');
+    auto rec = accepted.front().recv(buff.data(), buff.size());
+    ASSERT_TRUE(rec);
+    ASSERT_TRUE(accepted.front().send(buff.data(), rec->second));
+
+    rec = client.recv(buff.data(), buff.size());
+    ASSERT_TRUE(rec);
+    EXPECT_EQ(buff.substr(0, rec->second), ping);
+    EXPECT_EQ(to_string(rec->first), "@protei.test.echo");
+    server.stop();
+}
+
+
+TEST(endpoint, unixDgramReply)
+{
+    server_t<unix_dgram, epoll_t> server{epoll_t{5, 10u}, local{}};
+    std::string request;
+    bool abstract_peer = false;
+    ASSERT_TRUE(server.start(
+            "@protei.test.dgram"
+            , 0
+            , [&request, &abstract_peer](accepted_sock_ref<unix_dgram>&& sock)
+            {
+                std::string buff(16, '\0');
+                while (auto rec = sock.recv(buff.data(), buff.size()))
+                {
+                    request = buff.substr(0, rec->second);
+                    abstract_peer = rec->first.is_abstract();
+                    sock.send(buff.data(), rec->second);
+                }
+            }
+            , [](){}));
+
+    // unbound client is bound to autogenerated abstract name on connect, so it gets replies
+    client_t<unix_dgram, epoll_t> client{epoll_t{5, 10u}, local{}};
+    ASSERT_TRUE(client.start());
+    ASSERT_TRUE(client.connect("@protei.test.dgram", 0, [](){}, [](){}, [](){}));
+    std::string ping{"ping"};
+    ASSERT_TRUE(client.send(ping.data(), ping.size()));
+    server.proceed(std::chrono::milliseconds{50});
+    EXPECT_EQ(request, ping);
+    EXPECT_TRUE(abstract_peer);
+
+    std::string buff(16, '\0');
+    auto rec = client.recv(buff.data(), buff.size());
+    ASSERT_TRUE(rec);
+    EXPECT_EQ(buff.substr(0, rec->second), ping);
+    server.stop();
+}
+
+
+TEST(socket_t, adoptSocketpair)
+{
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    EXPECT_FALSE(active_socket_t<tcp>::adopt(fds[0]));
+    EXPECT_FALSE(active_socket_t<unix_dgram>::adopt(fds[0]));
+    EXPECT_FALSE(listening_socket_t<unix_stream>::adopt(fds[0], 5));
+    // rejected descriptor is left to caller as is
+    EXPECT_FALSE(::fcntl(fds[0], F_GETFL) & O_NONBLOCK);
+
+    auto first = active_socket_t<unix_stream>::adopt(fds[0]);
+    auto second = active_socket_t<unix_stream>::adopt(fds[1]);
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    EXPECT_TRUE(first->remote().value().empty());
+
+    std::string hello{"hello"};
+    std::string recv(16, '\0');
+    EXPECT_FALSE(second->receive(recv.data(), recv.size(), 0));
+    EXPECT_TRUE(second->would_block());
+    EXPECT_EQ(first->send(hello.data(), hello.size(), 0), hello.size());
+    auto rec = second->receive(recv.data(), recv.size(), 0);
+    ASSERT_TRUE(rec);
+    EXPECT_EQ(recv.substr(0, *rec), hello);
+}
+
+
+TEST(socket_t, receiveFdsOverCapacity)
+{
+    int pair[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, pair), 0);
+    auto sender = active_socket_t<unix_stream>::adopt(pair[0]);
+    auto receiver = active_socket_t<unix_stream>::adopt(pair[1]);
+    ASSERT_TRUE(sender && receiver);
+    int passed[4];
+    for (auto& fd: passed)
+    {
+        fd = ::dup(STDIN_FILENO);
+        ASSERT_NE(fd, -1);
+    }
+    auto fds_before = open_fds();
+    char byte = 'x';
+    int received[2] = {-1, -1};
+
+    // control buffer for one descriptor is padded to fit two, the extra one is closed
+    ASSERT_TRUE(sender->send_fds(&byte, 1, passed, 2));
+    std::size_t count = 1;
+    EXPECT_EQ(receiver->receive_fds(&byte, 1, received, count), 1u);
+    ASSERT_EQ(count, 1u);
+    EXPECT_EQ(received[1], -1);
+    EXPECT_EQ(open_fds(), fds_before + 1);
+    ::close(received[0]);
+
+    // descriptors truncated by kernel fail the receive, installed ones are closed
+    ASSERT_TRUE(sender->send_fds(&byte, 1, passed, 4));
+    count = 1;
+    EXPECT_FALSE(receiver->receive_fds(&byte, 1, received, count));
+    EXPECT_EQ(errno, EMSGSIZE);
+    EXPECT_EQ(count, 0u);
+    EXPECT_EQ(open_fds(), fds_before);
+
+    for (int fd: passed)
+    {
+        ::close(fd);
+    }
+}
+
+
+TEST(endpoint, startAdoptedListener)
+{
+    int fd = -1;
+    {
+        auto listener = mbind(
+                socket_t<unix_stream>::create(local{})
+                , [](socket_t<unix_stream>&& sock) { return sock.bind(unix_address_t{"@protei.test.adopted"}); }
+                , [](binded_socket_t<unix_stream>&& sock) { return sock.listen(5); });
+        ASSERT_TRUE(listener);
+        fd = ::dup(listener->native_handle());
+    }
+    EXPECT_FALSE(active_socket_t<unix_stream>::adopt(fd));
+
+    server_t<unix_stream, epoll_t> server{epoll_t{5, 10u}, local{}};
+    std::vector<accepted_sock<unix_stream>> accepted;
+    ASSERT_TRUE(server.start(
+            fd
+            , 5
+            , [&accepted](accepted_sock<unix_stream>&& sock) { accepted.push_back(std::move(sock)); }
+            , [](int){}));
+
+    client_t<unix_stream, epoll_t> client{epoll_t{5, 10u}, local{}};
+    ASSERT_TRUE(client.start());
+    ASSERT_TRUE(client.connect("@protei.test.adopted", 0, [](){}, [](){}, [](){}));
+    server.proceed(std::chrono::milliseconds{50});
+    EXPECT_EQ(accepted.size(), 1u);
+}
@@ -0,0 +1,354 @@
+#include <endpoint/uring_server.h>
+#include <endpoint/client.h>
+#include <epoll/epoll.h>
+#include <socket/af_inet.h>
+#include <socket/af_unix.h>
+#include <uring/fixed_io.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+
+#include <arpa/inet.h>
+#include <dirent.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace protei;
+using namespace protei::sock;
+using namespace protei::epoll;
+using namespace protei::endpoint;
+
+namespace
+{
+
+std::size_t open_fds()
+{
+    std::size_t ret = 0;
+    if (auto* dir = ::opendir("/proc/self/fd"))
+    {
+        while (::readdir(dir))
+        {
+            ++ret;
+        }
+        ::closedir(dir);
+    }
+    return ret;
+}
+
+
+/**
+ * @brief Proceed endpoint until predicate holds, predicate may consume data, so it isn't rechecked after success
+ * @return true if predicate held
+ */
+template <typename Endpoint, typename Pred>
+bool proceed_until(Endpoint& endpoint, Pred&& pred)
+{
+    for (int i = 0; i < 50; ++i)
+    {
+        if (pred())
+        {
+            return true;
+        }
+        endpoint.proceed(std::chrono::milliseconds{10});
+    }
+    return pred();
+}
+
+
+/**
+ * @brief Reap completions of fixed io until predicate holds
+ * @return true if predicate held
+ */
+template <typename Pred>
+bool reap_until(uring::fixed_io& io, Pred&& pred)
+{
+    for (int i = 0; i < 50 && !pred(); ++i)
+    {
+        io.reap(std::chrono::milliseconds{10});
+    }
+    return pred();
+}
+
+}
+
+TEST(uring_t, create)
+{
+    auto ring = uring::uring_t::create(8);
+    ASSERT_TRUE(ring);
+    EXPECT_NE(ring->native_handle(), -1);
+    std::vector<uring::completion> completions;
+    EXPECT_EQ(ring->proceed(std::chrono::milliseconds{1}, completions), 0u);
+
+    // buffer count must be power of 2
+    EXPECT_FALSE(uring::provided_buffers::create(*ring, 0, 3, 64));
+}
+
+
+TEST(uring_server, echo)
+{
+    auto ring = uring::uring_t::create(64);
+    ASSERT_TRUE(ring);
+    server_t<tcp, uring::uring_t> server{std::move(*ring), ipv4{}, uring_options{16, 64}};
+    std::map<int, accepted_sock<tcp>> accepted;
+    std::vector<int> erased;
+    auto listener = utils::mbind(
+            socket_t<tcp>::create(ipv4{})
+            , [](socket_t<tcp>&& sock)
+            {
+                sock.set_reuse_address(true);
+                return sock.bind(in_address_port_t{in_address_t{"127.0.0.1"}, 7898});
+            }
+            , [](binded_socket_t<tcp>&& sock) { return sock.listen(16); });
+    ASSERT_TRUE(listener);
+    bool started = server.start(
+            ::dup(listener->native_handle())
+            , 16
+            , [&accepted](accepted_sock<tcp>&& sock) { accepted.emplace(sock.native_handle(), std::move(sock)); }
+            , [&accepted](int fd, std::string_view data)
+            {
+                std::string echo{data};
+                accepted.at(fd).send(echo.data(), echo.size());
+            }
+            , [&accepted, &erased](int fd)
+            {
+                accepted.erase(fd);
+                erased.push_back(fd);
+            });
+    if (!started)
+    {
+        GTEST_SKIP() << "io_uring multishot operations or buffer rings aren't supported";
+    }
+
+    std::vector<std::unique_ptr<client_t<tcp, epoll_t>>> clients;
+    for (int i = 0; i < 3; ++i)
+    {
+        auto& client = clients.emplace_back(std::make_unique<client_t<tcp, epoll_t>>(epoll_t{5, 10u}, ipv4{}));
+        ASSERT_TRUE(client->start());
+        ASSERT_TRUE(client->connect("127.0.0.1", 7898, [](){}, [](){}, [](){}));
+    }
+    for (int i = 0; i < 10 && accepted.size() < clients.size(); ++i)
+    {
+        server.proceed(std::chrono::milliseconds{10});
+    }
+    ASSERT_EQ(accepted.size(), clients.size());
+    EXPECT_EQ(server.load(), clients.size());
+
+    // payload larger than provided buffer is received in several completions
+    std::string payload(200, 'x');
+    std::generate(payload.begin(), payload.end(), [c = 'a']() mutable { return c == 'z' ? c = 'a' : ++c; });
+    for (auto& client: clients)
+    {
+        ASSERT_TRUE(client->send(payload.data(), payload.size()));
+    }
+    for (auto& client: clients)
+    {
+        std::string echo;
+        std::string buff(256, '\0');
+        for (int i = 0; i < 20 && echo.size() < payload.size(); ++i)
+        {
+            server.proceed(std::chrono::milliseconds{10});
+            client->proceed(std::chrono::milliseconds{0});
+            while (auto rec = client->recv(buff.data(), buff.size()))
+            {
+                echo.append(buff.data(), rec->second);
+            }
+        }
+        EXPECT_EQ(echo, payload);
+    }
+
+    // peer close is reported as erase
+    clients.back().reset();
+    for (int i = 0; i < 10 && erased.empty(); ++i)
+    {
+        server.proceed(std::chrono::milliseconds{10});
+    }
+    EXPECT_EQ(erased.size(), 1u);
+    EXPECT_EQ(server.load(), clients.size() - 1);
+
+    // server side close cancels recv, so peer gets end of stream
+    auto fd = accepted.begin()->first;
+    EXPECT_TRUE(server.close(fd));
+    EXPECT_FALSE(server.close(fd));
+    accepted.erase(fd);
+    server.proceed(std::chrono::milliseconds{10});
+    EXPECT_EQ(erased.size(), 1u);
+    EXPECT_EQ(server.load(), 1u);
+}
+
+
+TEST(uring_server, resetBeforeRecv)
+{
+    auto ring = uring::uring_t::create(64);
+    ASSERT_TRUE(ring);
+    server_t<tcp, uring::uring_t> server{std::move(*ring), ipv4{}, uring_options{16, 64}};
+    auto listener = utils::mbind(
+            socket_t<tcp>::create(ipv4{})
+            , [](socket_t<tcp>&& sock)
+            {
+                sock.set_reuse_address(true);
+                return sock.bind(in_address_port_t{in_address_t{"127.0.0.1"}, 7899});
+            }
+            , [](binded_socket_t<tcp>&& sock) { return sock.listen(16); });
+    ASSERT_TRUE(listener);
+
+    // connection is reset while waiting in backlog, so multishot accept takes it as soon as it's armed
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(7899);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int peer = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_EQ(::connect(peer, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    linger reset{1, 0};
+    ASSERT_EQ(::setsockopt(peer, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset)), 0);
+    ::close(peer);
+    auto fds_before = open_fds();
+
+    std::vector<accepted_sock<tcp>> accepted;
+    bool started = server.start(
+            ::dup(listener->native_handle())
+            , 16
+            , [&accepted](accepted_sock<tcp>&& sock) { accepted.push_back(std::move(sock)); }
+            , [](int, std::string_view) {}
+            , [](int) {});
+    if (!started)
+    {
+        GTEST_SKIP() << "io_uring multishot operations or buffer rings aren't supported";
+    }
+    for (int i = 0; i < 5; ++i)
+    {
+        server.proceed(std::chrono::milliseconds{10});
+    }
+    EXPECT_TRUE(accepted.empty());
+    EXPECT_EQ(server.load(), 0u);
+    // only listener's duplicate is left open
+    EXPECT_EQ(open_fds(), fds_before + 1);
+
+    // multishot accept goes on
+    client_t<tcp, epoll_t> client{epoll_t{5, 10u}, ipv4{}};
+    ASSERT_TRUE(client.start());
+    ASSERT_TRUE(client.connect("127.0.0.1", 7899, [](){}, [](){}, [](){}));
+    for (int i = 0; i < 10 && accepted.empty(); ++i)
+    {
+        server.proceed(std::chrono::milliseconds{10});
+    }
+    EXPECT_EQ(accepted.size(), 1u);
+}
+
+
+TEST(fixed_io, slot)
+{
+    // without registered buffer and with it: unix socket has no zero copy send, so it falls back to WRITE_FIXED
+    for (bool fixed_buffers: {false, true})
+    {
+        auto io = uring::fixed_io::create(2, 64, fixed_buffers);
+        if (!io)
+        {
+            GTEST_SKIP() << "io_uring registered files or buffers aren't supported";
+        }
+
+        int fds[2];
+        ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds), 0);
+        auto server_side = active_socket_t<unix_stream>::adopt(fds[0]);
+        auto peer = active_socket_t<unix_stream>::adopt(fds[1]);
+        ASSERT_TRUE(server_side && peer);
+        {
+            auto slot = io->attach(server_side->native_handle());
+            ASSERT_TRUE(slot);
+            EXPECT_EQ(io->available(), 1u);
+
+            // send buffer takes what fits, the rest waits for send completion
+            std::string payload(150, 'f');
+            EXPECT_EQ(slot->send(payload.data(), payload.size()), 64u);
+            EXPECT_FALSE(slot->send(payload.data(), payload.size()));
+            EXPECT_EQ(errno, EAGAIN);
+            ASSERT_TRUE(reap_until(*io, [&]() { return slot->unsent() == 0; }));
+            std::string buff(256, '\0');
+            auto rec = peer->receive(buff.data(), buff.size(), 0);
+            ASSERT_TRUE(rec);
+            EXPECT_EQ(buff.substr(0, *rec), payload.substr(0, 64));
+
+            // receive stays queued, data is taken from completed one
+            EXPECT_FALSE(slot->readable());
+            EXPECT_FALSE(slot->recv(buff.data(), buff.size()));
+            EXPECT_EQ(errno, EAGAIN);
+            ASSERT_TRUE(peer->send(payload.data(), 10, 0));
+            ASSERT_TRUE(reap_until(*io, [&]() { return slot->readable(); }));
+            EXPECT_EQ(slot->recv(buff.data(), 4), 4u);
+            EXPECT_EQ(slot->recv(buff.data() + 4, buff.size()), 6u);
+            EXPECT_EQ(buff.substr(0, 10), payload.substr(0, 10));
+            EXPECT_FALSE(slot->recv(buff.data(), buff.size()));
+        }
+
+        // receive is cancelled, so slot is freed and peer sees end of stream on socket close
+        EXPECT_TRUE(reap_until(*io, [&]() { return io->available() == 2; }));
+        server_side.reset();
+        char byte;
+        EXPECT_EQ(peer->receive(&byte, 1, 0), 0u);
+    }
+}
+
+
+TEST(fixed_io, endpoints)
+{
+    server_t<tcp, epoll_t> server{epoll_t{5, 10u}, ipv4{}};
+    client_t<tcp, epoll_t> client{epoll_t{5, 10u}, ipv4{}};
+    if (!server.set_fixed_io(2, 256, true))
+    {
+        GTEST_SKIP() << "io_uring registered files or buffers aren't supported";
+    }
+    EXPECT_FALSE(server.set_fixed_io(2, 256));
+    std::optional<accepted_sock<tcp>> accepted;
+    int read_ready = 0;
+    bool disconnected = false;
+    ASSERT_TRUE(server.start(
+            "127.0.0.1"
+            , 7901
+            , 4
+            , [&](accepted_sock<tcp>&& sock) { accepted.emplace(std::move(sock)); }
+            , [](int) {}
+            , true));
+    ASSERT_TRUE(client.start());
+    EXPECT_FALSE(client.set_fixed_io(256, true));
+    ASSERT_TRUE(client.connect("127.0.0.1", 7901, [](){}, [&]() { ++read_ready; }, [&]() { disconnected = true; }));
+    ASSERT_TRUE(client.set_fixed_io(256, true));
+    ASSERT_TRUE(proceed_until(server, [&]() { return accepted.has_value(); }));
+    // operations of connection are completed by server's ring, so it can't be migrated
+    EXPECT_FALSE(server.detach(accepted->native_handle()));
+
+    // client's send is submitted by its proceed, receive completion is reaped by server's reactor
+    std::string hello{"hello"};
+    std::string buff(512, '\0');
+    ASSERT_EQ(client.send(hello.data(), hello.size()), hello.size());
+    client.proceed(std::chrono::milliseconds{0});
+    decltype(accepted->recv(buff.data(), buff.size())) rec;
+    ASSERT_TRUE(proceed_until(server, [&]() { return (rec = accepted->recv(buff.data(), buff.size())).has_value(); }));
+    EXPECT_EQ(buff.substr(0, rec->second), hello);
+    rec = accepted->recv(buff.data(), buff.size());
+    bool finished = accepted->finished_recv();
+    EXPECT_FALSE(rec);
+    EXPECT_TRUE(finished);
+
+    // zero copy reply, on_read_ready is called on client's receive completion
+    std::string reply(200, 'r');
+    ASSERT_EQ(accepted->send(reply.data(), reply.size()), reply.size());
+    server.proceed(std::chrono::milliseconds{0});
+    std::string received;
+    ASSERT_TRUE(proceed_until(client, [&]()
+    {
+        while (auto got = client.recv(buff.data(), buff.size()))
+        {
+            received.append(buff.data(), got->second);
+        }
+        return received.size() == reply.size();
+    }));
+    EXPECT_EQ(received, reply);
+    EXPECT_GT(read_ready, 0);
+
+    // slot is released with connection, so client sees end of stream
+    accepted.reset();
+    EXPECT_TRUE(proceed_until(client, [&]() { return disconnected; }));
+    client.stop();
+}